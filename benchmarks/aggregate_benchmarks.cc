@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "../src/associative/map/map.h"
+
+namespace s21 {
+namespace {
+/* Sum of the values in a window of range(0) consecutive timestamps out of
+ * 2^20: a for_each_range scan on a plain map against aggregate on a map
+ * keeping SumAggregate */
+constexpr int kMapSize = 1 << 20;
+
+template <typename Map>
+const Map &Series() {
+  static const Map series = [] {
+    Map result{};
+    for (int key{0}; key < kMapSize; ++key) {
+      result.insert(key, key % 97);
+    }
+    return result;
+  }();
+  return series;
+}
+
+template <typename Map, typename Query>
+void RunWindows(benchmark::State &state, Query query) {
+  const Map &series = Series<Map>();
+  int window = static_cast<int>(state.range(0));
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> distribution{0, kMapSize - window};
+  for (auto _ : state) {
+    int low = distribution(generator);
+    benchmark::DoNotOptimize(query(series, low, low + window));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+using PlainMap = map<int, long>;
+using SumMap =
+    map<int, long, std::less<int>, HeapNodeAllocator, SumAggregate<long>>;
+
+void BM_WindowSumScan(benchmark::State &state) {
+  RunWindows<PlainMap>(state, [](const PlainMap &series, int low, int high) {
+    long sum{0};
+    series.for_each_range(low, high,
+                          [&sum](const auto &item) { sum += item.second; });
+    return sum;
+  });
+}
+
+void BM_WindowSumAggregate(benchmark::State &state) {
+  RunWindows<SumMap>(state, [](const SumMap &series, int low, int high) {
+    return series.aggregate(low, high);
+  });
+}
+}  // namespace
+
+BENCHMARK(BM_WindowSumScan)->RangeMultiplier(16)->Range(1 << 4, 1 << 16);
+BENCHMARK(BM_WindowSumAggregate)->RangeMultiplier(16)->Range(1 << 4, 1 << 16);
+}  // namespace s21
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <random>
+
+#include "../src/associative/map/map.h"
+#include "../src/associative/set/set.h"
+#include "../src/sequence/vector/vector.h"
+
+namespace s21 {
+namespace {
+/* Insert/erase churn: per-node new/delete against the slab allocator and
+ * the arena with 32-bit links */
+vector<int> MakeRandomKeys(std::int64_t size) {
+  vector<int> keys(static_cast<std::size_t>(size));
+  std::mt19937 generator{7};
+  for (std::size_t i{0}; i < keys.size(); ++i) {
+    keys[i] = static_cast<int>(generator());
+  }
+  return keys;
+}
+
+template <typename NodeAllocator>
+void BM_SetChurn(benchmark::State &state) {
+  auto keys = MakeRandomKeys(state.range(0));
+  s21::set<int, std::less<int>, NodeAllocator> set{};
+  for (int key : keys) {
+    set.insert(key);
+  }
+
+  std::size_t index{0};
+  for (auto _ : state) {
+    set.erase(keys[index]);
+    set.insert(keys[index] ^ 1);
+    keys[index] ^= 1;
+    if (++index == keys.size()) index = 0;
+  }
+}
+
+template <typename NodeAllocator>
+void BM_MapFillAndClear(benchmark::State &state) {
+  auto keys = MakeRandomKeys(state.range(0));
+  for (auto _ : state) {
+    s21::map<int, int, std::less<int>, NodeAllocator> map{};
+    map.reserve_nodes(keys.size());
+    for (int key : keys) {
+      map.insert(key, key);
+    }
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_SetChurn, HeapNodeAllocator)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_SetChurn, SlabNodeAllocator)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_SetChurn, ArenaNodeAllocator)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_MapFillAndClear, HeapNodeAllocator)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_MapFillAndClear, SlabNodeAllocator)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(BM_MapFillAndClear, ArenaNodeAllocator)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 18);
+}  // namespace s21
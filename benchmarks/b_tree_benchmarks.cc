@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <utility>
+
+#include "../src/associative/map/map.h"
+#include "../src/sequence/vector/vector.h"
+
+namespace s21 {
+namespace {
+/* RedBlackTree (HeapNodeAllocator) against BTree nodes of four and eight
+ * cache lines. At 1e8 elements the red-black map needs about 6 GB, run
+ * the large sizes only where that fits */
+template <typename Storage>
+using BenchMap = s21::map<int, int, std::less<int>, Storage>;
+
+template <typename Storage>
+void FillSorted(BenchMap<Storage> &map, std::int64_t size) {
+  vector<std::pair<int, int>> pairs(static_cast<std::size_t>(size));
+  for (std::size_t i{0}; i < pairs.size(); ++i) {
+    pairs[i] = {static_cast<int>(i), static_cast<int>(i)};
+  }
+  map.assign_sorted(pairs.begin(), pairs.end());
+}
+
+template <typename Storage>
+void BM_TreeFind(benchmark::State &state) {
+  BenchMap<Storage> map{};
+  FillSorted(map, state.range(0));
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> distribution{
+      0, static_cast<int>(state.range(0)) - 1};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(distribution(generator)));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+/* Random inserts into a map of the given size, each one erased again so
+ * the size stays put */
+template <typename Storage>
+void BM_TreeInsertErase(benchmark::State &state) {
+  BenchMap<Storage> map{};
+  FillSorted(map, state.range(0));
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> distribution{
+      0, static_cast<int>(state.range(0)) - 1};
+  for (auto _ : state) {
+    int key{-distribution(generator) - 1};
+    map.insert(key, key);
+    map.erase(key);
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+template <typename Storage>
+void BM_TreeScan(benchmark::State &state) {
+  BenchMap<Storage> map{};
+  FillSorted(map, state.range(0));
+  for (auto _ : state) {
+    std::int64_t sum{0};
+    map.for_each_range(0, static_cast<int>(state.range(0)),
+                       [&sum](const auto &item) { sum += item.second; });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_TreeFind, HeapNodeAllocator)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_TreeFind, BTreeNodes<256>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_TreeFind, BTreeNodes<512>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_TreeInsertErase, HeapNodeAllocator)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_TreeInsertErase, BTreeNodes<256>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_TreeInsertErase, BTreeNodes<512>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_TreeScan, HeapNodeAllocator)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_TreeScan, BTreeNodes<256>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+BENCHMARK_TEMPLATE(BM_TreeScan, BTreeNodes<512>)
+    ->RangeMultiplier(10)
+    ->Range(1000, 100000000);
+}  // namespace s21
@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include "../src/associative/map/map.h"
+#include "../src/associative/set/set.h"
+#include "../src/sequence/vector/vector.h"
+
+namespace s21 {
+namespace {
+/* Loading an already sorted index: repeated insert against O(n) build */
+vector<int> MakeSortedKeys(std::int64_t size) {
+  vector<int> keys(static_cast<std::size_t>(size));
+  for (std::size_t i{0}; i < keys.size(); ++i) {
+    keys[i] = static_cast<int>(i);
+  }
+  return keys;
+}
+
+void BM_SetInsertSorted(benchmark::State &state) {
+  auto keys = MakeSortedKeys(state.range(0));
+  for (auto _ : state) {
+    s21::set<int> set{};
+    for (int key : keys) {
+      set.insert(key);
+    }
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SetAssignSorted(benchmark::State &state) {
+  auto keys = MakeSortedKeys(state.range(0));
+  for (auto _ : state) {
+    s21::set<int> set{};
+    set.assign_sorted(keys.begin(), keys.end());
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MapRangeConstructor(benchmark::State &state) {
+  vector<std::pair<int, int>> pairs(static_cast<std::size_t>(state.range(0)));
+  for (std::size_t i{0}; i < pairs.size(); ++i) {
+    pairs[i] = {static_cast<int>(i), static_cast<int>(i)};
+  }
+  for (auto _ : state) {
+    s21::map<int, int> map(pairs.begin(), pairs.end());
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_SetInsertSorted)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_SetAssignSorted)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_MapRangeConstructor)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 20);
+}  // namespace s21
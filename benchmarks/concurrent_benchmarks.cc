@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <random>
+
+#include "../src/associative/concurrent_map/concurrent_map.h"
+
+namespace s21 {
+namespace {
+/* Throughput of a map shared by 1 to 64 threads: concurrent_map against
+ * s21::map behind one global mutex. Every operation draws a key from
+ * kKeyCount, writes alternate between insert_or_assign and erase so the
+ * size stays near its starting point. range(0) is the percentage of
+ * writes, 10 for a read-heavy and 50 for a write-heavy mix */
+constexpr int kKeyCount = 1 << 20;
+
+class LockedMap {
+ public:
+  bool Find(int key) {
+    std::lock_guard lock(mutex_);
+    return items_.contains(key);
+  }
+
+  void Write(int key, bool erase) {
+    std::lock_guard lock(mutex_);
+    if (erase) {
+      items_.erase(key);
+    } else {
+      items_.insert_or_assign(key, key);
+    }
+  }
+
+  map<int, int> &Items() { return items_; }
+
+ private:
+  std::mutex mutex_;
+  map<int, int> items_;
+};
+
+class ShardedMap {
+ public:
+  bool Find(int key) { return items_.contains(key); }
+
+  void Write(int key, bool erase) {
+    if (erase) {
+      items_.erase(key);
+    } else {
+      items_.insert_or_assign(key, key);
+    }
+  }
+
+  concurrent_map<int, int> &Items() { return items_; }
+
+ private:
+  concurrent_map<int, int> items_{64};
+};
+
+/* Built once and shared by every thread count of a benchmark */
+template <typename Map>
+Map &SharedMap() {
+  static Map *shared = [] {
+    auto *items = new Map();
+    for (int key{0}; key < kKeyCount; key += 2) {
+      items->Items().insert(key, key);
+    }
+    return items;
+  }();
+  return *shared;
+}
+
+template <typename Map>
+void BM_SharedMapMix(benchmark::State &state) {
+  Map &items = SharedMap<Map>();
+  std::mt19937 generator{static_cast<unsigned>(state.thread_index()) + 1};
+  std::uniform_int_distribution<int> keys{0, kKeyCount - 1};
+  std::uniform_int_distribution<int> percent{0, 99};
+  auto write_percent = static_cast<int>(state.range(0));
+  bool erase{false};
+  for (auto _ : state) {
+    int key = keys(generator);
+    if (percent(generator) < write_percent) {
+      items.Write(key, erase);
+      erase = !erase;
+    } else {
+      benchmark::DoNotOptimize(items.Find(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_SharedMapMix, LockedMap)
+    ->Arg(10)
+    ->Arg(50)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(BM_SharedMapMix, ShardedMap)
+    ->Arg(10)
+    ->Arg(50)
+    ->ThreadRange(1, 64)
+    ->UseRealTime();
+}  // namespace s21
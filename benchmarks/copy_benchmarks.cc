@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+
+#include "../src/associative/map/map.h"
+
+namespace s21 {
+namespace {
+/* Snapshot copies: structural clone and node-recycling assignment */
+s21::map<int, int> MakeMap(std::int64_t size) {
+  s21::map<int, int> map{};
+  for (int key{0}; key < static_cast<int>(size); ++key) {
+    map.insert((key * 7919) % static_cast<int>(size), key);
+  }
+  return map;
+}
+
+void BM_MapCopyConstruct(benchmark::State &state) {
+  auto source = MakeMap(state.range(0));
+  for (auto _ : state) {
+    s21::map<int, int> copy{source};
+    benchmark::DoNotOptimize(copy.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MapCopyAssign(benchmark::State &state) {
+  auto source = MakeMap(state.range(0));
+  s21::map<int, int> target{source};
+  for (auto _ : state) {
+    target = source;
+    benchmark::DoNotOptimize(target.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_MapCopyConstruct)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_MapCopyAssign)->RangeMultiplier(16)->Range(1 << 10, 1 << 20);
+}  // namespace s21
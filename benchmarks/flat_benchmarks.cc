@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <utility>
+
+#include "../src/associative/flat_map/flat_map.h"
+#include "../src/associative/map/map.h"
+#include "../src/sequence/vector/vector.h"
+
+namespace s21 {
+namespace {
+/* Read-mostly workloads: a container built once, then probed at random */
+vector<std::pair<int, int>> MakeShuffledPairs(std::int64_t size) {
+  vector<std::pair<int, int>> pairs{};
+  pairs.reserve(static_cast<std::size_t>(size));
+  for (int i{0}; i < static_cast<int>(size); ++i) {
+    pairs.push_back({i, i});
+  }
+  std::shuffle(pairs.begin(), pairs.end(), std::mt19937{42});
+  return pairs;
+}
+
+template <typename Map>
+void BM_ReadMostlyFind(benchmark::State &state) {
+  auto pairs = MakeShuffledPairs(state.range(0));
+  Map map(pairs.begin(), pairs.end());
+  std::size_t index{0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(pairs[index].first));
+    if (++index == pairs.size()) index = 0;
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+/* Builds the whole container from an unsorted batch */
+template <typename Map>
+void BM_ReadMostlyBuild(benchmark::State &state) {
+  auto pairs = MakeShuffledPairs(state.range(0));
+  for (auto _ : state) {
+    Map map(pairs.begin(), pairs.end());
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/* Merges a batch of a tenth of the size into an existing flat_map */
+void BM_FlatMapInsertRange(benchmark::State &state) {
+  auto pairs = MakeShuffledPairs(state.range(0));
+  auto batch_size = static_cast<std::ptrdiff_t>(pairs.size() / 10);
+  for (auto _ : state) {
+    state.PauseTiming();
+    flat_map<int, int> map(pairs.begin() + batch_size, pairs.end());
+    state.ResumeTiming();
+    map.insert_range(pairs.begin(), pairs.begin() + batch_size);
+    benchmark::DoNotOptimize(map.size());
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ReadMostlyFind, map<int, int>)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22)
+    ->Complexity(benchmark::oLogN);
+BENCHMARK_TEMPLATE(BM_ReadMostlyFind, flat_map<int, int>)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22)
+    ->Complexity(benchmark::oLogN);
+BENCHMARK_TEMPLATE(BM_ReadMostlyBuild, map<int, int>)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(BM_ReadMostlyBuild, flat_map<int, int>)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 19);
+BENCHMARK(BM_FlatMapInsertRange)->RangeMultiplier(8)->Range(1 << 10, 1 << 22);
+}  // namespace s21
@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+
+#include "../src/associative/set/set.h"
+#include "../src/sequence/vector/vector.h"
+
+namespace s21 {
+namespace {
+/* Time-series style ingest: plain insert relies on the automatic append
+ * and prepend paths, hinted insert passes the previous position */
+enum class Order { kSorted, kReverse, kNearlySorted };
+
+vector<int> MakeKeys(std::int64_t size, Order order) {
+  vector<int> keys(static_cast<std::size_t>(size));
+  for (std::size_t i{0}; i < keys.size(); ++i) {
+    keys[i] = static_cast<int>(order == Order::kReverse ? keys.size() - i : i);
+  }
+  if (order == Order::kNearlySorted) {
+    /* Every 64th key arrives a little late */
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<std::size_t> distance{1, 32};
+    for (std::size_t i{0}; i + 32 < keys.size(); i += 64) {
+      std::swap(keys[i], keys[i + distance(generator)]);
+    }
+  }
+  return keys;
+}
+
+void BM_SetIngest(benchmark::State &state, Order order) {
+  auto keys = MakeKeys(state.range(0), order);
+  for (auto _ : state) {
+    s21::set<int> set{};
+    for (int key : keys) {
+      set.insert(key);
+    }
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SetIngestHinted(benchmark::State &state, Order order) {
+  auto keys = MakeKeys(state.range(0), order);
+  for (auto _ : state) {
+    s21::set<int> set{};
+    auto hint = set.end();
+    for (int key : keys) {
+      hint = set.insert(hint, key);
+      if (order != Order::kReverse) {
+        ++hint;
+      }
+    }
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/* Unsorted batches of range(0) random keys into a set of 2^20 random keys:
+ * one insert per key against insert_batch. The set is reset outside the
+ * timing before every run, hence the fixed iteration count */
+const s21::set<int> &BaseSet() {
+  static const s21::set<int> base = [] {
+    std::mt19937 generator{7};
+    s21::set<int> result{};
+    for (int i{0}; i < (1 << 20); ++i) {
+      result.insert(static_cast<int>(generator() >> 1));
+    }
+    return result;
+  }();
+  return base;
+}
+
+template <typename Insert>
+void RunBatch(benchmark::State &state, Insert insert) {
+  std::mt19937 generator{42};
+  vector<int> batch(static_cast<std::size_t>(state.range(0)));
+  for (int &key : batch) {
+    key = static_cast<int>(generator() >> 1);
+  }
+  s21::set<int> set{};
+  for (auto _ : state) {
+    state.PauseTiming();
+    set = BaseSet();
+    state.ResumeTiming();
+    insert(set, batch);
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BatchKeyByKey(benchmark::State &state) {
+  RunBatch(state, [](s21::set<int> &set, const vector<int> &batch) {
+    for (int key : batch) {
+      set.insert(key);
+    }
+  });
+}
+
+void BM_BatchInsertBatch(benchmark::State &state) {
+  RunBatch(state, [](s21::set<int> &set, const vector<int> &batch) {
+    set.insert_batch(batch.begin(), batch.end());
+  });
+}
+}  // namespace
+
+BENCHMARK_CAPTURE(BM_SetIngest, Sorted, Order::kSorted)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 20);
+BENCHMARK_CAPTURE(BM_SetIngest, Reverse, Order::kReverse)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 20);
+BENCHMARK_CAPTURE(BM_SetIngest, NearlySorted, Order::kNearlySorted)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 20);
+BENCHMARK_CAPTURE(BM_SetIngestHinted, Sorted, Order::kSorted)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 20);
+BENCHMARK_CAPTURE(BM_SetIngestHinted, Reverse, Order::kReverse)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 20);
+BENCHMARK_CAPTURE(BM_SetIngestHinted, NearlySorted, Order::kNearlySorted)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_BatchKeyByKey)
+    ->RangeMultiplier(8)
+    ->Range(1 << 13, 1 << 19)
+    ->Iterations(10);
+BENCHMARK(BM_BatchInsertBatch)
+    ->RangeMultiplier(8)
+    ->Range(1 << 13, 1 << 19)
+    ->Iterations(10);
+}  // namespace s21
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <utility>
+
+#include "../src/associative/interval_set/interval_set.h"
+#include "../src/associative/multiset/multiset.h"
+
+namespace s21 {
+namespace {
+/* 2^16 reservations of 1 to 100 time units, ten units of horizon each,
+ * then "which ones overlap [a, a + 50)". The workaround keeps a multiset
+ * of (start, end) and filters every reservation starting before a + 50,
+ * interval_set skips subtrees that end too early */
+constexpr int kReservations = 1 << 16;
+constexpr int kQueryLength = 50;
+
+using Interval = std::pair<int, int>;
+
+template <typename Insert>
+void FillReservations(int horizon, Insert insert) {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> starts{0, horizon};
+  std::uniform_int_distribution<int> lengths{1, 100};
+  for (int i{0}; i < kReservations; ++i) {
+    int start = starts(generator);
+    insert(start, start + lengths(generator));
+  }
+}
+
+void BM_OverlapMultisetScan(benchmark::State &state) {
+  int horizon = kReservations * 10;
+  multiset<Interval> reservations{};
+  FillReservations(horizon, [&reservations](int low, int high) {
+    reservations.insert({low, high});
+  });
+  std::mt19937 generator{7};
+  std::uniform_int_distribution<int> queries{0, horizon};
+  for (auto _ : state) {
+    int low = queries(generator);
+    int high = low + kQueryLength;
+    std::size_t hits{0};
+    for (auto it = reservations.begin();
+         it != reservations.end() && it->first < high; ++it) {
+      hits += low < it->second ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_OverlapIntervalSet(benchmark::State &state) {
+  int horizon = kReservations * 10;
+  interval_set<int> reservations{};
+  FillReservations(horizon, [&reservations](int low, int high) {
+    reservations.insert(low, high);
+  });
+  std::mt19937 generator{7};
+  std::uniform_int_distribution<int> queries{0, horizon};
+  for (auto _ : state) {
+    int low = queries(generator);
+    std::size_t hits{0};
+    reservations.for_each_overlap(low, low + kQueryLength,
+                                  [&hits](const Interval &) { ++hits; });
+    benchmark::DoNotOptimize(hits);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+}  // namespace
+
+BENCHMARK(BM_OverlapMultisetScan);
+BENCHMARK(BM_OverlapIntervalSet);
+}  // namespace s21
@@ -0,0 +1,135 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+
+#include "../src/associative/map/map.h"
+#include "../src/associative/multiset/multiset.h"
+#include "../src/associative/set/set.h"
+#include "../src/sequence/vector/vector.h"
+
+namespace s21 {
+namespace {
+/* Lookup cost must stay flat (logarithmic) while the container grows */
+vector<int> MakeShuffledKeys(std::int64_t size) {
+  vector<int> keys(static_cast<std::size_t>(size));
+  for (std::size_t i{0}; i < keys.size(); ++i) {
+    keys[i] = static_cast<int>(i);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937{42});
+  return keys;
+}
+
+void BM_MapFind(benchmark::State &state) {
+  auto keys = MakeShuffledKeys(state.range(0));
+  s21::map<int, int> map{};
+  for (int key : keys) {
+    map.insert(key, key);
+  }
+
+  std::size_t index{0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.find(keys[index]));
+    if (++index == keys.size()) index = 0;
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_MapAt(benchmark::State &state) {
+  auto keys = MakeShuffledKeys(state.range(0));
+  s21::map<int, int> map{};
+  for (int key : keys) {
+    map.insert(key, key);
+  }
+
+  std::size_t index{0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.at(keys[index]));
+    if (++index == keys.size()) index = 0;
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_SetContains(benchmark::State &state) {
+  auto keys = MakeShuffledKeys(state.range(0));
+  s21::set<int> set{};
+  for (int key : keys) {
+    set.insert(key);
+  }
+
+  std::size_t index{0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(set.contains(keys[index]));
+    if (++index == keys.size()) index = 0;
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+/* Probes fall between stored keys, so every query is a real bound search */
+void BM_MapLowerBound(benchmark::State &state) {
+  auto keys = MakeShuffledKeys(state.range(0));
+  s21::map<int, int> map{};
+  for (int key : keys) {
+    map.insert(key * 2, key);
+  }
+
+  std::size_t index{0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(map.lower_bound(keys[index] * 2 + 1));
+    if (++index == keys.size()) index = 0;
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_MultisetEqualRange(benchmark::State &state) {
+  auto keys = MakeShuffledKeys(state.range(0));
+  s21::multiset<int> multiset{};
+  for (int key : keys) {
+    multiset.insert(key / 16);
+  }
+
+  std::size_t index{0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(multiset.equal_range(keys[index] / 16));
+    if (++index == keys.size()) index = 0;
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_MultisetCount(benchmark::State &state) {
+  auto keys = MakeShuffledKeys(state.range(0));
+  s21::multiset<int> multiset{};
+  for (int key : keys) {
+    multiset.insert(key / 16);
+  }
+
+  std::size_t index{0};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(multiset.count(keys[index] / 16));
+    if (++index == keys.size()) index = 0;
+  }
+  state.SetComplexityN(state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_MapFind)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->Complexity(
+    benchmark::oLogN);
+BENCHMARK(BM_MapAt)->RangeMultiplier(8)->Range(1 << 10, 1 << 22)->Complexity(
+    benchmark::oLogN);
+BENCHMARK(BM_SetContains)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22)
+    ->Complexity(benchmark::oLogN);
+BENCHMARK(BM_MapLowerBound)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22)
+    ->Complexity(benchmark::oLogN);
+BENCHMARK(BM_MultisetEqualRange)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22)
+    ->Complexity(benchmark::oLogN);
+BENCHMARK(BM_MultisetCount)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 22)
+    ->Complexity(benchmark::oLogN);
+}  // namespace s21
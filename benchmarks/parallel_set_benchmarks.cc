@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include "../src/associative/set/set.h"
+
+namespace s21 {
+namespace {
+/* Union and merge of two interleaved sets of 2^20 keys each, split by key
+ * range across the given number of threads */
+constexpr int kSetSize = 1 << 20;
+
+s21::set<int> MakeSet(int offset) {
+  std::vector<int> keys{};
+  for (int key{0}; key < kSetSize; ++key) {
+    keys.push_back(key * 2 + offset);
+  }
+  s21::set<int> set{};
+  set.assign_sorted(keys.begin(), keys.end());
+  return set;
+}
+
+void BM_SetUnionThreads(benchmark::State &state) {
+  const s21::set<int> evens = MakeSet(0);
+  const s21::set<int> odds = MakeSet(1);
+  auto thread_count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    s21::set<int> target{evens};
+    s21::set<int> source{odds};
+    state.ResumeTiming();
+    target.set_union(std::move(source), thread_count);
+    benchmark::DoNotOptimize(target.size());
+    state.PauseTiming();
+    target.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * 2 * kSetSize);
+}
+
+void BM_SetMergeThreads(benchmark::State &state) {
+  const s21::set<int> evens = MakeSet(0);
+  const s21::set<int> odds = MakeSet(1);
+  auto thread_count = static_cast<std::size_t>(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    s21::set<int> target{evens};
+    s21::set<int> source{odds};
+    state.ResumeTiming();
+    target.merge(source, thread_count);
+    benchmark::DoNotOptimize(target.size());
+    state.PauseTiming();
+    target.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * 2 * kSetSize);
+}
+}  // namespace
+
+BENCHMARK(BM_SetUnionThreads)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SetMergeThreads)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+}  // namespace s21
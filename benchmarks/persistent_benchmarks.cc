@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "../src/associative/map/map.h"
+#include "../src/associative/persistent_map/persistent_map.h"
+
+namespace s21 {
+namespace {
+/* A writer that hands out a snapshot after every update: copying s21::map
+ * is O(n) per snapshot, a persistent_map version costs O(log n) new nodes
+ * for the update and O(1) for the snapshot */
+void BM_SnapshotMapCopy(benchmark::State &state) {
+  map<int, int> current{};
+  for (int key{0}; key < state.range(0); ++key) {
+    current.insert(key, key);
+  }
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> distribution{
+      0, static_cast<int>(state.range(0)) - 1};
+  for (auto _ : state) {
+    current.insert_or_assign(distribution(generator), 0);
+    map<int, int> snapshot{current};
+    benchmark::DoNotOptimize(snapshot.size());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_SnapshotPersistent(benchmark::State &state) {
+  persistent_map<int, int> current{};
+  for (int key{0}; key < state.range(0); ++key) {
+    current = current.insert(key, key);
+  }
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> distribution{
+      0, static_cast<int>(state.range(0)) - 1};
+  for (auto _ : state) {
+    current = current.insert_or_assign(distribution(generator), 0);
+    persistent_map<int, int> snapshot{current};
+    benchmark::DoNotOptimize(snapshot.size());
+  }
+  state.SetComplexityN(state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_SnapshotMapCopy)->RangeMultiplier(8)->Range(1 << 9, 1 << 18);
+BENCHMARK(BM_SnapshotPersistent)->RangeMultiplier(8)->Range(1 << 9, 1 << 18);
+}  // namespace s21
@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include <utility>
+
+#include "../src/associative/map/map.h"
+#include "../src/sequence/vector/vector.h"
+
+namespace s21 {
+namespace {
+/* Expiring range(0) consecutive keys from the middle of a map of 2^20:
+ * one erase per key against a single erase_range. The map is rebuilt
+ * outside the timing before every run, hence the fixed iteration count */
+constexpr int kMapSize = 1 << 20;
+
+const vector<std::pair<int, int>> &SortedPairs() {
+  static const vector<std::pair<int, int>> pairs = [] {
+    vector<std::pair<int, int>> result(kMapSize);
+    for (int i{0}; i < kMapSize; ++i) {
+      result[static_cast<std::size_t>(i)] = {i, i};
+    }
+    return result;
+  }();
+  return pairs;
+}
+
+template <typename Erase>
+void RunExpiry(benchmark::State &state, Erase erase) {
+  int low = kMapSize / 4;
+  int high = low + static_cast<int>(state.range(0));
+  map<int, int> items{};
+  for (auto _ : state) {
+    state.PauseTiming();
+    items.assign_sorted(SortedPairs().begin(), SortedPairs().end());
+    state.ResumeTiming();
+    erase(items, low, high);
+    benchmark::DoNotOptimize(items.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ExpireKeyByKey(benchmark::State &state) {
+  RunExpiry(state, [](map<int, int> &items, int low, int high) {
+    for (int key{low}; key < high; ++key) {
+      items.erase(key);
+    }
+  });
+}
+
+void BM_ExpireRange(benchmark::State &state) {
+  RunExpiry(state, [](map<int, int> &items, int low, int high) {
+    items.erase_range(low, high);
+  });
+}
+}  // namespace
+
+BENCHMARK(BM_ExpireKeyByKey)
+    ->RangeMultiplier(16)
+    ->Range(1 << 2, 1 << 18)
+    ->Iterations(20);
+BENCHMARK(BM_ExpireRange)
+    ->RangeMultiplier(16)
+    ->Range(1 << 2, 1 << 18)
+    ->Iterations(20);
+}  // namespace s21
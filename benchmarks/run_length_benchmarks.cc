@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "../src/associative/multiset/multiset.h"
+#include "../src/associative/run_length_multiset/run_length_multiset.h"
+
+namespace s21 {
+namespace {
+/* Event counting: range(0) inserts over 4096 distinct keys, then count on
+ * every key. multiset allocates a node per insert, run_length_multiset one
+ * per distinct key; the nodes counter reports how many each one holds */
+constexpr int kDistinctKeys = 4096;
+
+template <typename Multiset>
+std::size_t NodeCount(const Multiset &items);
+
+template <>
+std::size_t NodeCount(const multiset<int> &items) {
+  return items.size();
+}
+
+template <>
+std::size_t NodeCount(const run_length_multiset<int> &items) {
+  return items.distinct_size();
+}
+
+template <typename Multiset>
+void BM_CountEvents(benchmark::State &state) {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> distribution{0, kDistinctKeys - 1};
+  std::size_t nodes{0};
+  for (auto _ : state) {
+    Multiset events{};
+    for (std::int64_t i{0}; i < state.range(0); ++i) {
+      events.insert(distribution(generator));
+    }
+    std::size_t total{0};
+    for (int key{0}; key < kDistinctKeys; ++key) {
+      total += events.count(key);
+    }
+    benchmark::DoNotOptimize(total);
+    nodes = NodeCount(events);
+  }
+  state.counters["nodes"] = static_cast<double>(nodes);
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_CountEvents, multiset<int>)
+    ->RangeMultiplier(8)
+    ->Range(1 << 12, 1 << 21)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_CountEvents, run_length_multiset<int>)
+    ->RangeMultiplier(8)
+    ->Range(1 << 12, 1 << 21)
+    ->Unit(benchmark::kMillisecond);
+}  // namespace s21
@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <random>
+
+#include "../src/associative/map/map.h"
+#include "../src/sequence/vector/vector.h"
+
+namespace s21 {
+namespace {
+/* Full scans of large maps. Keys are inserted shuffled, so neighbours in
+ * key order are scattered over the heap like in a long-lived map */
+vector<int> MakeShuffledKeys(std::int64_t size) {
+  vector<int> keys(static_cast<std::size_t>(size));
+  for (std::size_t i{0}; i < keys.size(); ++i) {
+    keys[i] = static_cast<int>(i);
+  }
+  std::shuffle(keys.begin(), keys.end(), std::mt19937{42});
+  return keys;
+}
+
+template <typename Map>
+Map MakeMap(std::int64_t size) {
+  Map map{};
+  for (int key : MakeShuffledKeys(size)) {
+    map.insert({key, key});
+  }
+  return map;
+}
+
+void BM_StdMapScan(benchmark::State &state) {
+  auto map = MakeMap<std::map<int, int>>(state.range(0));
+  for (auto _ : state) {
+    std::int64_t sum{0};
+    for (const auto &item : map) {
+      sum += item.second;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MapScanIterator(benchmark::State &state) {
+  auto map = MakeMap<s21::map<int, int>>(state.range(0));
+  for (auto _ : state) {
+    std::int64_t sum{0};
+    for (const auto &item : map) {
+      sum += item.second;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using ThreadedMap =
+    s21::map<int, int, std::less<int>, ThreadedNodes<HeapNodeAllocator>>;
+
+void BM_ThreadedMapScanIterator(benchmark::State &state) {
+  auto map = MakeMap<ThreadedMap>(state.range(0));
+  for (auto _ : state) {
+    std::int64_t sum{0};
+    for (const auto &item : map) {
+      sum += item.second;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MapScanRange(benchmark::State &state) {
+  auto map = MakeMap<s21::map<int, int>>(state.range(0));
+  int high{static_cast<int>(state.range(0))};
+  for (auto _ : state) {
+    std::int64_t sum{0};
+    for (const auto &item : map.scan(0, high)) {
+      sum += item.second;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_MapForEachRange(benchmark::State &state) {
+  auto map = MakeMap<s21::map<int, int>>(state.range(0));
+  int high{static_cast<int>(state.range(0))};
+  for (auto _ : state) {
+    std::int64_t sum{0};
+    map.for_each_range(0, high, [&sum](const std::pair<const int, int> &item) {
+      sum += item.second;
+    });
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_StdMapScan)
+    ->Arg(1 << 16)
+    ->Arg(10'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MapScanIterator)
+    ->Arg(1 << 16)
+    ->Arg(10'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ThreadedMapScanIterator)
+    ->Arg(1 << 16)
+    ->Arg(10'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MapScanRange)
+    ->Arg(1 << 16)
+    ->Arg(10'000'000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MapForEachRange)
+    ->Arg(1 << 16)
+    ->Arg(10'000'000)
+    ->Unit(benchmark::kMillisecond);
+}  // namespace s21
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include "../src/associative/set/set.h"
+
+namespace s21 {
+namespace {
+/* A small set folded into a large one and taken out again: join-based set
+ * algebra against one insert and one erase per element */
+constexpr int kLargeSize = 1 << 20;
+
+s21::set<int> MakeLargeSet() {
+  s21::set<int> large{};
+  for (int key{0}; key < kLargeSize; ++key) {
+    large.insert(key * 2);
+  }
+  return large;
+}
+
+s21::set<int> MakeSmallSet(std::int64_t size) {
+  s21::set<int> small{};
+  for (std::int64_t i{0}; i < size; ++i) {
+    small.insert(static_cast<int>(i * (2 * kLargeSize / size)) + 1);
+  }
+  return small;
+}
+
+void BM_SetUnionThenDifference(benchmark::State &state) {
+  s21::set<int> large = MakeLargeSet();
+  s21::set<int> small = MakeSmallSet(state.range(0));
+  for (auto _ : state) {
+    large.set_union(small);
+    large.set_difference(small);
+    benchmark::DoNotOptimize(large.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SetInsertThenErase(benchmark::State &state) {
+  s21::set<int> large = MakeLargeSet();
+  s21::set<int> small = MakeSmallSet(state.range(0));
+  for (auto _ : state) {
+    for (int key : small) {
+      large.insert(key);
+    }
+    for (int key : small) {
+      large.erase(key);
+    }
+    benchmark::DoNotOptimize(large.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_SetUnionThenDifference)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK(BM_SetInsertThenErase)->RangeMultiplier(16)->Range(16, 1 << 20);
+}  // namespace s21
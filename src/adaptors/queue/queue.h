@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <initializer_list>
+#include <utility>
 
 #include "../../sequence/list/list.h"
 
@@ -56,13 +57,20 @@ class queue {
 
   void push(const_reference value) { container_.push_back(value); }
 
+  void push(value_type &&value) { container_.push_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace(Args &&...args) {
+    return container_.emplace_back(std::forward<Args>(args)...);
+  }
+
   void pop() { container_.pop_front(); }
 
   void swap(queue &other) { container_.swap(other.container_); }
 
   template <typename... Args>
   void insert_many_back(Args &&...arguments) {
-    container_.insert_many_back(arguments...);
+    container_.insert_many_back(std::forward<Args>(arguments)...);
   }
 
  private:
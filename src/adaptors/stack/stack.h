@@ -3,6 +3,7 @@
 
 #include <cstddef>
 #include <initializer_list>
+#include <utility>
 
 #include "../../sequence/list/list.h"
 
@@ -50,16 +51,21 @@ class stack {
 
   void push(const_reference value) { container_.push_front(value); }
 
+  void push(value_type &&value) { container_.push_front(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace(Args &&...args) {
+    return container_.emplace_front(std::forward<Args>(args)...);
+  }
+
   void pop() { container_.pop_front(); }
 
   void swap(stack &other) { container_.swap(other.container_); }
 
+  /* Pushes the arguments in order, the last one ends up on top */
   template <typename... Args>
   void insert_many_front(Args &&...arguments) {
-    std::initializer_list<value_type> items{arguments...};
-    for (const auto &item : items) {
-      push(item);
-    }
+    (emplace(std::forward<Args>(arguments)), ...);
   }
 
  private:
@@ -0,0 +1,1760 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_B_TREE_B_TREE_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_B_TREE_B_TREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../red_black_tree/RedBlackTree.h"
+#include "BTreeSearch.h"
+
+namespace s21 {
+/* Storage policy of map, set and multiset. Passed in place of a node
+ * allocator it keeps the elements in a BTree with nodes of about
+ * kNodeBytes bytes */
+template <std::size_t kNodeBytes = 256>
+struct BTreeNodes {
+  static_assert(kNodeBytes >= 64, "a node must hold a few elements");
+};
+
+/* node_type of a BTree. Its elements live in leaves, not in nodes of their
+ * own, so there is no node to hand out and the type cannot be created */
+struct NoNodeHandle {
+  NoNodeHandle() = delete;
+};
+
+/* B+tree with the interface of RedBlackTree. Elements sit in leaves that
+ * are chained in key order, inner nodes hold copies of the separating keys
+ * and the number of elements below each child. A position is a leaf and an
+ * index in it, so unlike with RedBlackTree an insert or erase invalidates
+ * the iterators into the leaves it touches. Elements and keys are moved
+ * between nodes with no way back halfway, so their move constructors must
+ * not throw */
+template <typename T, typename KeyOfValue = IdentityKey<T>,
+          typename Compare = std::less<>, std::size_t kNodeBytes = 256>
+class BTree : private KeyCompare<Compare> {
+  using KeyCompareBase = KeyCompare<Compare>;
+  using KeyCompareBase::Less;
+
+ public:
+  using key_type = std::remove_cv_t<std::remove_reference_t<
+      decltype(KeyOfValue{}(std::declval<const T &>()))>>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  static_assert(std::is_nothrow_move_constructible_v<T> &&
+                    std::is_nothrow_move_constructible_v<key_type>,
+                "BTree relocates elements and keys, moving them must not "
+                "throw");
+
+ private:
+  struct Inner;
+
+  /* count_ is the number of elements of a leaf and of keys of an inner
+   * node */
+  struct NodeBase {
+    Inner *parent_{};
+    size_type count_{};
+  };
+
+  /* The leaves form a ring closed by sentinel_, an empty LeafLinks, so
+   * end() is (sentinel_, 0) and --end() reaches the last leaf */
+  struct LeafLinks : NodeBase {
+    LeafLinks *prev_{this};
+    LeafLinks *next_{this};
+  };
+
+  static constexpr bool kSimdKeys = kSimdSearchable<key_type, Compare>;
+  /* Leaves of a map with arithmetic keys mirror the keys in a plain array
+   * for the SIMD search, set leaves are such an array already */
+  static constexpr bool kShadowKeys =
+      kSimdKeys && !std::is_same_v<T, key_type>;
+
+  static constexpr size_type FitSlots(size_type bytes, size_type slot_bytes,
+                                      size_type minimum) {
+    return bytes / slot_bytes > minimum ? bytes / slot_bytes - 1 : minimum;
+  }
+
+ public:
+  /* Nodes have one slot more than they are filled to: an insert lands in
+   * its node first and a node past the limit splits afterwards */
+  static constexpr size_type kLeafSlots =
+      FitSlots(kNodeBytes - sizeof(LeafLinks),
+               sizeof(T) + (kShadowKeys ? sizeof(key_type) : 0), 4);
+  static constexpr size_type kInnerKeys =
+      FitSlots(kNodeBytes - sizeof(NodeBase) - 2 * sizeof(size_type),
+               sizeof(key_type) + sizeof(void *) + sizeof(size_type), 3);
+
+ private:
+  static constexpr size_type kMinLeaf = kLeafSlots / 2;
+  static constexpr size_type kMinInner = kInnerKeys / 2;
+
+  struct NoShadowKeys {};
+
+  struct ShadowKeys {
+    key_type keys_[kLeafSlots + 1];
+  };
+
+  /* values_ is alive in [0, count_) only */
+  struct Leaf : LeafLinks,
+                std::conditional_t<kShadowKeys, ShadowKeys, NoShadowKeys> {
+    union {
+      T values_[kLeafSlots + 1];
+    };
+
+    Leaf() {}
+
+    ~Leaf() {}
+  };
+
+  /* keys_ is alive in [0, count_), children_ and sizes_ in [0, count_] */
+  struct Inner : NodeBase {
+    union {
+      key_type keys_[kInnerKeys + 1];
+    };
+    NodeBase *children_[kInnerKeys + 2];
+    size_type sizes_[kInnerKeys + 2];
+
+    Inner() {}
+
+    ~Inner() {}
+  };
+
+ public:
+  /* Leaf and index of an element, (sentinel, 0) past the last one */
+  struct Position {
+    LeafLinks *leaf{};
+    size_type index{};
+
+    bool operator==(const Position &other) const {
+      return leaf == other.leaf && index == other.index;
+    }
+
+    bool operator!=(const Position &other) const { return !(*this == other); }
+  };
+
+  template <bool IsConst>
+  class BTreeIteratorBase {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = std::conditional_t<IsConst, const T *, T *>;
+    using reference = std::conditional_t<IsConst, const T &, T &>;
+
+    BTreeIteratorBase() = default;
+
+    explicit BTreeIteratorBase(Position position) : position_(position) {}
+
+    /* Mutable iterators convert to const ones */
+    template <bool OtherIsConst,
+              typename = std::enable_if_t<IsConst && !OtherIsConst>>
+    BTreeIteratorBase(const BTreeIteratorBase<OtherIsConst> &other)
+        : position_(other.position_) {}
+
+    /* Steps inside a leaf move the index, the leaf links are followed once
+     * per leaf */
+    BTreeIteratorBase &operator++() {
+      if (++position_.index == position_.leaf->count_) {
+        position_ = {position_.leaf->next_, 0};
+      }
+      return *this;
+    }
+
+    BTreeIteratorBase &operator--() {
+      if (position_.index == 0) {
+        position_.leaf = position_.leaf->prev_;
+        position_.index = position_.leaf->count_;
+      }
+      --position_.index;
+      return *this;
+    }
+
+    BTreeIteratorBase operator++(int) {
+      BTreeIteratorBase iter(*this);
+      ++(*this);
+      return iter;
+    }
+
+    BTreeIteratorBase operator--(int) {
+      BTreeIteratorBase iter(*this);
+      --(*this);
+      return iter;
+    }
+
+    reference operator*() const { return ValueAt(position_); }
+
+    pointer operator->() const { return &ValueAt(position_); }
+
+    template <bool OtherIsConst>
+    bool operator==(const BTreeIteratorBase<OtherIsConst> &other) const {
+      return position_ == other.position_;
+    }
+
+    template <bool OtherIsConst>
+    bool operator!=(const BTreeIteratorBase<OtherIsConst> &other) const {
+      return position_ != other.position_;
+    }
+
+    [[nodiscard]] Position base() const { return position_; }
+
+   private:
+    template <bool>
+    friend class BTreeIteratorBase;
+
+    Position position_{};
+  };
+
+  /* Forward iterator for bulk scans, prefetches the next leaf whenever it
+   * enters one */
+  template <bool IsConst>
+  class ScanIteratorBase {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = std::conditional_t<IsConst, const T *, T *>;
+    using reference = std::conditional_t<IsConst, const T &, T &>;
+
+    ScanIteratorBase() = default;
+
+    explicit ScanIteratorBase(Position position) : position_(position) {
+      PrefetchLeaf(position_.leaf->next_);
+    }
+
+    ScanIteratorBase &operator++() {
+      if (++position_.index == position_.leaf->count_) {
+        position_ = {position_.leaf->next_, 0};
+        PrefetchLeaf(position_.leaf->next_);
+      }
+      return *this;
+    }
+
+    ScanIteratorBase operator++(int) {
+      ScanIteratorBase iter(*this);
+      ++(*this);
+      return iter;
+    }
+
+    reference operator*() const { return ValueAt(position_); }
+
+    pointer operator->() const { return &ValueAt(position_); }
+
+    bool operator==(const ScanIteratorBase &other) const {
+      return position_ == other.position_;
+    }
+
+    bool operator!=(const ScanIteratorBase &other) const {
+      return position_ != other.position_;
+    }
+
+   private:
+    Position position_{};
+  };
+
+ public:
+  using mutable_iterator = BTreeIteratorBase<false>;
+  using const_iterator = BTreeIteratorBase<true>;
+  using iterator = const_iterator;
+  using mapped_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using node_type = NoNodeHandle;
+  using key_compare = Compare;
+
+  BTree() = default;
+
+  explicit BTree(const Compare &compare) : KeyCompareBase(compare) {}
+
+  BTree(const BTree &other) : KeyCompareBase(other) {
+    BuildSorted(other.begin(), other.end(), false);
+  }
+
+  BTree(BTree &&other) noexcept : KeyCompareBase(other) { TakeOver(other); }
+
+  ~BTree() { Clear(); }
+
+  BTree &operator=(const BTree &other) {
+    if (this != &other) {
+      BTree copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  BTree &operator=(BTree &&other) noexcept {
+    if (this != &other) {
+      Clear();
+      KeyCompareBase::operator=(other);
+      TakeOver(other);
+    }
+    return *this;
+  }
+
+ public:
+  [[nodiscard]] size_type GetMaxSize() const {
+    std::allocator<mapped_type> memory;
+    return std::min(memory.max_size(), std::numeric_limits<size_type>::max());
+  }
+
+  [[nodiscard]] bool IsEmpty() const { return size_ == 0; }
+
+  [[nodiscard]] size_type GetSize() const { return size_; }
+
+  [[nodiscard]] size_type GetHeight() const { return height_; }
+
+  /* Past-the-last position, the counterpart of nil_ in RedBlackTree */
+  [[nodiscard]] Position GetNil() const { return {Sentinel(), 0}; }
+
+  [[nodiscard]] const Compare &GetCompare() const noexcept {
+    return KeyCompareBase::GetCompare();
+  }
+
+  /* Leaves are allocated a whole node at a time, nothing to reserve */
+  void ReserveNodes(size_type count) { static_cast<void>(count); }
+
+  void Clear() noexcept {
+    if (height_ > 1) {
+      DestroyInnerLevels(static_cast<Inner *>(root_), height_);
+    }
+    for (LeafLinks *leaf = sentinel_.next_; leaf != &sentinel_;) {
+      LeafLinks *next = leaf->next_;
+      DestroyLeaf(ToLeaf(leaf));
+      leaf = next;
+    }
+    ResetToEmpty();
+  }
+
+  /* Replaces the content with [first, last). Sorted forward ranges are
+   * built in O(n), anything else falls back to one Insert per element.
+   * With unique set only the first element of equal keys is kept */
+  template <typename InputIt>
+  void Assign(InputIt first, InputIt last, bool unique) {
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+      if (IsSortedRange(first, last)) {
+        AssignSorted(first, last, unique);
+        return;
+      }
+    }
+    Clear();
+    for (; first != last; ++first) {
+      if (!unique || SearchByKey(KeyOfValue{}(*first)) == GetNil()) {
+        Insert(*first);
+      }
+    }
+  }
+
+  /* Trusts [first, last) to be sorted by key and fills the leaves one
+   * after another in O(n) */
+  template <typename ForwardIt>
+  void AssignSorted(ForwardIt first, ForwardIt last, bool unique) {
+    Clear();
+    BuildSorted(first, last, unique);
+  }
+
+  /* Equal keys go after the ones already present */
+  iterator Insert(const T &data) {
+    InsertPosition position = FindInsertPosition(KeyOfValue{}(data), false);
+    return iterator(EmplaceAt(position.leaf, position.index, data));
+  }
+
+  iterator Insert(T &&data) {
+    InsertPosition position = FindInsertPosition(KeyOfValue{}(data), false);
+    return iterator(EmplaceAt(position.leaf, position.index, std::move(data)));
+  }
+
+  /* Returns the element holding the key and whether it was inserted */
+  std::pair<Position, bool> InsertUnique(const T &data) {
+    return InsertValue(GetNil(), data, true, false);
+  }
+
+  std::pair<Position, bool> InsertUnique(T &&data) {
+    return InsertValue(GetNil(), std::move(data), true, false);
+  }
+
+  /* Inserts right before hint when the key belongs there and hint is at
+   * either end or inside a leaf, otherwise falls back to a plain insert */
+  std::pair<Position, bool> InsertHint(Position hint, const T &data,
+                                       bool unique) {
+    return InsertValue(hint, data, unique, true);
+  }
+
+  std::pair<Position, bool> InsertHint(Position hint, T &&data, bool unique) {
+    return InsertValue(hint, std::move(data), unique, true);
+  }
+
+  /* Same contract as RedBlackTree::InsertAfter. A sorted sequence keeps
+   * the few inner levels above its leaves cached, so every element simply
+   * descends from the root and finger goes unused */
+  template <typename Value>
+  std::pair<Position, bool> InsertAfter(Position finger, Value &&data,
+                                        bool unique) {
+    static_cast<void>(finger);
+    if (unique) {
+      InsertPosition position = FindInsertPosition(KeyOfValue{}(data), true);
+      if (position.found) {
+        return {position.existing, false};
+      }
+      return {EmplaceAt(position.leaf, position.index,
+                        std::forward<Value>(data)),
+              true};
+    }
+    return {Insert(T(std::forward<Value>(data))).base(), true};
+  }
+
+  /* Builds the element from args only when the key is absent */
+  template <typename... Args>
+  std::pair<Position, bool> EmplaceIfAbsent(const key_type &key,
+                                            Args &&...args) {
+    InsertPosition position = FindInsertPosition(key, true);
+    if (position.found) {
+      return {position.existing, false};
+    }
+    return {EmplaceAt(position.leaf, position.index,
+                      std::forward<Args>(args)...),
+            true};
+  }
+
+  /* The element is built from args first to learn its key, then moved
+   * into its leaf */
+  template <typename... Args>
+  std::pair<Position, bool> EmplaceHint(Position hint, bool unique,
+                                        Args &&...args) {
+    return InsertHint(hint, T(std::forward<Args>(args)...), unique);
+  }
+
+  /* Destroys the element at position without searching for it again, the
+   * end position is ignored */
+  void Erase(Position position) {
+    if (position.leaf != nullptr && position.leaf != Sentinel()) {
+      EraseAt(ToLeaf(position.leaf), position.index);
+    }
+  }
+
+  void Remove(const T &data) { RemoveByKey(KeyOfValue{}(data)); }
+
+  template <typename K>
+  void RemoveByKey(const K &key) {
+    Position position = SearchByKey(key);
+    if (position != GetNil()) {
+      EraseAt(ToLeaf(position.leaf), position.index);
+    }
+  }
+
+  /* Destroys the elements in [first, last) and returns the position of the
+   * element that followed them, in O(k + log n). Whole leaves and subtrees
+   * between the two boundary leaves are dropped, only the nodes on the two
+   * paths from those leaves to the root are trimmed and refilled */
+  Position EraseRange(Position first, Position last) {
+    size_type offset = GetNodeRank(first);
+    size_type count = GetNodeRank(last) - offset;
+    if (count == 0) {
+      return last;
+    }
+    if (count == size_) {
+      Clear();
+      return GetNil();
+    }
+    Leaf *left = ToLeaf(first.leaf);
+    Leaf *right = last.leaf == Sentinel() ? nullptr : ToLeaf(last.leaf);
+    if (left == right) {
+      TrimLeaf(left, first.index, last.index);
+    } else {
+      TrimLeaf(left, first.index, left->count_);
+      if (right != nullptr) {
+        TrimLeaf(right, 0, last.index);
+      }
+      DestroyLeavesBetween(left, last.leaf);
+    }
+    size_ -= count;
+    CutPaths paths{};
+    CutInnerLevels(left, right, paths);
+    RepairPaths(paths);
+    return Select(offset);
+  }
+
+  /* Same results as RedBlackTree::Combine. Small inputs are applied one
+   * element at a time in O(m log n), otherwise both trees are merged in one
+   * O(n + m) pass into freshly filled leaves. That pass runs on the calling
+   * thread, thread_count is accepted for the same interface and ignored */
+  void Combine(BTree &&other, SetOperation operation, bool unique,
+               std::size_t thread_count = 1) {
+    static_cast<void>(thread_count);
+    if (this == &other) {
+      if (operation == SetOperation::kDifference ||
+          operation == SetOperation::kSymmetricDifference) {
+        Clear();
+      }
+      return;
+    }
+    if (unique && operation != SetOperation::kIntersection &&
+        PrefersPointwise(other.GetSize())) {
+      CombinePointwise(other, operation);
+      return;
+    }
+    bool keep_first = operation != SetOperation::kIntersection;
+    bool keep_second = operation == SetOperation::kUnion ||
+                       operation == SetOperation::kSymmetricDifference;
+    bool keep_common = operation == SetOperation::kUnion ||
+                       operation == SetOperation::kIntersection;
+    BTree result(GetCompare());
+    mutable_iterator first(begin().base());
+    mutable_iterator second(other.begin().base());
+    const_iterator first_end = end();
+    const_iterator second_end = other.end();
+    while (first != first_end && second != second_end) {
+      if (Less(KeyOfValue{}(*first), KeyOfValue{}(*second))) {
+        if (keep_first) {
+          result.AppendSorted(std::move(*first));
+        }
+        ++first;
+      } else if (Less(KeyOfValue{}(*second), KeyOfValue{}(*first))) {
+        if (keep_second) {
+          result.AppendSorted(std::move(*second));
+        }
+        ++second;
+      } else {
+        if (keep_common) {
+          result.AppendSorted(std::move(*first));
+        }
+        ++first;
+        ++second;
+      }
+    }
+    for (; keep_first && first != first_end; ++first) {
+      result.AppendSorted(std::move(*first));
+    }
+    for (; keep_second && second != second_end; ++second) {
+      result.AppendSorted(std::move(*second));
+    }
+    result.FinishSorted();
+    *this = std::move(result);
+    other.Clear();
+  }
+
+  /* Moves the elements of other into this tree. With unique set elements
+   * whose key is already present, or repeated in other, stay in other.
+   * Bounds and threading as for Combine: O(m log n) for small inputs,
+   * otherwise one O(n + m) pass on the calling thread */
+  void Merge(BTree &other, bool unique, std::size_t thread_count = 1,
+             bool other_unique = true) {
+    static_cast<void>(thread_count);
+    static_cast<void>(other_unique);
+    if (this == &other) {
+      return;
+    }
+    if (PrefersPointwise(other.GetSize())) {
+      MergePointwise(other, unique);
+      return;
+    }
+    BTree merged(GetCompare());
+    BTree leftover(other.GetCompare());
+    mutable_iterator first(begin().base());
+    mutable_iterator second(other.begin().base());
+    const_iterator first_end = end();
+    const_iterator second_end = other.end();
+    while (first != first_end || second != second_end) {
+      if (second == second_end ||
+          (first != first_end &&
+           !Less(KeyOfValue{}(*second), KeyOfValue{}(*first)))) {
+        merged.AppendSorted(std::move(*first++));
+      } else if (unique && !merged.IsEmpty() &&
+                 !Less(merged.GetLastKey(), KeyOfValue{}(*second))) {
+        leftover.AppendSorted(std::move(*second++));
+      } else {
+        merged.AppendSorted(std::move(*second++));
+      }
+    }
+    merged.FinishSorted();
+    leftover.FinishSorted();
+    *this = std::move(merged);
+    other = std::move(leftover);
+  }
+
+ public:
+  /* Checks leaf depths and fill, key order against the separators, parent
+   * links, subtree sizes and the leaf ring. Only the rightmost node of a
+   * level may be under-filled, appends in key order leave it so */
+  [[nodiscard]] bool IsValid() const {
+    if (root_ == nullptr) {
+      return size_ == 0 && height_ == 0 && sentinel_.next_ == &sentinel_ &&
+             sentinel_.prev_ == &sentinel_;
+    }
+    const LeafLinks *expected = sentinel_.next_;
+    size_type size = 0;
+    return root_->parent_ == nullptr &&
+           ValidateNode(root_, height_, nullptr, nullptr, true, expected,
+                        size) &&
+           expected == &sentinel_ && size == size_;
+  }
+
+ public:
+  /* Both return the end position when nothing is found */
+  [[nodiscard]] Position Search(const T &data) const {
+    return SearchByKey(KeyOfValue{}(data));
+  }
+
+  template <typename K>
+  [[nodiscard]] Position SearchByKey(const K &key) const {
+    Position position = LowerBound(key);
+    if (position.leaf == Sentinel() ||
+        Less(key, KeyOfValue{}(ValueAt(position)))) {
+      return GetNil();
+    }
+    return position;
+  }
+
+  /* First element with key not less than the given one */
+  template <typename K>
+  [[nodiscard]] Position LowerBound(const K &key) const {
+    if (root_ == nullptr) {
+      return GetNil();
+    }
+    auto [leaf, index] = Descend<false>(key);
+    return Normalize(leaf, index);
+  }
+
+  /* First element with key greater than the given one */
+  template <typename K>
+  [[nodiscard]] Position UpperBound(const K &key) const {
+    if (root_ == nullptr) {
+      return GetNil();
+    }
+    auto [leaf, index] = Descend<true>(key);
+    return Normalize(leaf, index);
+  }
+
+  template <typename K>
+  [[nodiscard]] std::pair<Position, Position> EqualRange(const K &key) const {
+    return {LowerBound(key), UpperBound(key)};
+  }
+
+  template <typename K>
+  [[nodiscard]] size_type CountKey(const K &key) const {
+    return GetUpperRank(key) - GetRank(key);
+  }
+
+ public: /* Order statistics, inner nodes keep the size of every child */
+  /* Number of elements with key less than the given one */
+  template <typename K>
+  [[nodiscard]] size_type GetRank(const K &key) const {
+    return CountBelow<false>(key);
+  }
+
+  /* Number of elements with key less than or equal to the given one */
+  template <typename K>
+  [[nodiscard]] size_type GetUpperRank(const K &key) const {
+    return CountBelow<true>(key);
+  }
+
+  /* Position of the element in sorted order, GetSize() for the end */
+  [[nodiscard]] size_type GetNodeRank(Position position) const {
+    if (position.leaf == Sentinel()) {
+      return size_;
+    }
+    size_type rank = position.index;
+    const NodeBase *node = position.leaf;
+    for (const Inner *parent = node->parent_; parent != nullptr;
+         node = parent, parent = parent->parent_) {
+      for (size_type i = 0; parent->children_[i] != node; ++i) {
+        rank += parent->sizes_[i];
+      }
+    }
+    return rank;
+  }
+
+  /* Zero-based k-th smallest element, the end when k is out of range */
+  [[nodiscard]] Position Select(size_type k) const {
+    if (k >= size_) {
+      return GetNil();
+    }
+    NodeBase *node = root_;
+    for (size_type level = height_; level > 1; --level) {
+      const Inner *inner = static_cast<const Inner *>(node);
+      size_type child = 0;
+      while (k >= inner->sizes_[child]) {
+        k -= inner->sizes_[child++];
+      }
+      node = inner->children_[child];
+    }
+    return {ToLeaf(node), k};
+  }
+
+  /* Moves the position n elements in O(log n), clamps to begin and end */
+  [[nodiscard]] Position Advance(Position position, difference_type n) const {
+    auto rank = static_cast<difference_type>(GetNodeRank(position)) + n;
+    if (rank < 0) {
+      rank = 0;
+    }
+    return Select(static_cast<size_type>(rank));
+  }
+
+  /* Number of elements with key in [low, high) */
+  [[nodiscard]] size_type CountRange(const key_type &low,
+                                     const key_type &high) const {
+    if (!Less(low, high)) {
+      return 0;
+    }
+    return GetRank(high) - GetRank(low);
+  }
+
+ public: /* Range scans */
+  /* First and past-the-last element with key in [low, high) */
+  template <typename K>
+  [[nodiscard]] std::pair<Position, Position> RangeBounds(
+      const K &low, const K &high) const {
+    Position first = LowerBound(low);
+    if (!Less(low, high)) {
+      return {first, first};
+    }
+    return {first, LowerBound(high)};
+  }
+
+  /* Calls function on every element with key in [low, high) in order, a
+   * leaf at a time. The next leaf is prefetched before the current one is
+   * visited */
+  template <typename K, typename Function>
+  void ForEachRange(const K &low, const K &high, Function &&function) const {
+    auto [first, last] = RangeBounds(low, high);
+    LeafLinks *leaf = first.leaf;
+    size_type index = first.index;
+    for (; leaf != last.leaf; leaf = leaf->next_, index = 0) {
+      PrefetchLeaf(leaf->next_);
+      for (; index < leaf->count_; ++index) {
+        function(ToLeaf(leaf)->values_[index]);
+      }
+    }
+    for (; index < last.index; ++index) {
+      function(ToLeaf(leaf)->values_[index]);
+    }
+  }
+
+  /* A hint to pull a whole leaf into cache, it is never dereferenced */
+  static void PrefetchLeaf(const LeafLinks *leaf) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    const char *bytes = reinterpret_cast<const char *>(leaf);
+    for (size_type offset = 0; offset < sizeof(Leaf); offset += 64) {
+      __builtin_prefetch(bytes + offset);
+    }
+#else
+    static_cast<void>(leaf);
+#endif
+  }
+
+ public:
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return const_iterator(Position{sentinel_.next_, 0});
+  }
+
+  [[nodiscard]] const_iterator end() const noexcept {
+    return const_iterator(GetNil());
+  }
+
+ private:
+  /* Where an element with a key goes, a leaf and the index it is inserted
+   * at, or the element already holding the key */
+  struct InsertPosition {
+    Leaf *leaf{};
+    size_type index{};
+    Position existing{};
+    bool found{};
+  };
+
+  /* Nodes a split may need, allocated before the tree is touched */
+  struct SplitNodes {
+    Leaf *leaf{};
+    Inner *inners[std::numeric_limits<size_type>::digits]{};
+    size_type inner_count{};
+  };
+
+  /* The nodes next to an erased range, level by level from the leaves up.
+   * Above the level where the two paths meet both entries are the same
+   * node, right is nullptr when the range ran to the end */
+  struct CutPaths {
+    NodeBase *left[std::numeric_limits<size_type>::digits]{};
+    NodeBase *right[std::numeric_limits<size_type>::digits]{};
+    size_type levels{};
+  };
+
+  /* A finished subtree while the levels above it are being built */
+  struct BuildEntry {
+    NodeBase *node;
+    size_type size;
+    const Leaf *first;
+  };
+
+  NodeBase *root_{};
+  size_type height_{};
+  size_type size_{};
+  LeafLinks sentinel_{};
+
+ private:
+  [[nodiscard]] LeafLinks *Sentinel() const {
+    return const_cast<LeafLinks *>(&sentinel_);
+  }
+
+  static Leaf *ToLeaf(NodeBase *node) noexcept {
+    return static_cast<Leaf *>(node);
+  }
+
+  static const Leaf *ToLeaf(const NodeBase *node) noexcept {
+    return static_cast<const Leaf *>(node);
+  }
+
+  static T &ValueAt(Position position) noexcept {
+    return ToLeaf(position.leaf)->values_[position.index];
+  }
+
+  [[nodiscard]] const key_type &GetLastKey() const {
+    const LeafLinks *last = sentinel_.prev_;
+    return KeyOfValue{}(ToLeaf(last)->values_[last->count_ - 1]);
+  }
+
+  void ResetToEmpty() noexcept {
+    root_ = nullptr;
+    height_ = 0;
+    size_ = 0;
+    sentinel_.prev_ = sentinel_.next_ = &sentinel_;
+  }
+
+  void TakeOver(BTree &other) noexcept {
+    if (other.root_ == nullptr && other.sentinel_.next_ == &other.sentinel_) {
+      ResetToEmpty();
+      return;
+    }
+    root_ = other.root_;
+    height_ = other.height_;
+    size_ = other.size_;
+    sentinel_.next_ = other.sentinel_.next_;
+    sentinel_.prev_ = other.sentinel_.prev_;
+    sentinel_.next_->prev_ = &sentinel_;
+    sentinel_.prev_->next_ = &sentinel_;
+    other.ResetToEmpty();
+  }
+
+  template <typename ForwardIt>
+  [[nodiscard]] bool IsSortedRange(ForwardIt first, ForwardIt last) const {
+    if (first == last) {
+      return true;
+    }
+    for (ForwardIt next = std::next(first); next != last; first = next++) {
+      if (Less(KeyOfValue{}(*next), KeyOfValue{}(*first))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  [[nodiscard]] bool PrefersPointwise(size_type other_size) const {
+    return other_size != 0 && other_size <= GetSize() / other_size;
+  }
+
+  void CombinePointwise(BTree &other, SetOperation operation) {
+    for (mutable_iterator iter(other.begin().base()); iter != other.end();
+         ++iter) {
+      Position existing = SearchByKey(KeyOfValue{}(*iter));
+      if (existing != GetNil()) {
+        if (operation != SetOperation::kUnion) {
+          EraseAt(ToLeaf(existing.leaf), existing.index);
+        }
+      } else if (operation != SetOperation::kDifference) {
+        Insert(std::move(*iter));
+      }
+    }
+    other.Clear();
+  }
+
+  void MergePointwise(BTree &other, bool unique) {
+    BTree leftover(other.GetCompare());
+    for (mutable_iterator iter(other.begin().base()); iter != other.end();
+         ++iter) {
+      if (unique) {
+        InsertPosition position =
+            FindInsertPosition(KeyOfValue{}(*iter), true);
+        if (position.found) {
+          leftover.AppendSorted(std::move(*iter));
+        } else {
+          EmplaceAt(position.leaf, position.index, std::move(*iter));
+        }
+      } else {
+        Insert(std::move(*iter));
+      }
+    }
+    leftover.FinishSorted();
+    other = std::move(leftover);
+  }
+
+ private: /* Search */
+  /* Index of the first of count keys not less than key, or greater than
+   * key with Upper */
+  template <bool Upper, typename K>
+  [[nodiscard]] size_type SearchKeys(const key_type *keys, size_type count,
+                                     const K &key) const {
+    if constexpr (kSimdKeys && std::is_same_v<K, key_type>) {
+      return CountKeysBelow<Upper>(keys, count, key);
+    } else {
+      return SearchValues<Upper, IdentityKey<key_type>>(keys, count, key);
+    }
+  }
+
+  template <bool Upper, typename GetKey, typename Value, typename K>
+  [[nodiscard]] size_type SearchValues(const Value *values, size_type count,
+                                       const K &key) const {
+    size_type first = 0;
+    while (count > 0) {
+      size_type half = count / 2;
+      const auto &middle = GetKey{}(values[first + half]);
+      if (Upper ? !Less(key, middle) : Less(middle, key)) {
+        first += half + 1;
+        count -= half + 1;
+      } else {
+        count = half;
+      }
+    }
+    return first;
+  }
+
+  template <bool Upper, typename K>
+  [[nodiscard]] size_type SearchLeaf(const Leaf *leaf, const K &key) const {
+    if constexpr (kShadowKeys) {
+      return SearchKeys<Upper>(leaf->keys_, leaf->count_, key);
+    } else if constexpr (std::is_same_v<T, key_type>) {
+      return SearchKeys<Upper>(leaf->values_, leaf->count_, key);
+    } else {
+      return SearchValues<Upper, KeyOfValue>(leaf->values_, leaf->count_, key);
+    }
+  }
+
+  /* Child i of an inner node holds the keys between separators i - 1 and
+   * i, equal keys may sit on both sides of a separator */
+  template <bool Upper, typename K>
+  [[nodiscard]] std::pair<Leaf *, size_type> Descend(const K &key) const {
+    NodeBase *node = root_;
+    for (size_type level = height_; level > 1; --level) {
+      const Inner *inner = static_cast<const Inner *>(node);
+      node = inner->children_[SearchKeys<Upper>(inner->keys_, inner->count_,
+                                                key)];
+    }
+    Leaf *leaf = ToLeaf(node);
+    return {leaf, SearchLeaf<Upper>(leaf, key)};
+  }
+
+  template <bool Upper, typename K>
+  [[nodiscard]] size_type CountBelow(const K &key) const {
+    if (root_ == nullptr) {
+      return 0;
+    }
+    size_type rank = 0;
+    NodeBase *node = root_;
+    for (size_type level = height_; level > 1; --level) {
+      const Inner *inner = static_cast<const Inner *>(node);
+      size_type child = SearchKeys<Upper>(inner->keys_, inner->count_, key);
+      for (size_type i = 0; i < child; ++i) {
+        rank += inner->sizes_[i];
+      }
+      node = inner->children_[child];
+    }
+    return rank + SearchLeaf<Upper>(ToLeaf(node), key);
+  }
+
+  [[nodiscard]] static Position Normalize(Leaf *leaf, size_type index) {
+    if (index == leaf->count_) {
+      return {leaf->next_, 0};
+    }
+    return {leaf, index};
+  }
+
+  template <typename K>
+  [[nodiscard]] InsertPosition FindInsertPosition(const K &key,
+                                                  bool unique) const {
+    if (root_ == nullptr) {
+      return {};
+    }
+    if (!unique) {
+      auto [leaf, index] = Descend<true>(key);
+      return {leaf, index, {}, false};
+    }
+    auto [leaf, index] = Descend<false>(key);
+    Position bound = Normalize(leaf, index);
+    if (bound.leaf != Sentinel() && !Less(key, KeyOfValue{}(ValueAt(bound)))) {
+      return {nullptr, 0, bound, true};
+    }
+    return {leaf, index, {}, false};
+  }
+
+  /* The key goes right before hint when it is not less than the element
+   * before hint and not greater than hint. Inside a leaf or at either end
+   * of the tree that needs no descent, hints at the first element of an
+   * inner leaf fall back to one */
+  template <typename K>
+  [[nodiscard]] InsertPosition FindHintedPosition(Position hint, const K &key,
+                                                  bool unique) const {
+    if (root_ == nullptr) {
+      return {};
+    }
+    bool at_end = hint.leaf == Sentinel();
+    bool at_begin = hint.leaf == sentinel_.next_ && hint.index == 0;
+    if (!at_end && !at_begin && hint.index == 0) {
+      return FindInsertPosition(key, unique);
+    }
+    if (!at_end) {
+      const key_type &next = KeyOfValue{}(ValueAt(hint));
+      if (Less(next, key)) {
+        return FindInsertPosition(key, unique);
+      }
+      if (unique && !Less(key, next)) {
+        return {nullptr, 0, hint, true};
+      }
+    }
+    if (!at_begin) {
+      Position previous = (--const_iterator(hint)).base();
+      const key_type &before = KeyOfValue{}(ValueAt(previous));
+      if (Less(key, before)) {
+        return FindInsertPosition(key, unique);
+      }
+      if (unique && !Less(before, key)) {
+        return {nullptr, 0, previous, true};
+      }
+    }
+    if (at_end) {
+      return {ToLeaf(sentinel_.prev_), sentinel_.prev_->count_, {}, false};
+    }
+    return {ToLeaf(hint.leaf), hint.index, {}, false};
+  }
+
+  template <typename Value>
+  std::pair<Position, bool> InsertValue(Position hint, Value &&data,
+                                        bool unique, bool hinted) {
+    InsertPosition position =
+        hinted ? FindHintedPosition(hint, KeyOfValue{}(data), unique)
+               : FindInsertPosition(KeyOfValue{}(data), unique);
+    if (position.found) {
+      return {position.existing, false};
+    }
+    return {EmplaceAt(position.leaf, position.index, std::forward<Value>(data)),
+            true};
+  }
+
+ private: /* Element slots */
+  template <typename... Args>
+  static void ConstructValue(Leaf *leaf, size_type index, Args &&...args) {
+    new (&leaf->values_[index]) T(std::forward<Args>(args)...);
+    if constexpr (kShadowKeys) {
+      leaf->keys_[index] = KeyOfValue{}(leaf->values_[index]);
+    }
+  }
+
+  /* Relocates count objects into unconstructed slots, the ranges may
+   * overlap inside one node */
+  template <typename U>
+  static void MoveObjects(U *from, U *to, size_type count) noexcept {
+    if constexpr (std::is_trivially_copyable_v<U>) {
+      if (count != 0) {
+        std::memmove(static_cast<void *>(to), from, count * sizeof(U));
+      }
+    } else if (to < from) {
+      for (size_type i = 0; i < count; ++i) {
+        new (&to[i]) U(std::move(from[i]));
+        std::destroy_at(&from[i]);
+      }
+    } else {
+      for (size_type i = count; i-- > 0;) {
+        new (&to[i]) U(std::move(from[i]));
+        std::destroy_at(&from[i]);
+      }
+    }
+  }
+
+  static void MoveValues(Leaf *from, size_type from_index, Leaf *to,
+                         size_type to_index, size_type count) noexcept {
+    MoveObjects(from->values_ + from_index, to->values_ + to_index, count);
+    if constexpr (kShadowKeys) {
+      MoveObjects(from->keys_ + from_index, to->keys_ + to_index, count);
+    }
+  }
+
+  static void MoveKeys(Inner *from, size_type from_index, Inner *to,
+                       size_type to_index, size_type count) noexcept {
+    MoveObjects(from->keys_ + from_index, to->keys_ + to_index, count);
+  }
+
+  static void MoveChildren(Inner *from, size_type from_index, Inner *to,
+                           size_type to_index, size_type count) noexcept {
+    MoveObjects(from->children_ + from_index, to->children_ + to_index, count);
+    MoveObjects(from->sizes_ + from_index, to->sizes_ + to_index, count);
+    if (from != to) {
+      for (size_type i = 0; i < count; ++i) {
+        to->children_[to_index + i]->parent_ = to;
+      }
+    }
+  }
+
+  /* Opens an unconstructed slot at index */
+  static void InsertSlot(Leaf *leaf, size_type index) noexcept {
+    MoveValues(leaf, index, leaf, index + 1, leaf->count_ - index);
+    ++leaf->count_;
+  }
+
+  /* Closes the unconstructed slot at index */
+  static void RemoveSlot(Leaf *leaf, size_type index) noexcept {
+    MoveValues(leaf, index + 1, leaf, index, leaf->count_ - index - 1);
+    --leaf->count_;
+  }
+
+  static size_type ChildIndex(const Inner *parent,
+                              const NodeBase *child) noexcept {
+    size_type index = 0;
+    while (parent->children_[index] != child) {
+      ++index;
+    }
+    return index;
+  }
+
+  static size_type SumSizes(const Inner *inner) noexcept {
+    size_type size = 0;
+    for (size_type i = 0; i <= inner->count_; ++i) {
+      size += inner->sizes_[i];
+    }
+    return size;
+  }
+
+  static void AdjustAncestors(NodeBase *node, bool grow) noexcept {
+    for (Inner *parent = node->parent_; parent != nullptr;
+         node = parent, parent = parent->parent_) {
+      size_type &size = parent->sizes_[ChildIndex(parent, node)];
+      size = grow ? size + 1 : size - 1;
+    }
+  }
+
+  static void LinkLeafAfter(LeafLinks *position, LeafLinks *leaf) noexcept {
+    leaf->prev_ = position;
+    leaf->next_ = position->next_;
+    position->next_->prev_ = leaf;
+    position->next_ = leaf;
+  }
+
+  static void UnlinkLeaf(LeafLinks *leaf) noexcept {
+    leaf->prev_->next_ = leaf->next_;
+    leaf->next_->prev_ = leaf->prev_;
+  }
+
+  static void DestroyLeaf(Leaf *leaf) noexcept {
+    std::destroy_n(leaf->values_, leaf->count_);
+    delete leaf;
+  }
+
+  static void DestroyInner(Inner *inner) noexcept {
+    std::destroy_n(inner->keys_, inner->count_);
+    delete inner;
+  }
+
+  /* Inner nodes of the subtree only, the leaves go with the ring */
+  static void DestroyInnerLevels(Inner *inner, size_type height) noexcept {
+    if (height > 2) {
+      for (size_type i = 0; i <= inner->count_; ++i) {
+        DestroyInnerLevels(static_cast<Inner *>(inner->children_[i]),
+                           height - 1);
+      }
+    }
+    DestroyInner(inner);
+  }
+
+ private: /* Insertion */
+  template <typename... Args>
+  Position EmplaceAt(Leaf *leaf, size_type index, Args &&...args) {
+    if (leaf == nullptr) {
+      return EmplaceIntoEmpty(std::forward<Args>(args)...);
+    }
+    SplitNodes nodes{};
+    if (leaf->count_ == kLeafSlots) {
+      ReserveSplit(leaf, nodes);
+    }
+    InsertSlot(leaf, index);
+    try {
+      ConstructValue(leaf, index, std::forward<Args>(args)...);
+    } catch (...) {
+      RemoveSlot(leaf, index);
+      ReleaseSplit(nodes);
+      throw;
+    }
+    if (leaf->count_ <= kLeafSlots) {
+      ++size_;
+      AdjustAncestors(leaf, true);
+      return {leaf, index};
+    }
+    return SplitLeaf(leaf, index, nodes);
+  }
+
+  template <typename... Args>
+  Position EmplaceIntoEmpty(Args &&...args) {
+    Leaf *leaf = new Leaf();
+    try {
+      ConstructValue(leaf, 0, std::forward<Args>(args)...);
+    } catch (...) {
+      delete leaf;
+      throw;
+    }
+    leaf->count_ = 1;
+    LinkLeafAfter(&sentinel_, leaf);
+    root_ = leaf;
+    height_ = 1;
+    size_ = 1;
+    return {leaf, 0};
+  }
+
+  /* One leaf, one inner node per full ancestor and a new root when all of
+   * them are full */
+  void ReserveSplit(const Leaf *leaf, SplitNodes &nodes) {
+    size_type needed = 0;
+    for (const NodeBase *node = leaf;; node = node->parent_) {
+      if (node->parent_ == nullptr) {
+        ++needed;
+        break;
+      }
+      if (node->parent_->count_ < kInnerKeys) {
+        break;
+      }
+      ++needed;
+    }
+    try {
+      nodes.leaf = new Leaf();
+      for (; nodes.inner_count < needed; ++nodes.inner_count) {
+        nodes.inners[nodes.inner_count] = new Inner();
+      }
+    } catch (...) {
+      ReleaseSplit(nodes);
+      throw;
+    }
+  }
+
+  static void ReleaseSplit(SplitNodes &nodes) noexcept {
+    delete nodes.leaf;
+    for (size_type i = 0; i < nodes.inner_count; ++i) {
+      delete nodes.inners[i];
+    }
+  }
+
+  /* The separator is the one copy a split makes, it is taken while the new
+   * element can still be backed out */
+  key_type CopySeparator(Leaf *leaf, size_type keep, size_type index,
+                         SplitNodes &nodes) {
+    try {
+      return KeyOfValue{}(leaf->values_[keep]);
+    } catch (...) {
+      std::destroy_at(&leaf->values_[index]);
+      RemoveSlot(leaf, index);
+      ReleaseSplit(nodes);
+      throw;
+    }
+  }
+
+  /* Appending past the last element leaves the old leaf full, so keys
+   * inserted in order fill every leaf */
+  Position SplitLeaf(Leaf *leaf, size_type index, SplitNodes &nodes) {
+    bool append = index == kLeafSlots && leaf->next_ == &sentinel_;
+    size_type keep = append ? kLeafSlots : (kLeafSlots + 1) / 2;
+    key_type separator = CopySeparator(leaf, keep, index, nodes);
+    ++size_;
+    AdjustAncestors(leaf, true);
+    Leaf *right = nodes.leaf;
+    MoveValues(leaf, keep, right, 0, leaf->count_ - keep);
+    right->count_ = leaf->count_ - keep;
+    leaf->count_ = keep;
+    LinkLeafAfter(leaf, right);
+    InsertChild(leaf, std::move(separator), right, keep, right->count_,
+                append, nodes);
+    return index < keep ? Position{leaf, index} : Position{right, index - keep};
+  }
+
+  /* Links right after left under the parent of left, whose entry for left
+   * still counts both */
+  void InsertChild(NodeBase *left, key_type &&separator, NodeBase *right,
+                   size_type left_size, size_type right_size, bool append,
+                   SplitNodes &nodes) {
+    Inner *parent = left->parent_;
+    if (parent == nullptr) {
+      Inner *root = nodes.inners[--nodes.inner_count];
+      new (&root->keys_[0]) key_type(std::move(separator));
+      root->count_ = 1;
+      root->children_[0] = left;
+      root->children_[1] = right;
+      root->sizes_[0] = left_size;
+      root->sizes_[1] = right_size;
+      left->parent_ = right->parent_ = root;
+      root_ = root;
+      ++height_;
+      return;
+    }
+    size_type slot = ChildIndex(parent, left);
+    parent->sizes_[slot] = left_size;
+    MoveKeys(parent, slot, parent, slot + 1, parent->count_ - slot);
+    new (&parent->keys_[slot]) key_type(std::move(separator));
+    MoveChildren(parent, slot + 1, parent, slot + 2, parent->count_ - slot);
+    parent->children_[slot + 1] = right;
+    parent->sizes_[slot + 1] = right_size;
+    right->parent_ = parent;
+    if (++parent->count_ > kInnerKeys) {
+      SplitInner(parent, append, nodes);
+    }
+  }
+
+  void SplitInner(Inner *inner, bool append, SplitNodes &nodes) {
+    size_type keep = append ? kInnerKeys - 1 : kInnerKeys / 2;
+    size_type moved = inner->count_ - keep - 1;
+    Inner *right = nodes.inners[--nodes.inner_count];
+    MoveKeys(inner, keep + 1, right, 0, moved);
+    MoveChildren(inner, keep + 1, right, 0, moved + 1);
+    right->count_ = moved;
+    key_type separator(std::move(inner->keys_[keep]));
+    std::destroy_at(&inner->keys_[keep]);
+    inner->count_ = keep;
+    InsertChild(inner, std::move(separator), right, SumSizes(inner),
+                SumSizes(right), append, nodes);
+  }
+
+ private: /* Erasure */
+  void EraseAt(Leaf *leaf, size_type index) {
+    std::destroy_at(&leaf->values_[index]);
+    RemoveSlot(leaf, index);
+    --size_;
+    AdjustAncestors(leaf, false);
+    if (leaf->parent_ == nullptr) {
+      if (leaf->count_ == 0) {
+        UnlinkLeaf(leaf);
+        delete leaf;
+        ResetToEmpty();
+      }
+    } else if (leaf->count_ < kMinLeaf) {
+      RebalanceLeaf(leaf);
+    }
+  }
+
+  /* Refills the leaf from a sibling with elements to spare, otherwise
+   * merges the two. The leaf may be short by any number of elements, a
+   * sibling that cannot cover all of them is merged with */
+  void RebalanceLeaf(Leaf *leaf) {
+    Inner *parent = leaf->parent_;
+    size_type slot = ChildIndex(parent, leaf);
+    size_type need = kMinLeaf - leaf->count_;
+    Leaf *left = slot > 0 ? ToLeaf(parent->children_[slot - 1]) : nullptr;
+    Leaf *right =
+        slot < parent->count_ ? ToLeaf(parent->children_[slot + 1]) : nullptr;
+    if (left != nullptr && left->count_ >= kMinLeaf + need) {
+      size_type from = left->count_ - need;
+      key_type separator(KeyOfValue{}(left->values_[from]));
+      MoveValues(leaf, 0, leaf, need, leaf->count_);
+      MoveValues(left, from, leaf, 0, need);
+      left->count_ = from;
+      leaf->count_ += need;
+      parent->keys_[slot - 1] = std::move(separator);
+      parent->sizes_[slot - 1] -= need;
+      parent->sizes_[slot] += need;
+    } else if (right != nullptr && right->count_ >= kMinLeaf + need) {
+      key_type separator(KeyOfValue{}(right->values_[need]));
+      MoveValues(right, 0, leaf, leaf->count_, need);
+      leaf->count_ += need;
+      MoveValues(right, need, right, 0, right->count_ - need);
+      right->count_ -= need;
+      parent->keys_[slot] = std::move(separator);
+      parent->sizes_[slot] += need;
+      parent->sizes_[slot + 1] -= need;
+    } else if (left != nullptr) {
+      MergeLeaves(left, leaf, slot - 1);
+    } else {
+      MergeLeaves(leaf, right, slot);
+    }
+  }
+
+  void MergeLeaves(Leaf *left, Leaf *right, size_type slot) {
+    MoveValues(right, 0, left, left->count_, right->count_);
+    left->count_ += right->count_;
+    right->count_ = 0;
+    UnlinkLeaf(right);
+    delete right;
+    RemoveChild(left->parent_, slot);
+  }
+
+  /* Drops separator slot and the child after it, whose elements now live in
+   * the child before it */
+  void RemoveChild(Inner *parent, size_type slot) {
+    parent->sizes_[slot] += parent->sizes_[slot + 1];
+    std::destroy_at(&parent->keys_[slot]);
+    MoveKeys(parent, slot + 1, parent, slot, parent->count_ - slot - 1);
+    MoveChildren(parent, slot + 2, parent, slot + 1, parent->count_ - slot - 1);
+    --parent->count_;
+    if (parent->parent_ == nullptr) {
+      if (parent->count_ == 0) {
+        DropRoot();
+      }
+    } else if (parent->count_ < kMinInner) {
+      RebalanceInner(parent);
+    }
+  }
+
+  /* Replaces an inner root left with a single child by that child */
+  void DropRoot() noexcept {
+    Inner *root = static_cast<Inner *>(root_);
+    root_ = root->children_[0];
+    root_->parent_ = nullptr;
+    delete root;
+    --height_;
+  }
+
+  /* Rotates children over from a sibling through the separator between
+   * them, otherwise merges the two around that separator. Like
+   * RebalanceLeaf it makes up any shortfall in one step */
+  void RebalanceInner(Inner *inner) {
+    Inner *parent = inner->parent_;
+    size_type slot = ChildIndex(parent, inner);
+    size_type need = kMinInner - inner->count_;
+    Inner *left = slot > 0 ? static_cast<Inner *>(parent->children_[slot - 1])
+                           : nullptr;
+    Inner *right = slot < parent->count_
+                       ? static_cast<Inner *>(parent->children_[slot + 1])
+                       : nullptr;
+    if (left != nullptr && left->count_ >= kMinInner + need) {
+      size_type from = left->count_ - need;
+      MoveKeys(inner, 0, inner, need, inner->count_);
+      MoveKeys(parent, slot - 1, inner, need - 1, 1);
+      MoveKeys(left, from + 1, inner, 0, need - 1);
+      MoveKeys(left, from, parent, slot - 1, 1);
+      MoveChildren(inner, 0, inner, need, inner->count_ + 1);
+      MoveChildren(left, from + 1, inner, 0, need);
+      left->count_ = from;
+      inner->count_ += need;
+      size_type moved = 0;
+      for (size_type i = 0; i < need; ++i) {
+        moved += inner->sizes_[i];
+      }
+      parent->sizes_[slot - 1] -= moved;
+      parent->sizes_[slot] += moved;
+    } else if (right != nullptr && right->count_ >= kMinInner + need) {
+      size_type end = inner->count_ + 1;
+      MoveKeys(parent, slot, inner, inner->count_, 1);
+      MoveKeys(right, 0, inner, end, need - 1);
+      MoveKeys(right, need - 1, parent, slot, 1);
+      MoveKeys(right, need, right, 0, right->count_ - need);
+      MoveChildren(right, 0, inner, end, need);
+      MoveChildren(right, need, right, 0, right->count_ + 1 - need);
+      inner->count_ += need;
+      right->count_ -= need;
+      size_type moved = 0;
+      for (size_type i = end; i < end + need; ++i) {
+        moved += inner->sizes_[i];
+      }
+      parent->sizes_[slot] += moved;
+      parent->sizes_[slot + 1] -= moved;
+    } else if (left != nullptr) {
+      MergeInner(left, inner, slot - 1);
+    } else {
+      MergeInner(inner, right, slot);
+    }
+  }
+
+  void MergeInner(Inner *left, Inner *right, size_type slot) {
+    Inner *parent = left->parent_;
+    new (&left->keys_[left->count_]) key_type(std::move(parent->keys_[slot]));
+    MoveKeys(right, 0, left, left->count_ + 1, right->count_);
+    MoveChildren(right, 0, left, left->count_ + 1, right->count_ + 1);
+    left->count_ += right->count_ + 1;
+    delete right;
+    RemoveChild(parent, slot);
+  }
+
+ private: /* Range erasure */
+  /* Destroys the elements in [from, to) of the leaf and closes the gap */
+  static void TrimLeaf(Leaf *leaf, size_type from, size_type to) noexcept {
+    if (from == to) {
+      return;
+    }
+    std::destroy(leaf->values_ + from, leaf->values_ + to);
+    MoveValues(leaf, to, leaf, from, leaf->count_ - to);
+    leaf->count_ -= to - from;
+  }
+
+  /* Destroys the leaves strictly between left and last in the ring, their
+   * inner nodes stay for CutInnerLevels */
+  static void DestroyLeavesBetween(LeafLinks *left, LeafLinks *last) noexcept {
+    for (LeafLinks *leaf = left->next_; leaf != last;) {
+      LeafLinks *next = leaf->next_;
+      DestroyLeaf(ToLeaf(leaf));
+      leaf = next;
+    }
+    left->next_ = last;
+    last->prev_ = left;
+  }
+
+  /* Drops children [first, last) of the inner node and the separators
+   * between them and the kept ones. Their leaves are already destroyed,
+   * height is the height of the children */
+  static void DropChildren(Inner *inner, size_type first, size_type last,
+                           size_type height) noexcept {
+    if (first >= last) {
+      return;
+    }
+    if (height > 1) {
+      for (size_type i = first; i < last; ++i) {
+        DestroyInnerLevels(static_cast<Inner *>(inner->children_[i]), height);
+      }
+    }
+    size_type dropped = last - first;
+    size_type key = first > 0 ? first - 1 : 0;
+    std::destroy_n(inner->keys_ + key, dropped);
+    MoveKeys(inner, key + dropped, inner, key, inner->count_ - key - dropped);
+    MoveChildren(inner, last, inner, first, inner->count_ + 1 - last);
+    inner->count_ -= dropped;
+  }
+
+  static size_type SubtreeSize(const NodeBase *node, size_type height) {
+    return height == 1 ? node->count_
+                       : SumSizes(static_cast<const Inner *>(node));
+  }
+
+  /* Climbs from the two boundary leaves to the root. Below the level where
+   * their paths meet the left node loses every child right of the path and
+   * the right node every child left of it, where they meet the children in
+   * between go. The sizes of the path children are recounted on the way */
+  void CutInnerLevels(Leaf *left_leaf, Leaf *right_leaf,
+                      CutPaths &paths) noexcept {
+    NodeBase *left = left_leaf;
+    NodeBase *right = right_leaf;
+    for (size_type height = 1;; ++height) {
+      paths.left[paths.levels] = left;
+      paths.right[paths.levels] = right;
+      ++paths.levels;
+      Inner *parent = left->parent_;
+      if (parent == nullptr) {
+        return;
+      }
+      Inner *right_parent = right == nullptr ? nullptr : right->parent_;
+      if (left != right) {
+        size_type first = ChildIndex(parent, left) + 1;
+        if (right_parent == parent) {
+          DropChildren(parent, first, ChildIndex(parent, right), height);
+        } else {
+          DropChildren(parent, first, parent->count_ + 1, height);
+          if (right_parent != nullptr) {
+            DropChildren(right_parent, 0, ChildIndex(right_parent, right),
+                         height);
+          }
+        }
+        if (right_parent != nullptr) {
+          right_parent->sizes_[ChildIndex(right_parent, right)] =
+              SubtreeSize(right, height);
+        }
+      }
+      parent->sizes_[ChildIndex(parent, left)] = SubtreeSize(left, height);
+      left = parent;
+      right = right_parent;
+    }
+  }
+
+  /* Refills the trimmed nodes top-down, so every node being refilled has a
+   * parent with siblings to draw on. Two path nodes under one parent are
+   * merged first when they fit in one node, otherwise the short one of
+   * them borrows and neither is merged away. A throwing separator copy
+   * leaves a node short, with every element still in place */
+  void RepairPaths(const CutPaths &paths) {
+    for (size_type level = paths.levels; level-- > 0;) {
+      NodeBase *left = paths.left[level];
+      NodeBase *right = paths.right[level] == left ? nullptr
+                                                   : paths.right[level];
+      bool leaves = level == 0;
+      if (right != nullptr && left->parent_ == right->parent_ &&
+          left->count_ + right->count_ + (leaves ? 0 : 1) <=
+              (leaves ? kLeafSlots : kInnerKeys)) {
+        size_type slot = ChildIndex(left->parent_, left);
+        if (leaves) {
+          MergeLeaves(ToLeaf(left), ToLeaf(right), slot);
+        } else {
+          MergeInner(static_cast<Inner *>(left), static_cast<Inner *>(right),
+                     slot);
+        }
+        right = nullptr;
+      }
+      RefillNode(left, leaves);
+      if (right != nullptr) {
+        RefillNode(right, leaves);
+      }
+    }
+  }
+
+  void RefillNode(NodeBase *node, bool leaf) {
+    if (node->parent_ == nullptr) {
+      if (!leaf && node->count_ == 0) {
+        DropRoot();
+      }
+    } else if (leaf && node->count_ < kMinLeaf) {
+      RebalanceLeaf(ToLeaf(node));
+    } else if (!leaf && node->count_ < kMinInner) {
+      RebalanceInner(static_cast<Inner *>(node));
+    }
+  }
+
+ private: /* Bulk building */
+  /* Elements are appended in key order into full leaves, FinishSorted puts
+   * the inner levels on top. Until then the tree owns only its leaves */
+  template <typename... Args>
+  void AppendSorted(Args &&...args) {
+    LeafLinks *last = sentinel_.prev_;
+    if (last == &sentinel_ || last->count_ == kLeafSlots) {
+      Leaf *leaf = new Leaf();
+      LinkLeafAfter(last, leaf);
+      last = leaf;
+    }
+    ConstructValue(ToLeaf(last), last->count_, std::forward<Args>(args)...);
+    ++last->count_;
+    ++size_;
+  }
+
+  template <typename InputIt>
+  void BuildSorted(InputIt first, InputIt last, bool unique) {
+    try {
+      for (; first != last; ++first) {
+        if (!unique || size_ == 0 ||
+            Less(GetLastKey(), KeyOfValue{}(*first))) {
+          AppendSorted(*first);
+        }
+      }
+    } catch (...) {
+      Clear();
+      throw;
+    }
+    FinishSorted();
+  }
+
+  void FinishSorted() {
+    if (size_ == 0) {
+      return;
+    }
+    BalanceLastLeaves();
+    std::vector<Inner *> created{};
+    try {
+      std::vector<BuildEntry> level{};
+      for (LeafLinks *leaf = sentinel_.next_; leaf != &sentinel_;
+           leaf = leaf->next_) {
+        level.push_back({leaf, leaf->count_, ToLeaf(leaf)});
+      }
+      size_type height = 1;
+      for (; level.size() > 1; ++height) {
+        level = BuildInnerLevel(level, created);
+      }
+      root_ = level.front().node;
+      root_->parent_ = nullptr;
+      height_ = height;
+    } catch (...) {
+      for (Inner *inner : created) {
+        DestroyInner(inner);
+      }
+      Clear();
+      throw;
+    }
+  }
+
+  /* Spreads the entries evenly, so every node is at least half full */
+  std::vector<BuildEntry> BuildInnerLevel(
+      const std::vector<BuildEntry> &children, std::vector<Inner *> &created) {
+    size_type groups = (children.size() + kInnerKeys) / (kInnerKeys + 1);
+    std::vector<BuildEntry> parents{};
+    parents.reserve(groups);
+    created.reserve(created.size() + groups);
+    size_type first = 0;
+    for (size_type group = 0; group < groups; ++group) {
+      size_type last = children.size() * (group + 1) / groups;
+      Inner *inner = new Inner();
+      created.push_back(inner);
+      size_type size = 0;
+      for (size_type i = first; i < last; ++i) {
+        if (i != first) {
+          new (&inner->keys_[inner->count_])
+              key_type(KeyOfValue{}(children[i].first->values_[0]));
+          ++inner->count_;
+        }
+        inner->children_[i - first] = children[i].node;
+        inner->sizes_[i - first] = children[i].size;
+        children[i].node->parent_ = inner;
+        size += children[i].size;
+      }
+      parents.push_back({inner, size, children[first].first});
+      first = last;
+    }
+    return parents;
+  }
+
+  /* The last leaf takes half of the one before it when it is short */
+  void BalanceLastLeaves() noexcept {
+    Leaf *last = ToLeaf(sentinel_.prev_);
+    if (last->prev_ == &sentinel_ || last->count_ >= kMinLeaf) {
+      return;
+    }
+    Leaf *before = ToLeaf(last->prev_);
+    size_type moved = (before->count_ + last->count_) / 2 - last->count_;
+    MoveValues(last, 0, last, moved, last->count_);
+    MoveValues(before, before->count_ - moved, last, 0, moved);
+    before->count_ -= moved;
+    last->count_ += moved;
+  }
+
+ private: /* Validation */
+  bool ValidateNode(const NodeBase *node, size_type height,
+                    const key_type *low, const key_type *high, bool rightmost,
+                    const LeafLinks *&expected, size_type &size) const {
+    bool exempt = rightmost || node == root_;
+    if (height == 1) {
+      const Leaf *leaf = static_cast<const Leaf *>(node);
+      if (leaf != expected || leaf->next_->prev_ != leaf ||
+          leaf->count_ == 0 || leaf->count_ > kLeafSlots ||
+          (!exempt && leaf->count_ < kMinLeaf)) {
+        return false;
+      }
+      for (size_type i = 0; i < leaf->count_; ++i) {
+        const key_type &key = KeyOfValue{}(leaf->values_[i]);
+        if ((i > 0 && Less(key, KeyOfValue{}(leaf->values_[i - 1]))) ||
+            (low != nullptr && Less(key, *low)) ||
+            (high != nullptr && Less(*high, key))) {
+          return false;
+        }
+        if constexpr (kShadowKeys) {
+          if (Less(key, leaf->keys_[i]) || Less(leaf->keys_[i], key)) {
+            return false;
+          }
+        }
+      }
+      expected = leaf->next_;
+      size = leaf->count_;
+      return true;
+    }
+    const Inner *inner = static_cast<const Inner *>(node);
+    if (inner->count_ == 0 || inner->count_ > kInnerKeys ||
+        (!exempt && inner->count_ < kMinInner)) {
+      return false;
+    }
+    size = 0;
+    for (size_type i = 0; i <= inner->count_; ++i) {
+      size_type child_size = 0;
+      if (inner->children_[i]->parent_ != inner ||
+          !ValidateNode(inner->children_[i], height - 1,
+                        i == 0 ? low : &inner->keys_[i - 1],
+                        i == inner->count_ ? high : &inner->keys_[i],
+                        rightmost && i == inner->count_, expected,
+                        child_size) ||
+          child_size != inner->sizes_[i]) {
+        return false;
+      }
+      size += child_size;
+    }
+    return true;
+  }
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_B_TREE_B_TREE_H_
@@ -0,0 +1,112 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_B_TREE_B_TREE_SEARCH_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_B_TREE_B_TREE_SEARCH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+namespace s21 {
+/* Keys BTree searches with CountKeysBelow instead of a binary search:
+ * arithmetic keys ordered by plain operator< */
+template <typename Key, typename Compare>
+inline constexpr bool kSimdSearchable =
+    std::is_arithmetic_v<Key> && !std::is_same_v<Key, bool> &&
+    (std::is_same_v<Compare, std::less<Key>> ||
+     std::is_same_v<Compare, std::less<>>);
+
+#if defined(__SSE2__)
+/* Compare masks are all ones per hit, so subtracting them counts hits per
+ * lane and the lanes only have to be added up once at the end */
+inline std::size_t SumLanes32(__m128i hits) noexcept {
+  hits = _mm_add_epi32(hits, _mm_shuffle_epi32(hits, _MM_SHUFFLE(1, 0, 3, 2)));
+  hits = _mm_add_epi32(hits, _mm_shuffle_epi32(hits, _MM_SHUFFLE(2, 3, 0, 1)));
+  return static_cast<std::size_t>(_mm_cvtsi128_si32(hits));
+}
+
+inline std::size_t SumLanes64(__m128i hits) noexcept {
+  alignas(16) std::int64_t lanes[2];
+  _mm_store_si128(reinterpret_cast<__m128i *>(lanes), hits);
+  return static_cast<std::size_t>(lanes[0] + lanes[1]);
+}
+#endif
+
+/* Number of keys less than key, or not greater than key with Inclusive.
+ * On sorted keys that is the lower or the upper bound. Every key is
+ * compared, a few at a time where SIMD is available, so there is no
+ * branch to mispredict and the loads do not depend on each other */
+template <bool Inclusive, typename Key>
+std::size_t CountKeysBelow(const Key *keys, std::size_t count,
+                           Key key) noexcept {
+  std::size_t below = 0;
+  std::size_t i = 0;
+#if defined(__SSE2__)
+  if constexpr (std::is_integral_v<Key> && sizeof(Key) == 4) {
+    /* Unsigned keys are flipped into signed order */
+    const __m128i bias = _mm_set1_epi32(std::is_signed_v<Key> ? 0 : INT32_MIN);
+    const __m128i needle =
+        _mm_xor_si128(_mm_set1_epi32(static_cast<std::int32_t>(key)), bias);
+    __m128i hits = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+      __m128i block = _mm_xor_si128(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)), bias);
+      hits = _mm_sub_epi32(hits, Inclusive ? _mm_cmpgt_epi32(block, needle)
+                                           : _mm_cmplt_epi32(block, needle));
+    }
+    below = Inclusive ? i - SumLanes32(hits) : SumLanes32(hits);
+  }
+  if constexpr (std::is_same_v<Key, float>) {
+    const __m128 needle = _mm_set1_ps(key);
+    __m128i hits = _mm_setzero_si128();
+    for (; i + 4 <= count; i += 4) {
+      __m128 block = _mm_loadu_ps(keys + i);
+      hits = _mm_sub_epi32(
+          hits, _mm_castps_si128(Inclusive ? _mm_cmple_ps(block, needle)
+                                           : _mm_cmplt_ps(block, needle)));
+    }
+    below = SumLanes32(hits);
+  }
+  if constexpr (std::is_same_v<Key, double>) {
+    const __m128d needle = _mm_set1_pd(key);
+    __m128i hits = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2) {
+      __m128d block = _mm_loadu_pd(keys + i);
+      hits = _mm_sub_epi64(
+          hits, _mm_castpd_si128(Inclusive ? _mm_cmple_pd(block, needle)
+                                           : _mm_cmplt_pd(block, needle)));
+    }
+    below = SumLanes64(hits);
+  }
+#endif
+#if defined(__SSE4_2__)
+  if constexpr (std::is_integral_v<Key> && sizeof(Key) == 8) {
+    const __m128i bias =
+        _mm_set1_epi64x(std::is_signed_v<Key> ? 0 : INT64_MIN);
+    const __m128i needle =
+        _mm_xor_si128(_mm_set1_epi64x(static_cast<std::int64_t>(key)), bias);
+    __m128i hits = _mm_setzero_si128();
+    for (; i + 2 <= count; i += 2) {
+      __m128i block = _mm_xor_si128(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)), bias);
+      hits = _mm_sub_epi64(hits, Inclusive ? _mm_cmpgt_epi64(block, needle)
+                                           : _mm_cmpgt_epi64(needle, block));
+    }
+    below = Inclusive ? i - SumLanes64(hits) : SumLanes64(hits);
+  }
+#endif
+  for (; i < count; ++i) {
+    below += static_cast<std::size_t>(Inclusive ? !(key < keys[i])
+                                                : keys[i] < key);
+  }
+  return below;
+}
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_B_TREE_B_TREE_SEARCH_H_
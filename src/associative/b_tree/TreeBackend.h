@@ -0,0 +1,84 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_B_TREE_TREE_BACKEND_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_B_TREE_TREE_BACKEND_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "../red_black_tree/RedBlackTree.h"
+#include "BTree.h"
+
+namespace s21 {
+/* Picks the tree behind map, set and multiset from their NodeAllocator
+ * parameter: BTreeNodes selects a BTree, a node allocator a RedBlackTree
+ * built on it. Only the RedBlackTree keeps aggregates and statistics */
+template <typename NodeAllocator>
+struct TreeBackend {
+  template <typename T, typename KeyOfValue, typename Compare,
+            typename Aggregate, typename Stats>
+  using Tree =
+      RedBlackTree<T, KeyOfValue, Compare, NodeAllocator, Aggregate, Stats>;
+};
+
+template <std::size_t kNodeBytes>
+struct TreeBackend<BTreeNodes<kNodeBytes>> {
+  template <typename T, typename KeyOfValue, typename Compare,
+            typename Aggregate, typename Stats>
+  using Tree = std::enable_if_t<std::is_same_v<Aggregate, NoAggregate> &&
+                                    std::is_same_v<Stats, NoTreeStats>,
+                                BTree<T, KeyOfValue, Compare, kNodeBytes>>;
+};
+
+template <typename T, typename KeyOfValue, typename Compare,
+          typename NodeAllocator, typename Aggregate = NoAggregate,
+          typename Stats = NoTreeStats>
+using TreeFor = typename TreeBackend<NodeAllocator>::template Tree<
+    T, KeyOfValue, Compare, Aggregate, Stats>;
+
+/* Enables extract and insert(node_type &&) of a container, only trees with
+ * a node per element have nodes to hand out */
+template <typename Tree>
+using RequireNodeHandles =
+    std::enable_if_t<!std::is_same_v<typename Tree::node_type, NoNodeHandle>>;
+
+/* Inserts [first, last) given in any order into tree: the batch is sorted
+ * by key once, cut to the first of equal keys with unique, then inserted
+ * in order with InsertAfter, which starts every search from the previous
+ * insert instead of the root. Item is a sortable copy of the tree value,
+ * e.g. without the const of a map key. The keys that were not in tree go
+ * to new_keys in order unless it is nullptr. Returns how many elements
+ * were inserted */
+template <typename Item, typename KeyOfValue, typename Tree, typename InputIt,
+          typename OutputIt>
+std::size_t InsertBatch(Tree &tree, InputIt first, InputIt last, bool unique,
+                        OutputIt new_keys) {
+  std::vector<Item> items(first, last);
+  auto less = [&tree](const Item &a, const Item &b) {
+    return tree.GetCompare()(KeyOfValue{}(a), KeyOfValue{}(b));
+  };
+  std::stable_sort(items.begin(), items.end(), less);
+  if (unique) {
+    items.erase(std::unique(items.begin(), items.end(),
+                            [&less](const Item &a, const Item &b) {
+                              return !less(a, b);
+                            }),
+                items.end());
+  }
+  std::size_t inserted{0};
+  auto finger = tree.GetNil();
+  for (Item &item : items) {
+    auto [position, is_new] = tree.InsertAfter(finger, std::move(item), unique);
+    if (is_new) {
+      ++inserted;
+      if constexpr (!std::is_same_v<OutputIt, std::nullptr_t>) {
+        *new_keys++ = KeyOfValue{}(*typename Tree::const_iterator(position));
+      }
+    }
+    finger = position;
+  }
+  return inserted;
+}
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_B_TREE_TREE_BACKEND_H_
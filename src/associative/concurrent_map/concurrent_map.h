@@ -0,0 +1,319 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_CONCURRENT_MAP_CONCURRENT_MAP_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_CONCURRENT_MAP_CONCURRENT_MAP_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <shared_mutex>
+#include <utility>
+
+#include "../../sequence/vector/vector.h"
+#include "../map/map.h"
+
+namespace s21 {
+/* Map shared between threads. Keys are spread by Hash over shard_count
+ * independent red-black maps, each behind its own reader/writer lock, so
+ * threads touching different shards never wait on each other. Nothing is
+ * handed out by reference: lookups return copies and ordered traversals
+ * merge per-shard snapshots. Each shard is copied atomically, the shards
+ * are not copied at the same instant */
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Hash = std::hash<Key>,
+          typename NodeAllocator = HeapNodeAllocator>
+class concurrent_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using key_compare = Compare;
+  using hasher = Hash;
+  using map_type = map<Key, T, Compare, NodeAllocator>;
+  using snapshot_type = vector<value_type>;
+  using size_type = std::size_t;
+
+  static constexpr size_type kDefaultShardCount = 16;
+
+ public: /* Member */
+  explicit concurrent_map(size_type shard_count = kDefaultShardCount,
+                          const Compare &compare = Compare(),
+                          const Hash &hash = Hash())
+      : shard_count_(shard_count == 0 ? 1 : shard_count),
+        shards_(new Shard[shard_count_]),
+        compare_(compare),
+        hash_(hash) {
+    for (size_type i{0}; i < shard_count_; ++i) {
+      shards_[i].items = map_type(compare);
+    }
+  }
+
+  concurrent_map(std::initializer_list<value_type> const &items)
+      : concurrent_map() {
+    insert_batch(items.begin(), items.end());
+  }
+
+  concurrent_map(const concurrent_map &) = delete;
+
+  concurrent_map &operator=(const concurrent_map &) = delete;
+
+ public: /* Capacity */
+  /* Sums the shards one after another, exact only while no one writes */
+  [[nodiscard]] size_type size() const {
+    size_type total{0};
+    for (size_type i{0}; i < shard_count_; ++i) {
+      std::shared_lock lock(shards_[i].mutex);
+      total += shards_[i].items.size();
+    }
+    return total;
+  }
+
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  [[nodiscard]] size_type shard_count() const { return shard_count_; }
+
+ public: /* Modifiers */
+  void clear() {
+    for (size_type i{0}; i < shard_count_; ++i) {
+      std::unique_lock lock(shards_[i].mutex);
+      shards_[i].items.clear();
+    }
+  }
+
+  /* Returns false and keeps the old value when the key is present */
+  bool insert(const Key &key, const T &data) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock lock(shard.mutex);
+    return shard.items.try_emplace(key, data).second;
+  }
+
+  /* Returns true if the key was new */
+  template <typename M>
+  bool insert_or_assign(const Key &key, M &&data) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock lock(shard.mutex);
+    return shard.items.insert_or_assign(key, std::forward<M>(data)).second;
+  }
+
+  /* Returns true if the key was present */
+  bool erase(const Key &key) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock lock(shard.mutex);
+    size_type old_size = shard.items.size();
+    shard.items.erase(key);
+    return shard.items.size() != old_size;
+  }
+
+  /* Calls function(mapped) under the shard's write lock, false if the key
+   * is absent. function must not touch this map */
+  template <typename Function>
+  bool update(const Key &key, Function function) {
+    Shard &shard = ShardFor(key);
+    std::unique_lock lock(shard.mutex);
+    auto position = shard.items.find(key);
+    if (position == shard.items.end()) {
+      return false;
+    }
+    function(position->second);
+    return true;
+  }
+
+ public: /* Batch operations, each shard is locked at most once */
+  /* Returns the number of new keys, present keys keep their values */
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  size_type insert_batch(InputIt first, InputIt last) {
+    vector<vector<value_type>> buckets(shard_count_);
+    for (; first != last; ++first) {
+      const auto &[key, data] = *first;
+      buckets[ShardIndex(key)].emplace_back(key, data);
+    }
+    size_type inserted{0};
+    for (size_type i{0}; i < shard_count_; ++i) {
+      if (buckets[i].empty()) {
+        continue;
+      }
+      std::unique_lock lock(shards_[i].mutex);
+      for (value_type &item : buckets[i]) {
+        inserted += shards_[i]
+                        .items.try_emplace(std::move(item.first),
+                                           std::move(item.second))
+                        .second;
+      }
+    }
+    return inserted;
+  }
+
+  /* Returns the number of keys removed */
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  size_type erase_batch(InputIt first, InputIt last) {
+    vector<vector<Key>> buckets(shard_count_);
+    for (; first != last; ++first) {
+      buckets[ShardIndex(*first)].push_back(*first);
+    }
+    size_type erased{0};
+    for (size_type i{0}; i < shard_count_; ++i) {
+      if (buckets[i].empty()) {
+        continue;
+      }
+      std::unique_lock lock(shards_[i].mutex);
+      size_type old_size = shards_[i].items.size();
+      for (const Key &key : buckets[i]) {
+        shards_[i].items.erase(key);
+      }
+      erased += old_size - shards_[i].items.size();
+    }
+    return erased;
+  }
+
+  /* Results come back in the order of the keys */
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  vector<std::optional<T>> find_batch(InputIt first, InputIt last) const {
+    vector<vector<std::pair<size_type, Key>>> buckets(shard_count_);
+    size_type count{0};
+    for (; first != last; ++first, ++count) {
+      buckets[ShardIndex(*first)].emplace_back(count, *first);
+    }
+    vector<std::optional<T>> result(count);
+    for (size_type i{0}; i < shard_count_; ++i) {
+      if (buckets[i].empty()) {
+        continue;
+      }
+      std::shared_lock lock(shards_[i].mutex);
+      for (const auto &[index, key] : buckets[i]) {
+        auto position = shards_[i].items.find(key);
+        if (position != shards_[i].items.end()) {
+          result[index] = position->second;
+        }
+      }
+    }
+    return result;
+  }
+
+ public: /* Lookup */
+  [[nodiscard]] std::optional<T> find(const Key &key) const {
+    const Shard &shard = ShardFor(key);
+    std::shared_lock lock(shard.mutex);
+    auto position = shard.items.find(key);
+    if (position == shard.items.end()) {
+      return std::nullopt;
+    }
+    return position->second;
+  }
+
+  [[nodiscard]] bool contains(const Key &key) const {
+    const Shard &shard = ShardFor(key);
+    std::shared_lock lock(shard.mutex);
+    return shard.items.contains(key);
+  }
+
+  [[nodiscard]] size_type count(const Key &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  [[nodiscard]] key_compare key_comp() const { return compare_; }
+
+  [[nodiscard]] hasher hash_function() const { return hash_; }
+
+ public: /* Ordered traversal */
+  /* All elements sorted by key. Every shard is copied under its read lock
+   * and the sorted copies are merged without holding any lock */
+  [[nodiscard]] snapshot_type snapshot() const {
+    vector<snapshot_type> parts(shard_count_);
+    for (size_type i{0}; i < shard_count_; ++i) {
+      std::shared_lock lock(shards_[i].mutex);
+      parts[i].reserve(shards_[i].items.size());
+      for (const auto &item : shards_[i].items) {
+        parts[i].emplace_back(item.first, item.second);
+      }
+    }
+    return MergeParts(parts);
+  }
+
+  /* Elements with key in [low, high), sorted by key */
+  [[nodiscard]] snapshot_type snapshot(const Key &low, const Key &high) const {
+    vector<snapshot_type> parts(shard_count_);
+    for (size_type i{0}; i < shard_count_; ++i) {
+      std::shared_lock lock(shards_[i].mutex);
+      shards_[i].items.for_each_range(low, high, [&](const auto &item) {
+        parts[i].emplace_back(item.first, item.second);
+      });
+    }
+    return MergeParts(parts);
+  }
+
+  /* Visits a snapshot in key order, function may use this map freely */
+  template <typename Function>
+  void for_each(Function function) const {
+    for (const value_type &item : snapshot()) {
+      function(item);
+    }
+  }
+
+  template <typename Function>
+  void for_each_range(const Key &low, const Key &high,
+                      Function function) const {
+    for (const value_type &item : snapshot(low, high)) {
+      function(item);
+    }
+  }
+
+ private:
+  /* Aligned so that locking one shard does not bounce the cache line of
+   * its neighbours */
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    map_type items;
+  };
+
+  [[nodiscard]] size_type ShardIndex(const Key &key) const {
+    return hash_(key) % shard_count_;
+  }
+
+  [[nodiscard]] Shard &ShardFor(const Key &key) {
+    return shards_[ShardIndex(key)];
+  }
+
+  [[nodiscard]] const Shard &ShardFor(const Key &key) const {
+    return shards_[ShardIndex(key)];
+  }
+
+  /* k-way merge of sorted parts through a heap of part indices. Keys are
+   * unique across shards, so no ties have to be resolved */
+  snapshot_type MergeParts(vector<snapshot_type> &parts) const {
+    size_type total{0};
+    for (const snapshot_type &part : parts) {
+      total += part.size();
+    }
+    vector<size_type> cursors(parts.size());
+    auto greater = [&](size_type left, size_type right) {
+      return compare_(parts[right][cursors[right]].first,
+                      parts[left][cursors[left]].first);
+    };
+    std::priority_queue<size_type, std::vector<size_type>, decltype(greater)>
+        heap(greater);
+    for (size_type i{0}; i < parts.size(); ++i) {
+      if (!parts[i].empty()) {
+        heap.push(i);
+      }
+    }
+    snapshot_type merged{};
+    merged.reserve(total);
+    while (!heap.empty()) {
+      size_type part = heap.top();
+      heap.pop();
+      merged.push_back(std::move(parts[part][cursors[part]++]));
+      if (cursors[part] != parts[part].size()) {
+        heap.push(part);
+      }
+    }
+    return merged;
+  }
+
+  size_type shard_count_;
+  std::unique_ptr<Shard[]> shards_;
+  Compare compare_;
+  Hash hash_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_CONCURRENT_MAP_CONCURRENT_MAP_H_
@@ -0,0 +1,36 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_FLAT_BASE_FLAT_SEARCH_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_FLAT_BASE_FLAT_SEARCH_H_
+
+#include <cstddef>
+
+namespace s21 {
+/* Index of the first of count sorted keys not less than key, or greater
+ * than key with Upper. Each step picks the half with a conditional move
+ * instead of a branch, so every lookup takes the same ceil(log2(count))
+ * steps and none of them can be mispredicted. The two places the next
+ * step may probe are prefetched while the current comparison runs */
+template <bool Upper, typename Key, typename K, typename Compare>
+std::size_t BranchlessBound(const Key *keys, std::size_t count, const K &key,
+                            const Compare &compare) {
+  if (count == 0) {
+    return 0;
+  }
+  const Key *base = keys;
+  while (count > 1) {
+    std::size_t half = count / 2;
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(base + half / 2);
+    __builtin_prefetch(base + half + half / 2);
+#endif
+    bool right = Upper ? !static_cast<bool>(compare(key, base[half]))
+                       : static_cast<bool>(compare(base[half], key));
+    base = right ? base + half : base;
+    count -= half;
+  }
+  bool past = Upper ? !static_cast<bool>(compare(key, *base))
+                    : static_cast<bool>(compare(*base, key));
+  return static_cast<std::size_t>(base - keys) + (past ? 1 : 0);
+}
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_FLAT_BASE_FLAT_SEARCH_H_
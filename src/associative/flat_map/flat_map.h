@@ -0,0 +1,606 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_FLAT_MAP_FLAT_MAP_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_FLAT_MAP_FLAT_MAP_H_
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "../../sequence/vector/vector.h"
+#include "../flat_base/FlatSearch.h"
+#include "../red_black_tree/RedBlackTree.h"
+
+namespace s21 {
+/* Map kept as two sorted vectors, one of keys and one of mapped values at
+ * the same indices. Searches touch only the dense key array and use a
+ * branchless binary search. Single inserts and erases shift both tails and
+ * invalidate all iterators, insert_range merges many elements at once.
+ * Dereferencing an iterator gives a pair of references into both arrays */
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class flat_map : private KeyCompare<Compare> {
+  using KeyCompareBase = KeyCompare<Compare>;
+  using KeyCompareBase::Less;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using key_compare = Compare;
+
+  using key_container_type = vector<Key>;
+  using mapped_container_type = vector<T>;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  template <bool IsConst>
+  class FlatMapIteratorBase {
+    using Mapped = std::conditional_t<IsConst, const T, T>;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::pair<Key, T>;
+    using reference = std::pair<const Key &, Mapped &>;
+
+    /* Keeps the pair of references alive for operator-> */
+    struct pointer {
+      reference value;
+
+      const reference *operator->() const { return &value; }
+    };
+
+    FlatMapIteratorBase() = default;
+
+    FlatMapIteratorBase(const Key *key, Mapped *mapped)
+        : key_(key), mapped_(mapped) {}
+
+    /* Mutable iterators convert to const ones */
+    template <bool OtherIsConst,
+              typename = std::enable_if_t<IsConst && !OtherIsConst>>
+    FlatMapIteratorBase(const FlatMapIteratorBase<OtherIsConst> &other)
+        : key_(other.key_), mapped_(other.mapped_) {}
+
+    reference operator*() const { return {*key_, *mapped_}; }
+
+    pointer operator->() const { return pointer{**this}; }
+
+    reference operator[](difference_type offset) const {
+      return *(*this + offset);
+    }
+
+    FlatMapIteratorBase &operator++() { return *this += 1; }
+
+    FlatMapIteratorBase &operator--() { return *this -= 1; }
+
+    FlatMapIteratorBase operator++(int) {
+      FlatMapIteratorBase iter(*this);
+      ++(*this);
+      return iter;
+    }
+
+    FlatMapIteratorBase operator--(int) {
+      FlatMapIteratorBase iter(*this);
+      --(*this);
+      return iter;
+    }
+
+    FlatMapIteratorBase &operator+=(difference_type offset) {
+      key_ += offset;
+      mapped_ += offset;
+      return *this;
+    }
+
+    FlatMapIteratorBase &operator-=(difference_type offset) {
+      return *this += -offset;
+    }
+
+    FlatMapIteratorBase operator+(difference_type offset) const {
+      return FlatMapIteratorBase(*this) += offset;
+    }
+
+    FlatMapIteratorBase operator-(difference_type offset) const {
+      return FlatMapIteratorBase(*this) -= offset;
+    }
+
+    template <bool OtherIsConst>
+    difference_type operator-(
+        const FlatMapIteratorBase<OtherIsConst> &other) const {
+      return key_ - other.key_;
+    }
+
+    template <bool OtherIsConst>
+    bool operator==(const FlatMapIteratorBase<OtherIsConst> &other) const {
+      return key_ == other.key_;
+    }
+
+    template <bool OtherIsConst>
+    bool operator!=(const FlatMapIteratorBase<OtherIsConst> &other) const {
+      return key_ != other.key_;
+    }
+
+    template <bool OtherIsConst>
+    bool operator<(const FlatMapIteratorBase<OtherIsConst> &other) const {
+      return key_ < other.key_;
+    }
+
+    template <bool OtherIsConst>
+    bool operator>(const FlatMapIteratorBase<OtherIsConst> &other) const {
+      return other < *this;
+    }
+
+    template <bool OtherIsConst>
+    bool operator<=(const FlatMapIteratorBase<OtherIsConst> &other) const {
+      return !(other < *this);
+    }
+
+    template <bool OtherIsConst>
+    bool operator>=(const FlatMapIteratorBase<OtherIsConst> &other) const {
+      return !(*this < other);
+    }
+
+   private:
+    template <bool>
+    friend class FlatMapIteratorBase;
+
+    friend class flat_map;
+
+    const Key *key_{};
+    Mapped *mapped_{};
+  };
+
+  using iterator = FlatMapIteratorBase<false>;
+  using const_iterator = FlatMapIteratorBase<true>;
+  using reference = typename iterator::reference;
+  using const_reference = typename const_iterator::reference;
+  using scan_range = ScanRange<iterator>;
+  using const_scan_range = ScanRange<const_iterator>;
+
+ public: /* Constructors */
+  flat_map() = default;
+
+  explicit flat_map(const Compare &compare) : KeyCompareBase(compare) {}
+
+  flat_map(std::initializer_list<value_type> const &items) {
+    insert_range(items.begin(), items.end());
+  }
+
+  /* Of equal keys the first one wins */
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  flat_map(InputIt first, InputIt last) {
+    insert_range(first, last);
+  }
+
+ public: /* Element access */
+  mapped_type &operator[](const key_type &key) {
+    return try_emplace(key).first->second;
+  }
+
+  mapped_type &operator[](key_type &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  T &at(const Key &key) { return values_[CheckedIndex(key)]; }
+
+  const T &at(const Key &key) const { return values_[CheckedIndex(key)]; }
+
+  /* Smallest and largest elements, the map must not be empty */
+  [[nodiscard]] reference front() { return *begin(); }
+
+  [[nodiscard]] const_reference front() const { return *begin(); }
+
+  [[nodiscard]] reference back() { return *std::prev(end()); }
+
+  [[nodiscard]] const_reference back() const { return *std::prev(end()); }
+
+  /* The sorted keys and the mapped values in key order */
+  [[nodiscard]] const key_container_type &keys() const { return keys_; }
+
+  [[nodiscard]] const mapped_container_type &values() const { return values_; }
+
+ public: /* Iterators */
+  [[nodiscard]] iterator begin() { return At(0); }
+
+  [[nodiscard]] const_iterator begin() const { return At(0); }
+
+  [[nodiscard]] iterator end() { return At(size()); }
+
+  [[nodiscard]] const_iterator end() const { return At(size()); }
+
+ public: /* Capacity */
+  [[nodiscard]] bool empty() const { return keys_.empty(); }
+
+  [[nodiscard]] size_type size() const { return keys_.size(); }
+
+  [[nodiscard]] size_type max_size() const {
+    return std::min(keys_.max_size(), values_.max_size());
+  }
+
+  void reserve(size_type count) {
+    keys_.reserve(count);
+    values_.reserve(count);
+  }
+
+ public: /* Modifiers */
+  void clear() {
+    keys_.clear();
+    values_.clear();
+  }
+
+  /* Replaces the content in O(n), [first, last) must be sorted by key */
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    flat_map sorted(this->GetCompare());
+    for (; first != last; ++first) {
+      if (sorted.empty() || Less(sorted.keys_.back(), first->first)) {
+        sorted.keys_.push_back(first->first);
+        sorted.values_.push_back(first->second);
+      }
+    }
+    *this = std::move(sorted);
+  }
+
+  /* O(n) shift of both tails, use insert_range for many elements */
+  std::pair<iterator, bool> insert(const value_type &pair) {
+    return try_emplace(pair.first, pair.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&pair) {
+    return try_emplace(std::move(pair.first), std::move(pair.second));
+  }
+
+  std::pair<iterator, bool> insert(const Key &key, const T &data) {
+    return try_emplace(key, data);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  /* Nothing is built and args are left untouched when the key is present */
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    return EmplaceUnique(key, std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    return EmplaceUnique(std::move(key), std::forward<Args>(args)...);
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, M &&data) {
+    auto result = try_emplace(key, std::forward<M>(data));
+    if (!result.second) {
+      result.first->second = std::forward<M>(data);
+    }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key &&key, M &&data) {
+    auto result = try_emplace(std::move(key), std::forward<M>(data));
+    if (!result.second) {
+      result.first->second = std::forward<M>(data);
+    }
+    return result;
+  }
+
+  /* Sorts the new elements on their own and merges both arrays in one
+   * O(n + m) pass instead of shifting them once per element. Elements
+   * already present win over new ones with an equal key, of equal new keys
+   * the first one wins */
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  void insert_range(InputIt first, InputIt last) {
+    vector<value_type> incoming{};
+    for (; first != last; ++first) {
+      incoming.emplace_back(*first);
+    }
+    std::stable_sort(incoming.begin(), incoming.end(),
+                     [this](const value_type &left, const value_type &right) {
+                       return Less(left.first, right.first);
+                     });
+    auto unique_end = std::unique(
+        incoming.begin(), incoming.end(),
+        [this](const value_type &left, const value_type &right) {
+          return !Less(left.first, right.first);
+        });
+    while (incoming.end() != unique_end) {
+      incoming.pop_back();
+    }
+    MergeSorted(std::move(incoming));
+  }
+
+  void insert_range(std::initializer_list<value_type> items) {
+    insert_range(items.begin(), items.end());
+  }
+
+  void erase(const Key &key) { EraseAt(FindIndex(key)); }
+
+  template <typename K, typename = RequireTransparent<Compare, K>,
+            typename =
+                std::enable_if_t<!std::is_convertible_v<K, const_iterator>>>
+  void erase(const K &key) {
+    EraseAt(FindIndex(key));
+  }
+
+  void erase(const_iterator position) { EraseAt(IndexOf(position)); }
+
+  void swap(flat_map &other) noexcept {
+    std::swap(static_cast<KeyCompareBase &>(*this),
+              static_cast<KeyCompareBase &>(other));
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+  }
+
+ public: /* Lookup */
+  [[nodiscard]] iterator find(const Key &key) { return At(FindIndex(key)); }
+
+  [[nodiscard]] const_iterator find(const Key &key) const {
+    return At(FindIndex(key));
+  }
+
+  [[nodiscard]] bool contains(const Key &key) const {
+    return FindIndex(key) != size();
+  }
+
+  [[nodiscard]] size_type count(const Key &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  /* Bounds are O(log n) and end() when no key qualifies */
+  [[nodiscard]] iterator lower_bound(const Key &key) {
+    return At(LowerIndex(key));
+  }
+
+  [[nodiscard]] const_iterator lower_bound(const Key &key) const {
+    return At(LowerIndex(key));
+  }
+
+  [[nodiscard]] iterator upper_bound(const Key &key) {
+    return At(UpperIndex(key));
+  }
+
+  [[nodiscard]] const_iterator upper_bound(const Key &key) const {
+    return At(UpperIndex(key));
+  }
+
+  [[nodiscard]] std::pair<iterator, iterator> equal_range(const Key &key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  [[nodiscard]] std::pair<const_iterator, const_iterator> equal_range(
+      const Key &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  /* Heterogeneous lookups, only with a transparent Compare */
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] iterator find(const K &key) {
+    return At(FindIndex(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] const_iterator find(const K &key) const {
+    return At(FindIndex(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] bool contains(const K &key) const {
+    return FindIndex(key) != size();
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] iterator lower_bound(const K &key) {
+    return At(LowerIndex(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] const_iterator lower_bound(const K &key) const {
+    return At(LowerIndex(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] iterator upper_bound(const K &key) {
+    return At(UpperIndex(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] const_iterator upper_bound(const K &key) const {
+    return At(UpperIndex(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] std::pair<iterator, iterator> equal_range(const K &key) {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] std::pair<const_iterator, const_iterator> equal_range(
+      const K &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+ public: /* Observers */
+  [[nodiscard]] key_compare key_comp() const { return this->GetCompare(); }
+
+ public: /* Order statistics, positions are plain indices */
+  /* Number of keys less than the key */
+  [[nodiscard]] size_type rank(const Key &key) const { return LowerIndex(key); }
+
+  /* Zero-based k-th smallest element, end() if k >= size() */
+  [[nodiscard]] iterator select(size_type k) { return At(std::min(k, size())); }
+
+  [[nodiscard]] const_iterator select(size_type k) const {
+    return At(std::min(k, size()));
+  }
+
+  [[nodiscard]] iterator advance(const_iterator position, difference_type n) {
+    difference_type index = position - begin() + n;
+    return At(static_cast<size_type>(std::clamp<difference_type>(
+        index, 0, static_cast<difference_type>(size()))));
+  }
+
+  /* Number of keys in [low, high) */
+  [[nodiscard]] size_type count_range(const Key &low, const Key &high) const {
+    return Less(low, high) ? LowerIndex(high) - LowerIndex(low) : 0;
+  }
+
+ public: /* Range scans */
+  /* Visits the elements with key in [low, high) in order. Mapped values
+   * may be modified */
+  template <typename Function>
+  void for_each_range(const Key &low, const Key &high, Function function) {
+    for (reference item : scan(low, high)) {
+      function(item);
+    }
+  }
+
+  template <typename Function>
+  void for_each_range(const Key &low, const Key &high,
+                      Function function) const {
+    for (const_reference item : scan(low, high)) {
+      function(item);
+    }
+  }
+
+  /* Contiguous range over [low, high) */
+  [[nodiscard]] scan_range scan(const Key &low, const Key &high) {
+    iterator first = lower_bound(low);
+    return {first, Less(low, high) ? lower_bound(high) : first};
+  }
+
+  [[nodiscard]] const_scan_range scan(const Key &low, const Key &high) const {
+    const_iterator first = lower_bound(low);
+    return {first, Less(low, high) ? lower_bound(high) : first};
+  }
+
+ private:
+  [[nodiscard]] iterator At(size_type index) {
+    return {keys_.data() + index, values_.data() + index};
+  }
+
+  [[nodiscard]] const_iterator At(size_type index) const {
+    return {keys_.data() + index, values_.data() + index};
+  }
+
+  [[nodiscard]] size_type IndexOf(const_iterator position) const {
+    return static_cast<size_type>(position.key_ - keys_.data());
+  }
+
+  template <typename K>
+  [[nodiscard]] size_type LowerIndex(const K &key) const {
+    return BranchlessBound<false>(keys_.data(), keys_.size(), key,
+                                  this->GetCompare());
+  }
+
+  template <typename K>
+  [[nodiscard]] size_type UpperIndex(const K &key) const {
+    return BranchlessBound<true>(keys_.data(), keys_.size(), key,
+                                 this->GetCompare());
+  }
+
+  /* size() when the key is absent */
+  template <typename K>
+  [[nodiscard]] size_type FindIndex(const K &key) const {
+    size_type index = LowerIndex(key);
+    if (index == size() || Less(key, keys_[index])) {
+      return size();
+    }
+    return index;
+  }
+
+  [[nodiscard]] size_type CheckedIndex(const Key &key) const {
+    size_type index = FindIndex(key);
+    if (index == size()) {
+      throw std::out_of_range("Key is not found in the flat_map");
+    }
+    return index;
+  }
+
+  void EraseAt(size_type index) {
+    if (index < size()) {
+      auto offset = static_cast<difference_type>(index);
+      keys_.erase(keys_.begin() + offset);
+      values_.erase(values_.begin() + offset);
+    }
+  }
+
+  /* The key is inserted first, it is taken out again if the mapped value
+   * cannot be built */
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> EmplaceUnique(K &&key, Args &&...args) {
+    size_type index = LowerIndex(key);
+    if (index != size() && !Less(key, keys_[index])) {
+      return {At(index), false};
+    }
+    auto offset = static_cast<difference_type>(index);
+    keys_.emplace(keys_.cbegin() + offset, std::forward<K>(key));
+    try {
+      values_.emplace(values_.cbegin() + offset, std::forward<Args>(args)...);
+    } catch (...) {
+      keys_.erase(keys_.begin() + offset);
+      throw;
+    }
+    return {At(index), true};
+  }
+
+  /* incoming is sorted by key and free of duplicates */
+  void MergeSorted(vector<value_type> &&incoming) {
+    if (keys_.empty() || incoming.empty() ||
+        Less(keys_.back(), incoming.front().first)) {
+      reserve(size() + incoming.size());
+      for (value_type &pair : incoming) {
+        keys_.push_back(std::move(pair.first));
+        values_.push_back(std::move(pair.second));
+      }
+      return;
+    }
+    flat_map merged(this->GetCompare());
+    merged.reserve(size() + incoming.size());
+    size_type old_index = 0;
+    auto new_pair = incoming.begin();
+    auto take_old = [&]() {
+      merged.keys_.push_back(std::move(keys_[old_index]));
+      merged.values_.push_back(std::move(values_[old_index]));
+      ++old_index;
+    };
+    auto take_new = [&]() {
+      merged.keys_.push_back(std::move(new_pair->first));
+      merged.values_.push_back(std::move(new_pair->second));
+      ++new_pair;
+    };
+    while (old_index != size() && new_pair != incoming.end()) {
+      if (Less(new_pair->first, keys_[old_index])) {
+        take_new();
+      } else {
+        if (!Less(keys_[old_index], new_pair->first)) {
+          ++new_pair;
+        }
+        take_old();
+      }
+    }
+    while (old_index != size()) {
+      take_old();
+    }
+    while (new_pair != incoming.end()) {
+      take_new();
+    }
+    *this = std::move(merged);
+  }
+
+  key_container_type keys_;
+  mapped_container_type values_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_FLAT_MAP_FLAT_MAP_H_
@@ -0,0 +1,335 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_FLAT_SET_FLAT_SET_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_FLAT_SET_FLAT_SET_H_
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "../../sequence/vector/vector.h"
+#include "../flat_base/FlatSearch.h"
+#include "../red_black_tree/RedBlackTree.h"
+
+namespace s21 {
+/* Set kept as one sorted vector. Lookups are branchless binary searches
+ * over contiguous keys, single inserts and erases shift the tail, so it
+ * suits data that is built in bulk and then mostly read. Any insert or
+ * erase invalidates all iterators */
+template <typename Key, typename Compare = std::less<Key>>
+class flat_set : private KeyCompare<Compare> {
+  using KeyCompareBase = KeyCompare<Compare>;
+  using KeyCompareBase::Less;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+
+  using key_compare = Compare;
+  using value_compare = Compare;
+
+  using container_type = vector<Key>;
+  using iterator = typename container_type::const_iterator;
+  using const_iterator = typename container_type::const_iterator;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using scan_range = ScanRange<const_iterator>;
+
+ public: /* Member */
+  flat_set() = default;
+
+  explicit flat_set(const Compare &compare) : KeyCompareBase(compare) {}
+
+  flat_set(std::initializer_list<value_type> const &items) {
+    insert_range(items.begin(), items.end());
+  }
+
+  /* Of equal keys the first one wins */
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  flat_set(InputIt first, InputIt last) {
+    insert_range(first, last);
+  }
+
+ public: /* Iterators */
+  [[nodiscard]] const_iterator begin() const { return keys_.begin(); }
+
+  [[nodiscard]] const_iterator end() const { return keys_.end(); }
+
+ public: /* Element access */
+  /* Smallest and largest elements, the set must not be empty */
+  [[nodiscard]] const_reference front() const { return keys_.front(); }
+
+  [[nodiscard]] const_reference back() const { return keys_.back(); }
+
+  /* The sorted keys themselves */
+  [[nodiscard]] const container_type &keys() const { return keys_; }
+
+ public: /* Capacity */
+  [[nodiscard]] bool empty() const { return keys_.empty(); }
+
+  [[nodiscard]] size_type size() const { return keys_.size(); }
+
+  [[nodiscard]] size_type max_size() const { return keys_.max_size(); }
+
+  void reserve(size_type count) { keys_.reserve(count); }
+
+ public: /* Modifiers */
+  void clear() { keys_.clear(); }
+
+  /* Replaces the content in O(n), [first, last) must be sorted */
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    container_type keys{};
+    for (; first != last; ++first) {
+      if (keys.empty() || Less(keys.back(), *first)) {
+        keys.push_back(*first);
+      }
+    }
+    keys_ = std::move(keys);
+  }
+
+  /* O(n) shift of the tail, use insert_range for many elements */
+  std::pair<iterator, bool> insert(const value_type &value) {
+    return EmplaceUnique(value);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&value) {
+    return EmplaceUnique(std::move(value));
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    return EmplaceUnique(value_type(std::forward<Args>(args)...));
+  }
+
+  /* Sorts the new elements on their own and merges them in one O(n + m)
+   * pass instead of shifting the tail once per element. Elements already
+   * present win over new ones with an equal key */
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  void insert_range(InputIt first, InputIt last) {
+    container_type incoming{};
+    for (; first != last; ++first) {
+      incoming.emplace_back(*first);
+    }
+    std::stable_sort(incoming.begin(), incoming.end(),
+                     [this](const Key &left, const Key &right) {
+                       return Less(left, right);
+                     });
+    auto unique_end =
+        std::unique(incoming.begin(), incoming.end(),
+                    [this](const Key &left, const Key &right) {
+                      return !Less(left, right);
+                    });
+    while (incoming.end() != unique_end) {
+      incoming.pop_back();
+    }
+    MergeSorted(std::move(incoming));
+  }
+
+  void insert_range(std::initializer_list<value_type> items) {
+    insert_range(items.begin(), items.end());
+  }
+
+  void erase(const key_type &key) { EraseByKey(key); }
+
+  template <typename K, typename = RequireTransparent<Compare, K>,
+            typename = std::enable_if_t<!std::is_convertible_v<K, iterator>>>
+  void erase(const K &key) {
+    EraseByKey(key);
+  }
+
+  void erase(const_iterator position) {
+    keys_.erase(keys_.begin() + (position - keys_.begin()));
+  }
+
+  void swap(flat_set &other) noexcept {
+    std::swap(static_cast<KeyCompareBase &>(*this),
+              static_cast<KeyCompareBase &>(other));
+    keys_.swap(other.keys_);
+  }
+
+ public: /* Lookup */
+  [[nodiscard]] iterator find(const key_type &key) const {
+    return FindByKey(key);
+  }
+
+  [[nodiscard]] bool contains(const key_type &key) const {
+    return FindByKey(key) != end();
+  }
+
+  [[nodiscard]] size_type count(const key_type &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  /* Bounds are O(log n) and end() when no element qualifies */
+  [[nodiscard]] iterator lower_bound(const key_type &key) const {
+    return begin() + static_cast<difference_type>(LowerIndex(key));
+  }
+
+  [[nodiscard]] iterator upper_bound(const key_type &key) const {
+    return begin() + static_cast<difference_type>(UpperIndex(key));
+  }
+
+  [[nodiscard]] std::pair<iterator, iterator> equal_range(
+      const key_type &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+  /* Heterogeneous lookups, only with a transparent Compare */
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] iterator find(const K &key) const {
+    return FindByKey(key);
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] bool contains(const K &key) const {
+    return FindByKey(key) != end();
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] iterator lower_bound(const K &key) const {
+    return begin() + static_cast<difference_type>(LowerIndex(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] iterator upper_bound(const K &key) const {
+    return begin() + static_cast<difference_type>(UpperIndex(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] std::pair<iterator, iterator> equal_range(const K &key) const {
+    return {lower_bound(key), upper_bound(key)};
+  }
+
+ public: /* Observers */
+  [[nodiscard]] key_compare key_comp() const { return this->GetCompare(); }
+
+  [[nodiscard]] value_compare value_comp() const { return this->GetCompare(); }
+
+ public: /* Order statistics, positions are plain indices */
+  /* Number of elements less than the key */
+  [[nodiscard]] size_type rank(const key_type &key) const {
+    return LowerIndex(key);
+  }
+
+  /* Zero-based k-th smallest element, end() if k >= size() */
+  [[nodiscard]] iterator select(size_type k) const {
+    return begin() + static_cast<difference_type>(std::min(k, size()));
+  }
+
+  [[nodiscard]] iterator advance(const_iterator position,
+                                 difference_type n) const {
+    difference_type index = position - begin() + n;
+    return begin() + std::clamp<difference_type>(
+                         index, 0, static_cast<difference_type>(size()));
+  }
+
+  /* Number of elements in [low, high) */
+  [[nodiscard]] size_type count_range(const key_type &low,
+                                      const key_type &high) const {
+    return Less(low, high) ? LowerIndex(high) - LowerIndex(low) : 0;
+  }
+
+ public: /* Range scans */
+  template <typename Function>
+  void for_each_range(const key_type &low, const key_type &high,
+                      Function function) const {
+    for (const value_type &value : scan(low, high)) {
+      function(value);
+    }
+  }
+
+  /* Contiguous range over [low, high) */
+  [[nodiscard]] scan_range scan(const key_type &low,
+                                const key_type &high) const {
+    iterator first = lower_bound(low);
+    return {first, Less(low, high) ? lower_bound(high) : first};
+  }
+
+ private:
+  template <typename K>
+  [[nodiscard]] size_type LowerIndex(const K &key) const {
+    return BranchlessBound<false>(keys_.data(), keys_.size(), key,
+                                  this->GetCompare());
+  }
+
+  template <typename K>
+  [[nodiscard]] size_type UpperIndex(const K &key) const {
+    return BranchlessBound<true>(keys_.data(), keys_.size(), key,
+                                 this->GetCompare());
+  }
+
+  template <typename K>
+  [[nodiscard]] iterator FindByKey(const K &key) const {
+    size_type index = LowerIndex(key);
+    if (index == size() || Less(key, keys_[index])) {
+      return end();
+    }
+    return begin() + static_cast<difference_type>(index);
+  }
+
+  template <typename K>
+  void EraseByKey(const K &key) {
+    iterator position = FindByKey(key);
+    if (position != end()) {
+      erase(position);
+    }
+  }
+
+  template <typename Value>
+  std::pair<iterator, bool> EmplaceUnique(Value &&value) {
+    size_type index = LowerIndex(value);
+    auto position = begin() + static_cast<difference_type>(index);
+    if (index != size() && !Less(value, keys_[index])) {
+      return {position, false};
+    }
+    keys_.emplace(position, std::forward<Value>(value));
+    return {begin() + static_cast<difference_type>(index), true};
+  }
+
+  /* incoming is sorted and free of duplicates */
+  void MergeSorted(container_type &&incoming) {
+    if (keys_.empty() || incoming.empty() ||
+        Less(keys_.back(), incoming.front())) {
+      keys_.reserve(keys_.size() + incoming.size());
+      for (Key &key : incoming) {
+        keys_.push_back(std::move(key));
+      }
+      return;
+    }
+    container_type merged{};
+    merged.reserve(keys_.size() + incoming.size());
+    auto old_key = keys_.begin();
+    auto new_key = incoming.begin();
+    while (old_key != keys_.end() && new_key != incoming.end()) {
+      if (Less(*new_key, *old_key)) {
+        merged.push_back(std::move(*new_key++));
+      } else {
+        if (!Less(*old_key, *new_key)) {
+          ++new_key;
+        }
+        merged.push_back(std::move(*old_key++));
+      }
+    }
+    for (; old_key != keys_.end(); ++old_key) {
+      merged.push_back(std::move(*old_key));
+    }
+    for (; new_key != incoming.end(); ++new_key) {
+      merged.push_back(std::move(*new_key));
+    }
+    keys_ = std::move(merged);
+  }
+
+  container_type keys_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_FLAT_SET_FLAT_SET_H_
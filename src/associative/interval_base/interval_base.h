@@ -0,0 +1,141 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_INTERVAL_BASE_INTERVAL_BASE_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_INTERVAL_BASE_INTERVAL_BASE_H_
+
+#include <limits>
+#include <stdexcept>
+
+#include "../red_black_tree/RedBlackTree.h"
+
+namespace s21 {
+/* Summary of a subtree of intervals: the largest right end */
+template <typename Bound, typename KeyOfValue>
+struct MaxEndAggregate {
+  using value_type = Bound;
+
+  static value_type Identity() {
+    return std::numeric_limits<Bound>::lowest();
+  }
+
+  template <typename Value>
+  static value_type Lift(const Value &value) {
+    return KeyOfValue{}(value).second;
+  }
+
+  static value_type Combine(const value_type &a, const value_type &b) {
+    return a < b ? b : a;
+  }
+};
+
+/* Half-open intervals [first, second) with first < second, ordered by
+ * first and then second. Every node keeps the largest right end in its
+ * subtree, so overlap searches skip subtrees that end too early */
+template <typename Value, typename KeyOfValue, typename Bound,
+          typename NodeAllocator>
+class interval_base {
+  static_assert(std::numeric_limits<Bound>::is_specialized,
+                "interval bounds need std::numeric_limits");
+
+ public:
+  using bound_type = Bound;
+  using key_type = std::pair<Bound, Bound>;
+  using value_type = Value;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+
+  using TreeType = RedBlackTree<Value, KeyOfValue, std::less<>, NodeAllocator,
+                                MaxEndAggregate<Bound, KeyOfValue>>;
+  /* Intervals themselves are never modified in place */
+  using iterator =
+      std::conditional_t<std::is_same_v<Value, key_type>,
+                         typename TreeType::const_iterator,
+                         typename TreeType::mutable_iterator>;
+  using const_iterator = typename TreeType::const_iterator;
+
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+ public: /* Iterators */
+  [[nodiscard]] iterator begin() const {
+    return iterator(tree_.GetLeftmost());
+  }
+
+  [[nodiscard]] iterator end() const { return iterator(tree_.GetNil()); }
+
+ public: /* Modifiers */
+  void clear() { tree_.Clear(); }
+
+  void erase(const Bound &low, const Bound &high) {
+    tree_.RemoveByKey(key_type{low, high});
+  }
+
+  void erase(iterator position) { tree_.Erase(position.base()); }
+
+  void swap(interval_base &other) { std::swap(tree_, other.tree_); }
+
+ public: /* Capacity */
+  [[nodiscard]] bool empty() const { return tree_.IsEmpty(); }
+
+  [[nodiscard]] size_type size() const { return tree_.GetSize(); }
+
+ public: /* Lookup */
+  [[nodiscard]] iterator find(const Bound &low, const Bound &high) const {
+    return iterator(tree_.SearchByKey(key_type{low, high}));
+  }
+
+  [[nodiscard]] bool contains(const Bound &low, const Bound &high) const {
+    return tree_.SearchByKey(key_type{low, high}) != tree_.GetNil();
+  }
+
+ public: /* Overlap queries */
+  /* First interval in order that overlaps [low, high) in O(log n), end()
+   * if there is none or the query is empty */
+  [[nodiscard]] iterator find_overlap(const Bound &low,
+                                      const Bound &high) const {
+    if (!(low < high)) {
+      return end();
+    }
+    return iterator(tree_.FindFirstMatching(
+        LastStartingBefore(high), [&low](const Bound &end) {
+          return low < end;
+        }));
+  }
+
+  /* Calls function in order on every interval that overlaps [low, high).
+   * Subtrees ending at or before low are skipped, so k overlaps cost
+   * O(log n + k log(n / k)) */
+  template <typename Function>
+  void for_each_overlap(const Bound &low, const Bound &high,
+                        Function function) const {
+    if (low < high) {
+      tree_.ForEachMatching(
+          LastStartingBefore(high),
+          [&low](const Bound &end) { return low < end; }, function);
+    }
+  }
+
+  /* Calls function in order on every interval that contains point */
+  template <typename Function>
+  void for_each_containing(const Bound &point, Function function) const {
+    tree_.ForEachMatching(
+        key_type{point, std::numeric_limits<Bound>::max()},
+        [&point](const Bound &end) { return point < end; }, function);
+  }
+
+ protected:
+  static void CheckInterval(const Bound &low, const Bound &high) {
+    if (!(low < high)) {
+      throw std::invalid_argument("Interval is empty");
+    }
+  }
+
+  /* Keys up to this one are exactly the intervals starting before high,
+   * as no interval ends at the lowest bound */
+  static key_type LastStartingBefore(const Bound &high) {
+    return {high, std::numeric_limits<Bound>::lowest()};
+  }
+
+  TreeType tree_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_INTERVAL_BASE_INTERVAL_BASE_H_
@@ -0,0 +1,79 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_INTERVAL_MAP_INTERVAL_MAP_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_INTERVAL_MAP_INTERVAL_MAP_H_
+
+#include "../interval_base/interval_base.h"
+
+namespace s21 {
+/* Maps distinct half-open intervals [first, second) of Bound to values of
+ * T, see interval_base for the overlap queries. Mapped values may be
+ * modified through iterators, the intervals may not */
+template <typename Bound, typename T,
+          typename NodeAllocator = HeapNodeAllocator>
+class interval_map
+    : public interval_base<std::pair<const std::pair<Bound, Bound>, T>,
+                           PairFirstKey<std::pair<Bound, Bound>>, Bound,
+                           NodeAllocator> {
+  using Base = interval_base<std::pair<const std::pair<Bound, Bound>, T>,
+                             PairFirstKey<std::pair<Bound, Bound>>, Bound,
+                             NodeAllocator>;
+
+ public:
+  using typename Base::const_iterator;
+  using typename Base::iterator;
+  using typename Base::key_type;
+  using typename Base::value_type;
+  using mapped_type = T;
+
+ public: /* Member */
+  interval_map() = default;
+
+  /* Throws std::invalid_argument on an empty interval */
+  interval_map(std::initializer_list<value_type> const &items) {
+    for (const value_type &item : items) {
+      insert(item.first.first, item.first.second, item.second);
+    }
+  }
+
+ public: /* Element access */
+  /* Throws std::out_of_range when the interval is absent */
+  mapped_type &at(const Bound &low, const Bound &high) {
+    iterator position = this->find(low, high);
+    if (position == this->end()) {
+      throw std::out_of_range("Interval is not found in the interval_map");
+    }
+    return position->second;
+  }
+
+  const mapped_type &at(const Bound &low, const Bound &high) const {
+    const_iterator position(this->tree_.SearchByKey(key_type{low, high}));
+    if (position == const_iterator(this->tree_.GetNil())) {
+      throw std::out_of_range("Interval is not found in the interval_map");
+    }
+    return position->second;
+  }
+
+ public: /* Modifiers */
+  /* Nothing changes when the interval is present. Throws
+   * std::invalid_argument unless low < high */
+  std::pair<iterator, bool> insert(const Bound &low, const Bound &high,
+                                   const mapped_type &value) {
+    Base::CheckInterval(low, high);
+    key_type interval{low, high};
+    auto [node, inserted] = this->tree_.EmplaceIfAbsent(interval, interval,
+                                                        value);
+    return {iterator(node), inserted};
+  }
+
+  std::pair<iterator, bool> insert_or_assign(const Bound &low,
+                                             const Bound &high,
+                                             const mapped_type &value) {
+    auto result = insert(low, high, value);
+    if (!result.second) {
+      result.first->second = value;
+    }
+    return result;
+  }
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_INTERVAL_MAP_INTERVAL_MAP_H_
@@ -0,0 +1,42 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_INTERVAL_SET_INTERVAL_SET_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_INTERVAL_SET_INTERVAL_SET_H_
+
+#include "../interval_base/interval_base.h"
+
+namespace s21 {
+/* Distinct half-open intervals [first, second) of Bound, see
+ * interval_base for the overlap queries */
+template <typename Bound, typename NodeAllocator = HeapNodeAllocator>
+class interval_set
+    : public interval_base<std::pair<Bound, Bound>,
+                           IdentityKey<std::pair<Bound, Bound>>, Bound,
+                           NodeAllocator> {
+  using Base = interval_base<std::pair<Bound, Bound>,
+                             IdentityKey<std::pair<Bound, Bound>>, Bound,
+                             NodeAllocator>;
+
+ public:
+  using typename Base::iterator;
+  using typename Base::value_type;
+
+ public: /* Member */
+  interval_set() = default;
+
+  /* Throws std::invalid_argument on an empty interval */
+  interval_set(std::initializer_list<value_type> const &items) {
+    for (const value_type &interval : items) {
+      insert(interval.first, interval.second);
+    }
+  }
+
+ public: /* Modifiers */
+  /* Throws std::invalid_argument unless low < high */
+  std::pair<iterator, bool> insert(const Bound &low, const Bound &high) {
+    Base::CheckInterval(low, high);
+    auto [node, inserted] = this->tree_.InsertUnique(value_type{low, high});
+    return {iterator(node), inserted};
+  }
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_INTERVAL_SET_INTERVAL_SET_H_
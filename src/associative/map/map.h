@@ -1,10 +1,15 @@
 #ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_MAP_MAP_H_
 #define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_MAP_MAP_H_
 
-#include "../red_black_tree/RedBlackTree.h"
+#include "../b_tree/TreeBackend.h"
 
 namespace s21 {
-template <typename Key, typename T>
+/* Aggregate is a policy from Aggregate.h over the mapped values, such as
+ * SumAggregate<T>. It makes aggregate(low, high) run in O(log n). Stats
+ * set to TreeStats makes the tree count its work for stats() */
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename NodeAllocator = HeapNodeAllocator,
+          typename Aggregate = NoAggregate, typename Stats = NoTreeStats>
 class map {
  public:
   using key_type = Key;
@@ -14,51 +19,53 @@ class map {
   using reference = value_type &;
   using const_reference = const value_type &;
 
-  using RedBlackTreeIterator =
-      typename RedBlackTree<pair_type>::RedBlackTreeIterator;
-  using RedBlackTreeConstIterator =
-      typename RedBlackTree<pair_type>::RedBlackTreeConstIterator;
+  using key_compare = Compare;
 
-  using iterator = RedBlackTreeIterator;
-  using const_iterator = RedBlackTreeConstIterator;
+  /* A RedBlackTree on NodeAllocator, or a BTree for BTreeNodes */
+  using TreeType =
+      TreeFor<pair_type, PairFirstKey<pair_type>, Compare, NodeAllocator,
+              MappedAggregateFor<Aggregate>, Stats>;
+
+  using iterator = typename TreeType::mutable_iterator;
+  using const_iterator = typename TreeType::const_iterator;
 
   using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using node_type = typename TreeType::node_type;
+  using insert_return_type = InsertReturnType<iterator, node_type>;
+  using scan_iterator =
+      typename TreeType::template ScanIteratorBase<false>;
+  using scan_range = ScanRange<scan_iterator>;
+  using range_type = ScanRange<iterator>;
 
  public: /* Constructors */
   map() = default;
 
+  explicit map(const Compare &compare) : tree_(compare) {}
+
   map(std::initializer_list<value_type> const &items) {
-    for (const auto &item : items) {
-      insert(item);
-    }
+    tree_.Assign(items.begin(), items.end(), true);
   }
 
-  map(const map &other) {
-    iterator other_iterator = other.begin();
-    while (other_iterator != other.end()) {
-      insert(*other_iterator);
-      ++other_iterator;
-    }
+  /* Ranges sorted by key are built in O(n), the first of equal keys wins */
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  map(InputIt first, InputIt last) {
+    tree_.Assign(first, last, true);
   }
 
+  map(const map &other) : tree_(other.tree_) {}
+
   map(map &&other) noexcept { this->tree_ = std::move(other.tree_); }
 
   ~map() = default;
 
  public: /* Operators */
-  map<Key, T> &operator=(const map &other) {
-    if (this != &other) {
-      clear();
-      iterator other_iterator = other.begin();
-      while (other_iterator != other.end()) {
-        insert(*other_iterator);
-        ++other_iterator;
-      }
-    }
+  map &operator=(const map &other) {
+    tree_ = other.tree_;
     return *this;
   }
 
-  map<Key, T> &operator=(map &&other) noexcept {
+  map &operator=(map &&other) noexcept {
     if (this != &other) {
       tree_.Clear();
       tree_ = std::move(other.tree_);
@@ -67,17 +74,24 @@ class map {
   }
 
  public: /* Element access-mutate */
+  /* One descent, the mapped value is value-initialized in place on a miss */
   mapped_type &operator[](const key_type &key) {
-    iterator it = find(key);
-    if (it != end()) {
-      return it->second;
-    } else {
-      value_type default_value = std::make_pair(key, mapped_type());
-      insert(default_value);
-      return tree_.Search(default_value)->data_.second;
-    }
+    return try_emplace(key).first->second;
   }
 
+  mapped_type &operator[](key_type &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  /* Smallest and largest elements in O(1), the map must not be empty */
+  [[nodiscard]] reference front() { return *begin(); }
+
+  [[nodiscard]] const_reference front() const { return *begin(); }
+
+  [[nodiscard]] reference back() { return *std::prev(end()); }
+
+  [[nodiscard]] const_reference back() const { return *std::prev(end()); }
+
   T &at(const Key &key) {
     iterator it = find(key);
     if (it != end()) {
@@ -89,27 +103,93 @@ class map {
 
  public: /* Iterators */
   [[nodiscard]] iterator begin() const {
-    iterator iter(tree_.FindMinNode(tree_.GetRoot()), tree_.GetNil());
+    iterator iter(tree_.begin().base());
     return iter;
   }
 
   [[nodiscard]] iterator end() const {
-    iterator iter(tree_.GetNil(), tree_.GetNil());
+    iterator iter(tree_.GetNil());
     return iter;
   }
 
  public: /* Modifiers */
   void clear() { tree_.Clear(); }
 
+  /* Replaces the content in O(n), [first, last) must be sorted by key */
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    tree_.AssignSorted(first, last, true);
+  }
+
+  /* One descent, nothing is allocated when the key is present */
   std::pair<iterator, bool> insert(const pair_type &pair) {
-    std::pair<iterator, bool> result{};
-    result.first = find_by_key(pair.first);
-    if (result.first == end()) {
-      tree_.Insert(pair);
-      result.first = find_by_key(pair.first);
-      result.second = true;
-    }
-    return result;
+    auto [node, inserted] = tree_.InsertUnique(pair);
+    return {iterator(node), inserted};
+  }
+
+  std::pair<iterator, bool> insert(pair_type &&pair) {
+    auto [node, inserted] = tree_.InsertUnique(std::move(pair));
+    return {iterator(node), inserted};
+  }
+
+  /* Amortized O(1) when pair belongs right before hint, end() included */
+  iterator insert(const_iterator hint, const pair_type &pair) {
+    auto [node, inserted] = tree_.InsertHint(hint.base(), pair, true);
+    return iterator(node);
+  }
+
+  iterator insert(const_iterator hint, pair_type &&pair) {
+    auto [node, inserted] =
+        tree_.InsertHint(hint.base(), std::move(pair), true);
+    return iterator(node);
+  }
+
+  /* The pair is built in place inside its node, which is freed again when
+   * the key turns out to be present */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    auto [node, inserted] =
+        tree_.EmplaceHint(tree_.GetNil(), true, std::forward<Args>(args)...);
+    return {iterator(node), inserted};
+  }
+
+  /* Nothing is built and args are left untouched when the key is present */
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args) {
+    auto [node, inserted] = tree_.EmplaceIfAbsent(
+        key, std::piecewise_construct, std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    return {iterator(node), inserted};
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args) {
+    auto [node, inserted] = tree_.EmplaceIfAbsent(
+        key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+    return {iterator(node), inserted};
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    auto [node, inserted] =
+        tree_.EmplaceHint(hint.base(), true, std::forward<Args>(args)...);
+    return iterator(node);
+  }
+
+  /* Relinks the node of handle, on a duplicate key the handle is returned
+   * in the result untouched */
+  template <typename Tree = TreeType, typename = RequireNodeHandles<Tree>>
+  insert_return_type insert(node_type &&handle) {
+    auto [node, inserted] = tree_.InsertNode(tree_.GetNil(), handle, true);
+    return {iterator(node), inserted, std::move(handle)};
+  }
+
+  /* On a duplicate key the handle keeps its node */
+  template <typename Tree = TreeType, typename = RequireNodeHandles<Tree>>
+  iterator insert(const_iterator hint, node_type &&handle) {
+    auto [node, inserted] = tree_.InsertNode(hint.base(), handle, true);
+    return iterator(node);
   }
 
   std::pair<iterator, bool> insert(const Key &key, const T &data) {
@@ -117,54 +197,112 @@ class map {
     return insert(pair);
   }
 
-  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &data) {
-    iterator it = find(key);
-    if (it != end()) {
-      it->second = data;
-      return std::make_pair(it, false);
-    } else {
-      return insert(std::make_pair(key, data));
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, M &&data) {
+    auto result = try_emplace(key, std::forward<M>(data));
+    if (!result.second) {
+      result.first->second = std::forward<M>(data);
+      refresh(result.first);
     }
+    return result;
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key &&key, M &&data) {
+    auto result = try_emplace(std::move(key), std::forward<M>(data));
+    if (!result.second) {
+      result.first->second = std::forward<M>(data);
+      refresh(result.first);
+    }
+    return result;
   }
 
+  /* Every argument is forwarded into its own element */
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
-    std::initializer_list<pair_type> items = {std::forward<Args>(args)...};
     std::vector<std::pair<iterator, bool>> result{};
-
-    for (const_reference item : items) {
-      result.push_back(insert(item));
-    }
+    result.reserve(sizeof...(Args));
+    (result.push_back(emplace(std::forward<Args>(args))), ...);
     return result;
   }
 
+  /* Inserts an unsorted batch of pairs with one sort and one merge instead
+   * of a descent per element, see InsertBatch. The first of equal keys in
+   * the batch wins, present keys keep their mapped values. Returns how
+   * many keys were new */
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  size_type insert_batch(InputIt first, InputIt last) {
+    return InsertBatch<std::pair<Key, T>, PairFirstKey<pair_type>>(
+        tree_, first, last, true, nullptr);
+  }
+
+  /* Also writes the keys that were new to new_keys in order */
+  template <typename InputIt, typename OutputIt,
+            typename = RequireInputIterator<InputIt>>
+  size_type insert_batch(InputIt first, InputIt last, OutputIt new_keys) {
+    return InsertBatch<std::pair<Key, T>, PairFirstKey<pair_type>>(
+        tree_, first, last, true, new_keys);
+  }
+
   void erase(const pair_type &data) { tree_.Remove(data); }
 
-  void erase(const Key &key) {
-    auto iter = find(key);
-    if (iter != end()) {
-      tree_.Remove(*iter);
-    }
+  void erase(const Key &key) { tree_.RemoveByKey(key); }
+
+  /* Unlinks the node iter points to, no search from the root */
+  void erase(iterator iter) { tree_.Erase(iter.base()); }
+
+  /* Erases [first, last) in O(k + log n) and returns last */
+  iterator erase(iterator first, iterator last) {
+    return iterator(tree_.EraseRange(first.base(), last.base()));
   }
 
-  void erase(iterator iter) {
-    auto find_iter = find_by_pair(*iter);
-    if (find_iter != end()) {
-      tree_.Remove((*find_iter));
-    }
+  /* Erases the keys in [low, high), returns how many there were */
+  size_type erase_range(const Key &low, const Key &high) {
+    auto [first, last] = tree_.RangeBounds(low, high);
+    size_type old_size = size();
+    tree_.EraseRange(first, last);
+    return old_size - size();
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>,
+            typename = std::enable_if_t<!std::is_convertible_v<K, iterator>>>
+  void erase(const K &key) {
+    tree_.RemoveByKey(key);
   }
 
   void swap(map &other) { std::swap(tree_, other.tree_); }
 
-  void merge(map &other) {
-    auto temp_other{other};
-    for (const auto &item : other) {
-      auto insert_pair = insert(item);
-      if (insert_pair.second == true) {
-        temp_other.erase(*insert_pair.first);
-      }
+  /* Unlinks the element in O(log n) without copying or freeing it, an
+   * empty handle if there is nothing to extract. Node handles are left out
+   * with BTreeNodes */
+  template <typename Tree = TreeType, typename = RequireNodeHandles<Tree>>
+  node_type extract(const_iterator position) {
+    return tree_.Extract(position.base());
+  }
+
+  template <typename Tree = TreeType, typename = RequireNodeHandles<Tree>>
+  node_type extract(const Key &key) {
+    return tree_.Extract(tree_.SearchByKey(key));
+  }
+
+  /* Must follow every change of a mapped value made in place through an
+   * iterator, operator[] or at, so the aggregates see it. O(log n), a no-op
+   * without an Aggregate */
+  void refresh(iterator position) {
+    if constexpr (kAggregated) {
+      tree_.Refresh(position.base());
     }
-    other = temp_other;
+  }
+
+  /* Pre-allocates nodes so the next count inserts skip the heap, only
+   * SlabNodeAllocator keeps them */
+  void reserve_nodes(size_type count) { tree_.ReserveNodes(count); }
+
+  /* Moves the elements of other with new keys, the rest stay in other.
+   * Large merges with BTreeNodes or UncountedNodes take one O(n + m) pass
+   * on the calling thread and ignore thread_count */
+  void merge(map &other, std::size_t thread_count = 1) {
+    tree_.Merge(other.tree_, true, thread_count);
   }
 
  public: /* Capacity */
@@ -181,69 +319,161 @@ class map {
 
   [[nodiscard]] iterator find_by_pair(const pair_type &pair) const {
     auto node_to_find = tree_.Search(pair);
-    return iterator(node_to_find, tree_.GetNil());
+    return iterator(node_to_find);
   }
 
   [[nodiscard]] iterator find(const Key &key) const { return find_by_key(key); }
 
   [[nodiscard]] iterator find_by_key(const Key &key) const {
-    auto iter = begin();
-
-    while (iter != end()) {
-      if ((*iter).first == key) {
-        auto node = find_node_by_pair(*iter);
-        return iterator(node, tree_.GetNil());
-      }
-      ++iter;
-    }
-    return iterator(tree_.GetNil(), tree_.GetNil());
+    return iterator(tree_.SearchByKey(key));
   }
 
-  [[nodiscard]] std::pair<iterator, iterator> equal_range(
-      const Key &key) const {
-    auto lower = lower_bound(key);
-    auto upper = upper_bound(key);
-    return {lower, upper};
+  [[nodiscard]] size_type count(const Key &key) const {
+    return contains(key) ? 1 : 0;
   }
 
+  /* Bounds are O(log n) and end() when no key qualifies */
   [[nodiscard]] iterator lower_bound(const Key &key) const {
-    auto iter_node = find_by_key(key);
-    if (iter_node == end()) {
-      return begin();
-    }
-    auto lower = lower_bound_by_pair(*iter_node);
-    return lower;
+    return iterator(tree_.LowerBound(key));
   }
 
   [[nodiscard]] iterator upper_bound(const Key &key) const {
-    auto iter_node = find_by_key(key);
-    if (iter_node == end()) {
-      return begin();
-    }
-    auto upper = upper_bound_by_pair(*iter_node);
-    return upper;
+    return iterator(tree_.UpperBound(key));
   }
 
- private:
-  Node<pair_type> *find_node_by_pair(const pair_type &pair) const {
-    Node<pair_type> *node_to_find = tree_.Search(pair);
-    return node_to_find;
+  [[nodiscard]] std::pair<iterator, iterator> equal_range(
+      const Key &key) const {
+    auto [lower, upper] = tree_.EqualRange(key);
+    return {iterator(lower), iterator(upper)};
+  }
+
+  /* Heterogeneous lookups, only with a transparent Compare. The argument is
+   * compared against stored keys as is, no Key or pair is built */
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] iterator find(const K &key) const {
+    return iterator(tree_.SearchByKey(key));
   }
 
-  iterator lower_bound_by_pair(const pair_type &pair) const {
-    auto temp_iter = tree_.GetLowerBoundIteratorForMap(pair);
-    auto iter_node = find_by_pair(*temp_iter);
-    return iter_node;
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] bool contains(const K &key) const {
+    return tree_.SearchByKey(key) != tree_.GetNil();
   }
 
-  iterator upper_bound_by_pair(const pair_type &pair) const {
-    auto temp_iter = tree_.GetUpperBoundIteratorForMap(pair);
-    auto iter_node = find_by_pair(*temp_iter);
-    return iter_node;
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] size_type count(const K &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] iterator lower_bound(const K &key) const {
+    return iterator(tree_.LowerBound(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] iterator upper_bound(const K &key) const {
+    return iterator(tree_.UpperBound(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] std::pair<iterator, iterator> equal_range(const K &key) const {
+    auto [lower, upper] = tree_.EqualRange(key);
+    return {iterator(lower), iterator(upper)};
+  }
+
+ public: /* Observers */
+  [[nodiscard]] key_compare key_comp() const { return tree_.GetCompare(); }
+
+ public: /* Order statistics */
+  /* Number of keys less than the key */
+  [[nodiscard]] size_type rank(const Key &key) const {
+    return tree_.GetRank(key);
+  }
+
+  /* Zero-based k-th smallest element, end() if k >= size() */
+  [[nodiscard]] iterator select(size_type k) const {
+    return iterator(tree_.Select(k));
+  }
+
+  [[nodiscard]] iterator advance(iterator position, difference_type n) const {
+    return iterator(tree_.Advance(position.base(), n));
+  }
+
+  /* Number of keys in [low, high) */
+  [[nodiscard]] size_type count_range(const Key &low, const Key &high) const {
+    return tree_.CountRange(low, high);
+  }
+
+ public: /* Aggregates */
+  /* Aggregate of the mapped values with key in [low, high) in O(log n) */
+  [[nodiscard]] auto aggregate(const Key &low, const Key &high) const {
+    return tree_.Fold(low, high);
+  }
+
+  /* Aggregate of all mapped values in O(1) */
+  [[nodiscard]] auto aggregate() const { return tree_.Fold(); }
+
+ public: /* Statistics */
+  /* Work done by the tree since it was built or reset_stats, only with
+   * Stats = TreeStats */
+  [[nodiscard]] TreeCounters stats() const { return tree_.GetCounters(); }
+
+  void reset_stats() { tree_.ResetCounters(); }
+
+ public: /* Range scans */
+  /* Visits the elements with key in [low, high) in order, prefetching the
+   * next step. ThreadedNodes makes each step one link. Mapped values may
+   * be modified */
+  template <typename Function>
+  void for_each_range(const Key &low, const Key &high,
+                      Function function) const {
+    tree_.ForEachRange(low, high, function);
+  }
+
+  /* Forward range over [low, high) with the same prefetching */
+  [[nodiscard]] scan_range scan(const Key &low, const Key &high) const {
+    auto [first, last] = tree_.RangeBounds(low, high);
+    return {scan_iterator(first), scan_iterator(last)};
+  }
+
+  /* Bidirectional view of the keys in [low, high). Both ends are found
+   * up front, iterating then follows the node links without searching.
+   * Mapped values may be modified through it */
+  [[nodiscard]] range_type range(const Key &low, const Key &high) const {
+    auto [first, last] = tree_.RangeBounds(low, high);
+    return {iterator(first), iterator(last)};
+  }
+
+ public: /* Set algebra */
+  /* Each runs in O(m log(n / m + 1)) and relinks the nodes of other instead
+   * of copying them, pass an rvalue to skip the copy of other itself. Keys
+   * present in both maps keep the mapped value of this map.
+   * Large inputs are split by key range across thread_count threads. With
+   * BTreeNodes or UncountedNodes both are merged in one O(n + m) pass on
+   * the calling thread instead and thread_count is ignored */
+  void set_union(map other, std::size_t thread_count = 1) {
+    tree_.Combine(std::move(other.tree_), SetOperation::kUnion, true,
+                  thread_count);
+  }
+
+  void set_intersection(map other, std::size_t thread_count = 1) {
+    tree_.Combine(std::move(other.tree_), SetOperation::kIntersection, true,
+                  thread_count);
+  }
+
+  void set_difference(map other, std::size_t thread_count = 1) {
+    tree_.Combine(std::move(other.tree_), SetOperation::kDifference, true,
+                  thread_count);
+  }
+
+  void symmetric_difference(map other, std::size_t thread_count = 1) {
+    tree_.Combine(std::move(other.tree_), SetOperation::kSymmetricDifference,
+                  true, thread_count);
   }
 
  private:
-  RedBlackTree<pair_type> tree_;
+  static constexpr bool kAggregated = !std::is_same_v<Aggregate, NoAggregate>;
+
+  TreeType tree_;
 };
 
 }  // namespace s21
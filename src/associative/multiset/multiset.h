@@ -4,51 +4,57 @@
 #include "../set_base/set_base.h"
 
 namespace s21 {
-template <typename Key>
-class multiset : public set_base<Key> {
+template <typename Key, typename Compare, typename NodeAllocator,
+          typename Stats>
+class set;
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename NodeAllocator = HeapNodeAllocator,
+          typename Stats = NoTreeStats>
+class multiset : public set_base<Key, Compare, NodeAllocator, Stats> {
   using key_type = Key;
   using value_type = Key;
   using reference = value_type &;
   using const_reference = const value_type &;
 
-  using RedBlackTreeType = RedBlackTree<Key>;
-  using iterator = typename RedBlackTreeType::const_iterator;
-  using const_iterator = typename RedBlackTreeType::const_iterator;
+  using TreeType =
+      typename set_base<Key, Compare, NodeAllocator, Stats>::TreeType;
+  using iterator = typename TreeType::const_iterator;
+  using const_iterator = typename TreeType::const_iterator;
 
   using size_type = std::size_t;
 
+ public:
+  using node_type = typename TreeType::node_type;
+
  public: /* Member */
   multiset() = default;
 
   multiset(std::initializer_list<value_type> const &items) {
-    for (const auto &item : items) {
-      insert(item);
-    }
+    this->tree_.Assign(items.begin(), items.end(), false);
   };
 
-  multiset(const multiset &other) {
-    iterator other_iterator = other.begin();
-    while (other_iterator != other.end()) {
-      insert(*other_iterator);
-      ++other_iterator;
-    }
+  /* Sorted forward ranges are built in O(n) */
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  multiset(InputIt first, InputIt last) {
+    this->tree_.Assign(first, last, false);
   }
 
+  explicit multiset(const Compare &compare)
+      : set_base<Key, Compare, NodeAllocator, Stats>(compare) {}
+
+  multiset(const multiset &other)
+      : set_base<Key, Compare, NodeAllocator, Stats>(other) {}
+
   multiset(multiset &&other) noexcept { this->tree_ = std::move(other.tree_); }
 
  public: /* Operators */
-  multiset<Key> &operator=(const multiset &other) {
-    if (this != &other) {
-      iterator other_iterator = other.begin();
-      while (other_iterator != other.end()) {
-        insert(*other_iterator);
-        ++other_iterator;
-      }
-    }
+  multiset &operator=(const multiset &other) {
+    this->tree_ = other.tree_;
     return *this;
   }
 
-  multiset<Key> &operator=(multiset &&other) noexcept {
+  multiset &operator=(multiset &&other) noexcept {
     if (this != &other) {
       this->tree_.Clear();
       this->tree_ = std::move(other.tree_);
@@ -57,42 +63,117 @@ class multiset : public set_base<Key> {
   }
 
  public: /* Modifiers */
+  /* Replaces the content in O(n), [first, last) must be sorted */
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    this->tree_.AssignSorted(first, last, false);
+  }
+
   iterator insert(const value_type &value) {
     iterator result = this->tree_.Insert(value);
     return result;
   }
 
+  iterator insert(value_type &&value) {
+    return this->tree_.Insert(std::move(value));
+  }
+
+  /* Amortized O(1) when value belongs right before hint, end() included */
+  iterator insert(const_iterator hint, const value_type &value) {
+    auto [node, inserted] = this->tree_.InsertHint(hint.base(), value, false);
+    return iterator(node);
+  }
+
+  iterator insert(const_iterator hint, value_type &&value) {
+    auto [node, inserted] =
+        this->tree_.InsertHint(hint.base(), std::move(value), false);
+    return iterator(node);
+  }
+
+  /* The element is built in place inside its node */
+  template <typename... Args>
+  iterator emplace(Args &&...args) {
+    auto [node, inserted] = this->tree_.EmplaceHint(
+        this->tree_.GetNil(), false, std::forward<Args>(args)...);
+    return iterator(node);
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    auto [node, inserted] = this->tree_.EmplaceHint(
+        hint.base(), false, std::forward<Args>(args)...);
+    return iterator(node);
+  }
+
+  /* Relinks the node of handle, an empty handle yields end() */
+  template <typename Tree = TreeType, typename = RequireNodeHandles<Tree>>
+  iterator insert(node_type &&handle) {
+    auto [node, inserted] =
+        this->tree_.InsertNode(this->tree_.GetNil(), handle, false);
+    return iterator(node);
+  }
+
+  template <typename Tree = TreeType, typename = RequireNodeHandles<Tree>>
+  iterator insert(const_iterator hint, node_type &&handle) {
+    auto [node, inserted] = this->tree_.InsertNode(hint.base(), handle, false);
+    return iterator(node);
+  }
+
+  /* Every argument is forwarded into its own element */
   template <typename... Args>
   std::vector<iterator> insert_many(Args &&...args) {
-    std::initializer_list<value_type> items = {std::forward<Args>(args)...};
     std::vector<iterator> result{};
-
-    for (const_reference item : items) {
-      result.push_back(insert(item));
-    }
+    result.reserve(sizeof...(Args));
+    (result.push_back(emplace(std::forward<Args>(args))), ...);
     return result;
   }
 
-  void merge(multiset &other) {
-    for (const auto &item : other) {
-      insert(item);
-    }
-    other.clear();
+  /* Inserts an unsorted batch with one sort and one merge instead of a
+   * descent per element, equal elements keep their batch order. Returns
+   * the size of the batch */
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  size_type insert_batch(InputIt first, InputIt last) {
+    return InsertBatch<Key, IdentityKey<Key>>(this->tree_, first, last, false,
+                                              nullptr);
+  }
+
+  /* Moves every element of other in O(m log(n / m + 1)). Large merges
+   * with BTreeNodes or UncountedNodes take one O(n + m) pass on the calling
+   * thread and ignore thread_count */
+  void merge(multiset &other, std::size_t thread_count = 1) {
+    this->tree_.Merge(other.tree_, false, thread_count);
+  }
+
+  void merge(set<Key, Compare, NodeAllocator, Stats> &other,
+             std::size_t thread_count = 1) {
+    this->tree_.Merge(this->GetTree(other), false, thread_count);
+  }
+
+ public: /* Set algebra */
+  /* Each runs in O(m log(n / m + 1)) and relinks the nodes of other instead
+   * of copying them, pass an rvalue to skip the copy of other itself.
+   * Large inputs are split by key range across thread_count threads. With
+   * BTreeNodes or UncountedNodes both are merged in one O(n + m) pass on
+   * the calling thread instead and thread_count is ignored */
+  void set_union(multiset other, std::size_t thread_count = 1) {
+    this->tree_.Combine(std::move(other.tree_), SetOperation::kUnion, false,
+                        thread_count);
   }
 
- public: /* Lookup */
-  std::pair<iterator, iterator> equal_range(const value_type &data) const {
-    auto lower = lower_bound(data);
-    auto upper = upper_bound(data);
-    return {lower, upper};
+  void set_intersection(multiset other, std::size_t thread_count = 1) {
+    this->tree_.Combine(std::move(other.tree_), SetOperation::kIntersection,
+                        false, thread_count);
   }
 
-  iterator lower_bound(const value_type &data) const {
-    return this->tree_.GetLowerBoundIterator(data);
+  void set_difference(multiset other, std::size_t thread_count = 1) {
+    this->tree_.Combine(std::move(other.tree_), SetOperation::kDifference,
+                        false, thread_count);
   }
 
-  iterator upper_bound(const value_type &data) const {
-    return this->tree_.GetUpperBoundIterator(data);
+  void symmetric_difference(multiset other, std::size_t thread_count = 1) {
+    this->tree_.Combine(std::move(other.tree_),
+                        SetOperation::kSymmetricDifference, false,
+                        thread_count);
   }
 };
 }  // namespace s21
@@ -0,0 +1,141 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_PERSISTENT_MAP_PERSISTENT_MAP_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_PERSISTENT_MAP_PERSISTENT_MAP_H_
+
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "../persistent_tree/PersistentTree.h"
+#include "../red_black_tree/KeyOfValue.h"
+
+namespace s21 {
+/* Immutable map. insert and erase leave this version untouched and return
+ * a new one that shares all but O(log n) nodes with it. Copying is O(1),
+ * which makes every copy a consistent snapshot that other threads may
+ * read without locks while a writer keeps deriving new versions. Handing
+ * a version to another thread still needs the usual synchronization of
+ * the persistent_map object itself */
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class persistent_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using key_compare = Compare;
+
+  using TreeType = PersistentTree<value_type, PairFirstKey<value_type>,
+                                  Compare>;
+  using iterator = typename TreeType::const_iterator;
+  using const_iterator = typename TreeType::const_iterator;
+
+  using size_type = std::size_t;
+
+ public: /* Member */
+  persistent_map() = default;
+
+  explicit persistent_map(const Compare &compare) : tree_(compare) {}
+
+  /* Of equal keys the first one wins */
+  persistent_map(std::initializer_list<value_type> const &items) {
+    for (const value_type &item : items) {
+      tree_ = tree_.Insert(item, false);
+    }
+  }
+
+ public: /* Iterators */
+  /* Valid as long as any version sharing the element is alive */
+  [[nodiscard]] const_iterator begin() const { return tree_.begin(); }
+
+  [[nodiscard]] const_iterator end() const { return tree_.end(); }
+
+ public: /* Element access */
+  [[nodiscard]] const T &at(const Key &key) const {
+    const value_type *item = tree_.Search(key);
+    if (item == nullptr) {
+      throw std::out_of_range("Key is not found in the persistent_map");
+    }
+    return item->second;
+  }
+
+ public: /* Capacity */
+  [[nodiscard]] bool empty() const { return tree_.IsEmpty(); }
+
+  [[nodiscard]] size_type size() const { return tree_.GetSize(); }
+
+ public: /* Versions, each returns a new map and leaves this one as is */
+  /* The same version when the key is present */
+  [[nodiscard]] persistent_map insert(const value_type &value) const {
+    return persistent_map(tree_.Insert(value, false));
+  }
+
+  [[nodiscard]] persistent_map insert(const Key &key, const T &data) const {
+    return insert(value_type(key, data));
+  }
+
+  [[nodiscard]] persistent_map insert_or_assign(const Key &key,
+                                                const T &data) const {
+    return persistent_map(tree_.Insert(value_type(key, data), true));
+  }
+
+  /* The same version when the key is absent */
+  [[nodiscard]] persistent_map erase(const Key &key) const {
+    return persistent_map(tree_.Erase(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] persistent_map erase(const K &key) const {
+    return persistent_map(tree_.Erase(key));
+  }
+
+  [[nodiscard]] persistent_map clear() const {
+    return persistent_map(tree_.GetCompare());
+  }
+
+ public: /* Lookup */
+  [[nodiscard]] const_iterator find(const Key &key) const {
+    return tree_.Find(key);
+  }
+
+  [[nodiscard]] bool contains(const Key &key) const {
+    return tree_.Search(key) != nullptr;
+  }
+
+  [[nodiscard]] size_type count(const Key &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  /* First element with key not less than the given one, end() if none */
+  [[nodiscard]] const_iterator lower_bound(const Key &key) const {
+    return tree_.LowerBound(key);
+  }
+
+  /* Heterogeneous lookups, only with a transparent Compare */
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] const_iterator find(const K &key) const {
+    return tree_.Find(key);
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] bool contains(const K &key) const {
+    return tree_.Search(key) != nullptr;
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] const_iterator lower_bound(const K &key) const {
+    return tree_.LowerBound(key);
+  }
+
+ public: /* Observers */
+  [[nodiscard]] key_compare key_comp() const { return tree_.GetCompare(); }
+
+ private:
+  explicit persistent_map(TreeType tree) : tree_(std::move(tree)) {}
+
+  TreeType tree_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_PERSISTENT_MAP_PERSISTENT_MAP_H_
@@ -0,0 +1,116 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_PERSISTENT_SET_PERSISTENT_SET_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_PERSISTENT_SET_PERSISTENT_SET_H_
+
+#include <functional>
+#include <initializer_list>
+#include <utility>
+
+#include "../persistent_tree/PersistentTree.h"
+#include "../red_black_tree/KeyOfValue.h"
+
+namespace s21 {
+/* Immutable set, see persistent_map. insert and erase return a new
+ * version sharing all untouched nodes, copies are O(1) snapshots */
+template <typename Key, typename Compare = std::less<Key>>
+class persistent_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using const_reference = const value_type &;
+  using key_compare = Compare;
+  using value_compare = Compare;
+
+  using TreeType = PersistentTree<Key, IdentityKey<Key>, Compare>;
+  using iterator = typename TreeType::const_iterator;
+  using const_iterator = typename TreeType::const_iterator;
+
+  using size_type = std::size_t;
+
+ public: /* Member */
+  persistent_set() = default;
+
+  explicit persistent_set(const Compare &compare) : tree_(compare) {}
+
+  persistent_set(std::initializer_list<value_type> const &items) {
+    for (const value_type &item : items) {
+      tree_ = tree_.Insert(item, false);
+    }
+  }
+
+ public: /* Iterators */
+  /* Valid as long as any version sharing the element is alive */
+  [[nodiscard]] const_iterator begin() const { return tree_.begin(); }
+
+  [[nodiscard]] const_iterator end() const { return tree_.end(); }
+
+ public: /* Capacity */
+  [[nodiscard]] bool empty() const { return tree_.IsEmpty(); }
+
+  [[nodiscard]] size_type size() const { return tree_.GetSize(); }
+
+ public: /* Versions, each returns a new set and leaves this one as is */
+  /* The same version when the key is present */
+  [[nodiscard]] persistent_set insert(const value_type &value) const {
+    return persistent_set(tree_.Insert(value, false));
+  }
+
+  /* The same version when the key is absent */
+  [[nodiscard]] persistent_set erase(const key_type &key) const {
+    return persistent_set(tree_.Erase(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] persistent_set erase(const K &key) const {
+    return persistent_set(tree_.Erase(key));
+  }
+
+  [[nodiscard]] persistent_set clear() const {
+    return persistent_set(tree_.GetCompare());
+  }
+
+ public: /* Lookup */
+  [[nodiscard]] const_iterator find(const key_type &key) const {
+    return tree_.Find(key);
+  }
+
+  [[nodiscard]] bool contains(const key_type &key) const {
+    return tree_.Search(key) != nullptr;
+  }
+
+  [[nodiscard]] size_type count(const key_type &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  [[nodiscard]] const_iterator lower_bound(const key_type &key) const {
+    return tree_.LowerBound(key);
+  }
+
+  /* Heterogeneous lookups, only with a transparent Compare */
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] const_iterator find(const K &key) const {
+    return tree_.Find(key);
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] bool contains(const K &key) const {
+    return tree_.Search(key) != nullptr;
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] const_iterator lower_bound(const K &key) const {
+    return tree_.LowerBound(key);
+  }
+
+ public: /* Observers */
+  [[nodiscard]] key_compare key_comp() const { return tree_.GetCompare(); }
+
+  [[nodiscard]] value_compare value_comp() const { return tree_.GetCompare(); }
+
+ private:
+  explicit persistent_set(TreeType tree) : tree_(std::move(tree)) {}
+
+  TreeType tree_;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_PERSISTENT_SET_PERSISTENT_SET_H_
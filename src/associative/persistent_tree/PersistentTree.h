@@ -0,0 +1,412 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_PERSISTENT_TREE_PERSISTENT_TREE_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_PERSISTENT_TREE_PERSISTENT_TREE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+#include "../../sequence/vector/vector.h"
+#include "../red_black_tree/KeyCompare.h"
+
+namespace s21 {
+/* Immutable red-black tree. Nodes are never modified once built: an
+ * update copies the O(log n) nodes on the search path and shares every
+ * other subtree with the version it started from. Nodes carry an atomic
+ * reference count and are freed with the last version that reaches them,
+ * so copying a tree is O(1) and any version may be read by any number of
+ * threads without locks. Insertion follows Okasaki, deletion follows
+ * Kahrs ("Red-black trees with types", JFP 2001) */
+template <typename T, typename KeyOfValue, typename Compare>
+class PersistentTree : private KeyCompare<Compare> {
+  using KeyCompareBase = KeyCompare<Compare>;
+  using KeyCompareBase::Less;
+
+  struct Node;
+
+  /* Owning pointer to a shared node */
+  class NodeRef {
+   public:
+    NodeRef() = default;
+
+    /* Adopts a freshly built node whose count is already one */
+    explicit NodeRef(const Node *node) noexcept : node_(node) {}
+
+    NodeRef(const NodeRef &other) noexcept : node_(other.node_) {
+      if (node_ != nullptr) {
+        node_->references.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    NodeRef(NodeRef &&other) noexcept
+        : node_(std::exchange(other.node_, nullptr)) {}
+
+    NodeRef &operator=(NodeRef other) noexcept {
+      std::swap(node_, other.node_);
+      return *this;
+    }
+
+    ~NodeRef() {
+      if (node_ != nullptr &&
+          node_->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete node_;
+      }
+    }
+
+    [[nodiscard]] const Node *Get() const noexcept { return node_; }
+
+    const Node *operator->() const noexcept { return node_; }
+
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+
+   private:
+    const Node *node_{nullptr};
+  };
+
+  struct Node {
+    Node(bool is_red, NodeRef left_child, const T &data,
+         NodeRef right_child)
+        : red(is_red),
+          value(data),
+          left(std::move(left_child)),
+          right(std::move(right_child)) {}
+
+    mutable std::atomic<std::size_t> references{1};
+    bool red;
+    T value;
+    NodeRef left;
+    NodeRef right;
+  };
+
+ public:
+  using size_type = std::size_t;
+
+  /* In-order traversal with an explicit stack of the ancestors still to
+   * visit. Stays valid as long as some version holds the nodes */
+  class ConstIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const T *;
+    using reference = const T &;
+
+    ConstIterator() = default;
+
+    reference operator*() const { return path_.back()->value; }
+
+    pointer operator->() const { return &path_.back()->value; }
+
+    ConstIterator &operator++() {
+      const Node *node = path_.back();
+      path_.pop_back();
+      PushLeftmost(node->right.Get());
+      return *this;
+    }
+
+    ConstIterator operator++(int) {
+      ConstIterator copy{*this};
+      ++*this;
+      return copy;
+    }
+
+    bool operator==(const ConstIterator &other) const {
+      return Current() == other.Current();
+    }
+
+    bool operator!=(const ConstIterator &other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class PersistentTree;
+
+    [[nodiscard]] const Node *Current() const {
+      return path_.empty() ? nullptr : path_.back();
+    }
+
+    void PushLeftmost(const Node *node) {
+      for (; node != nullptr; node = node->left.Get()) {
+        path_.push_back(node);
+      }
+    }
+
+    vector<const Node *> path_;
+  };
+
+  using const_iterator = ConstIterator;
+
+ public:
+  PersistentTree() = default;
+
+  explicit PersistentTree(const Compare &compare) : KeyCompareBase(compare) {}
+
+  [[nodiscard]] const Compare &GetCompare() const noexcept {
+    return KeyCompareBase::GetCompare();
+  }
+
+  [[nodiscard]] size_type GetSize() const noexcept { return size_; }
+
+  [[nodiscard]] bool IsEmpty() const noexcept { return size_ == 0; }
+
+  [[nodiscard]] const_iterator begin() const {
+    const_iterator iter{};
+    iter.PushLeftmost(root_.Get());
+    return iter;
+  }
+
+  [[nodiscard]] const_iterator end() const { return {}; }
+
+  /* New version with value added. A present key keeps its element unless
+   * assign is set, then the tree itself is returned when nothing changes */
+  [[nodiscard]] PersistentTree Insert(const T &value, bool assign) const {
+    bool present = Search(KeyOfValue{}(value)) != nullptr;
+    if (present && !assign) {
+      return *this;
+    }
+    PersistentTree result{*this};
+    result.root_ = Paint(InsertInto(root_, value), false);
+    result.size_ += present ? 0 : 1;
+    return result;
+  }
+
+  /* New version without key, the tree itself when the key is absent */
+  template <typename K>
+  [[nodiscard]] PersistentTree Erase(const K &key) const {
+    if (Search(key) == nullptr) {
+      return *this;
+    }
+    PersistentTree result{*this};
+    result.root_ = EraseFrom(root_, key);
+    if (result.root_) {
+      result.root_ = Paint(result.root_, false);
+    }
+    --result.size_;
+    return result;
+  }
+
+  template <typename K>
+  [[nodiscard]] const T *Search(const K &key) const {
+    const Node *node = root_.Get();
+    while (node != nullptr) {
+      const auto &node_key = KeyOfValue{}(node->value);
+      if (Less(key, node_key)) {
+        node = node->left.Get();
+      } else if (Less(node_key, key)) {
+        node = node->right.Get();
+      } else {
+        return &node->value;
+      }
+    }
+    return nullptr;
+  }
+
+  template <typename K>
+  [[nodiscard]] const_iterator LowerBound(const K &key) const {
+    const_iterator iter{};
+    for (const Node *node = root_.Get(); node != nullptr;) {
+      if (Less(KeyOfValue{}(node->value), key)) {
+        node = node->right.Get();
+      } else {
+        iter.path_.push_back(node);
+        node = node->left.Get();
+      }
+    }
+    return iter;
+  }
+
+  template <typename K>
+  [[nodiscard]] const_iterator Find(const K &key) const {
+    const_iterator iter = LowerBound(key);
+    if (iter != end() && Less(key, KeyOfValue{}(*iter))) {
+      return end();
+    }
+    return iter;
+  }
+
+  /* Checks colors, black heights and the order of the keys */
+  [[nodiscard]] bool IsValid() const {
+    if (IsRed(root_)) {
+      return false;
+    }
+    const T *previous = nullptr;
+    for (const T &value : *this) {
+      if (previous != nullptr &&
+          !Less(KeyOfValue{}(*previous), KeyOfValue{}(value))) {
+        return false;
+      }
+      previous = &value;
+    }
+    return ValidateHelper(root_.Get()) >= 0;
+  }
+
+ private:
+  static NodeRef Make(bool red, NodeRef left, const T &value,
+                      NodeRef right) {
+    return NodeRef(new Node(red, std::move(left), value, std::move(right)));
+  }
+
+  static bool IsRed(const NodeRef &node) { return node && node->red; }
+
+  static bool IsBlack(const NodeRef &node) { return node && !node->red; }
+
+  static NodeRef Paint(const NodeRef &node, bool red) {
+    if (node->red == red) {
+      return node;
+    }
+    return Make(red, node->left, node->value, node->right);
+  }
+
+  /* Repairs a red-red violation below a black node, or a black node with
+   * two red children, by one rotation into a red node with black children */
+  static NodeRef Balance(const NodeRef &left, const T &value,
+                         const NodeRef &right) {
+    if (IsRed(left) && IsRed(right)) {
+      return Make(true, Paint(left, false), value, Paint(right, false));
+    }
+    if (IsRed(left) && IsRed(left->left)) {
+      return Make(true, Paint(left->left, false), left->value,
+                  Make(false, left->right, value, right));
+    }
+    if (IsRed(left) && IsRed(left->right)) {
+      return Make(true, Make(false, left->left, left->value, left->right->left),
+                  left->right->value,
+                  Make(false, left->right->right, value, right));
+    }
+    if (IsRed(right) && IsRed(right->right)) {
+      return Make(true, Make(false, left, value, right->left), right->value,
+                  Paint(right->right, false));
+    }
+    if (IsRed(right) && IsRed(right->left)) {
+      return Make(true, Make(false, left, value, right->left->left),
+                  right->left->value,
+                  Make(false, right->left->right, right->value, right->right));
+    }
+    return Make(false, left, value, right);
+  }
+
+  NodeRef InsertInto(const NodeRef &node, const T &value) const {
+    if (!node) {
+      return Make(true, {}, value, {});
+    }
+    const auto &key = KeyOfValue{}(value);
+    const auto &node_key = KeyOfValue{}(node->value);
+    if (Less(key, node_key)) {
+      NodeRef left = InsertInto(node->left, value);
+      return node->red ? Make(true, std::move(left), node->value, node->right)
+                       : Balance(left, node->value, node->right);
+    }
+    if (Less(node_key, key)) {
+      NodeRef right = InsertInto(node->right, value);
+      return node->red ? Make(true, node->left, node->value, std::move(right))
+                       : Balance(node->left, node->value, right);
+    }
+    return Make(node->red, node->left, value, node->right);
+  }
+
+  /* Below a black node the erased subtree comes back one black shorter and
+   * is rebalanced against its sibling on the way up */
+  template <typename K>
+  NodeRef EraseFrom(const NodeRef &node, const K &key) const {
+    if (!node) {
+      return {};
+    }
+    const auto &node_key = KeyOfValue{}(node->value);
+    if (Less(key, node_key)) {
+      NodeRef left = EraseFrom(node->left, key);
+      return IsBlack(node->left) ? BalanceLeft(left, node->value, node->right)
+                                 : Make(true, left, node->value, node->right);
+    }
+    if (Less(node_key, key)) {
+      NodeRef right = EraseFrom(node->right, key);
+      return IsBlack(node->right)
+                 ? BalanceRight(node->left, node->value, right)
+                 : Make(true, node->left, node->value, right);
+    }
+    return Join(node->left, node->right);
+  }
+
+  /* left is one black shorter than right */
+  static NodeRef BalanceLeft(const NodeRef &left, const T &value,
+                             const NodeRef &right) {
+    if (IsRed(left)) {
+      return Make(true, Paint(left, false), value, right);
+    }
+    if (IsBlack(right)) {
+      return Balance(left, value, Paint(right, true));
+    }
+    return Make(true, Make(false, left, value, right->left->left),
+                right->left->value,
+                Balance(right->left->right, right->value,
+                        Paint(right->right, true)));
+  }
+
+  /* right is one black shorter than left */
+  static NodeRef BalanceRight(const NodeRef &left, const T &value,
+                              const NodeRef &right) {
+    if (IsRed(right)) {
+      return Make(true, left, value, Paint(right, false));
+    }
+    if (IsBlack(left)) {
+      return Balance(Paint(left, true), value, right);
+    }
+    return Make(true,
+                Balance(Paint(left->left, true), left->value,
+                        left->right->left),
+                left->right->value,
+                Make(false, left->right->right, value, right));
+  }
+
+  /* Concatenates two subtrees of equal black height, every key of left is
+   * less than every key of right */
+  static NodeRef Join(const NodeRef &left, const NodeRef &right) {
+    if (!left) {
+      return right;
+    }
+    if (!right) {
+      return left;
+    }
+    if (left->red != right->red) {
+      return IsRed(right)
+                 ? Make(true, Join(left, right->left), right->value,
+                        right->right)
+                 : Make(true, left->left, left->value,
+                        Join(left->right, right));
+    }
+    bool red = left->red;
+    NodeRef middle = Join(left->right, right->left);
+    if (IsRed(middle)) {
+      return Make(true, Make(red, left->left, left->value, middle->left),
+                  middle->value,
+                  Make(red, middle->right, right->value, right->right));
+    }
+    if (red) {
+      return Make(true, left->left, left->value,
+                  Make(true, middle, right->value, right->right));
+    }
+    return BalanceLeft(left->left, left->value,
+                       Make(false, middle, right->value, right->right));
+  }
+
+  /* Black height of the subtree, -1 if it breaks an invariant */
+  int ValidateHelper(const Node *node) const {
+    if (node == nullptr) {
+      return 0;
+    }
+    if (node->red && (IsRed(node->left) || IsRed(node->right))) {
+      return -1;
+    }
+    int left_height = ValidateHelper(node->left.Get());
+    int right_height = ValidateHelper(node->right.Get());
+    if (left_height < 0 || left_height != right_height) {
+      return -1;
+    }
+    return left_height + (node->red ? 0 : 1);
+  }
+
+  NodeRef root_;
+  size_type size_{0};
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_PERSISTENT_TREE_PERSISTENT_TREE_H_
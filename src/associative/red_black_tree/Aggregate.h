@@ -0,0 +1,105 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_AGGREGATE_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_AGGREGATE_H_
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+/* An aggregate policy is a monoid over the elements of a subtree:
+ *   value_type                    the stored summary
+ *   static value_type Identity()  summary of no elements
+ *   static value_type Lift(v)     summary of one element
+ *   static value_type Combine(a, b)  summary of a followed by b
+ * Combine must be associative, it need not be commutative */
+struct NoAggregate {};
+
+template <typename V>
+struct SumAggregate {
+  using value_type = V;
+
+  static value_type Identity() { return value_type{}; }
+
+  static value_type Lift(const V &value) { return value; }
+
+  static value_type Combine(const value_type &a, const value_type &b) {
+    return a + b;
+  }
+};
+
+template <typename V>
+struct MinAggregate {
+  using value_type = V;
+
+  static value_type Identity() { return std::numeric_limits<V>::max(); }
+
+  static value_type Lift(const V &value) { return value; }
+
+  static value_type Combine(const value_type &a, const value_type &b) {
+    return b < a ? b : a;
+  }
+};
+
+template <typename V>
+struct MaxAggregate {
+  using value_type = V;
+
+  static value_type Identity() { return std::numeric_limits<V>::lowest(); }
+
+  static value_type Lift(const V &value) { return value; }
+
+  static value_type Combine(const value_type &a, const value_type &b) {
+    return a < b ? b : a;
+  }
+};
+
+template <typename V>
+struct CountAggregate {
+  using value_type = std::size_t;
+
+  static value_type Identity() { return 0; }
+
+  static value_type Lift(const V &) { return 1; }
+
+  static value_type Combine(value_type a, value_type b) { return a + b; }
+};
+
+/* Lifts the mapped value of a map element into Aggregate */
+template <typename Aggregate>
+struct MappedAggregate : Aggregate {
+  template <typename Pair>
+  static typename Aggregate::value_type Lift(const Pair &element) {
+    return Aggregate::Lift(element.second);
+  }
+};
+
+/* map without an aggregate keeps the plain tree */
+template <typename Aggregate>
+using MappedAggregateFor =
+    std::conditional_t<std::is_same_v<Aggregate, NoAggregate>, NoAggregate,
+                       MappedAggregate<Aggregate>>;
+
+/* Per-node summary of the subtree, empty without an aggregate */
+template <typename Aggregate>
+class AggregateSlot {
+ public:
+  using aggregate_type = typename Aggregate::value_type;
+
+  [[nodiscard]] const aggregate_type &GetAggregate() const noexcept {
+    return aggregate_;
+  }
+
+  void SetAggregate(aggregate_type aggregate) {
+    aggregate_ = std::move(aggregate);
+  }
+
+ private:
+  aggregate_type aggregate_{};
+};
+
+template <>
+class AggregateSlot<NoAggregate> {};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_AGGREGATE_H_
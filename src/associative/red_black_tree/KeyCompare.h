@@ -0,0 +1,58 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_KEY_COMPARE_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_KEY_COMPARE_H_
+
+#include <type_traits>
+
+namespace s21 {
+/* Holds the key comparator of RedBlackTree. Empty comparators such as
+ * std::less are inherited from, so they take no space in the tree */
+template <typename Compare,
+          bool = std::is_empty_v<Compare> && !std::is_final_v<Compare>>
+class KeyCompare : private Compare {
+ public:
+  KeyCompare() = default;
+
+  explicit KeyCompare(const Compare &compare) : Compare(compare) {}
+
+  [[nodiscard]] const Compare &GetCompare() const noexcept { return *this; }
+
+  template <typename Left, typename Right>
+  [[nodiscard]] bool Less(const Left &left, const Right &right) const {
+    return static_cast<bool>(Compare::operator()(left, right));
+  }
+};
+
+template <typename Compare>
+class KeyCompare<Compare, false> {
+ public:
+  KeyCompare() = default;
+
+  explicit KeyCompare(const Compare &compare) : compare_(compare) {}
+
+  [[nodiscard]] const Compare &GetCompare() const noexcept { return compare_; }
+
+  template <typename Left, typename Right>
+  [[nodiscard]] bool Less(const Left &left, const Right &right) const {
+    return static_cast<bool>(compare_(left, right));
+  }
+
+ private:
+  Compare compare_{};
+};
+
+/* Enables the heterogeneous lookup overloads for comparators that declare
+ * is_transparent, e.g. std::less<> */
+template <typename Compare, typename Key, typename = void>
+struct IsTransparent : std::false_type {};
+
+template <typename Compare, typename Key>
+struct IsTransparent<Compare, Key,
+                     std::void_t<typename Compare::is_transparent>>
+    : std::true_type {};
+
+template <typename Compare, typename Key>
+using RequireTransparent =
+    std::enable_if_t<IsTransparent<Compare, Key>::value>;
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_KEY_COMPARE_H_
@@ -0,0 +1,22 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_KEY_OF_VALUE_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_KEY_OF_VALUE_H_
+
+namespace s21 {
+/* Extracts the ordering key from a value stored in RedBlackTree.
+ * set and multiset order by the value itself, map orders by pair.first */
+template <typename T>
+struct IdentityKey {
+  const T &operator()(const T &value) const noexcept { return value; }
+};
+
+template <typename Pair>
+struct PairFirstKey {
+  /* Accepts any pair-like value, e.g. std::pair<Key, T> in range input */
+  template <typename OtherPair>
+  const auto &operator()(const OtherPair &pair) const noexcept {
+    return pair.first;
+  }
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_KEY_OF_VALUE_H_
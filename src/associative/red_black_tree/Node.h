@@ -1,34 +1,219 @@
 #ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_NODE_H_
 #define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_NODE_H_
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "Aggregate.h"
+#include "NodeAllocator.h"
+
 enum class Color {
   kNone = 0,
   kRed = 1 << 0,
   kBlack = 1 << 1,
 };
 
-template <typename T>
-struct Node {
-  T data_;
-  Color color_;
-  Node *parent_;
-  Node *left_;
-  Node *right_;
+namespace s21 {
+/* Links as plain pointers. Nodes are at least pointer aligned, so a
+ * pointer stored as a Word keeps its low bit free for the color */
+template <typename NodeType>
+struct PointerAddress {
+  using Link = NodeType *;
+  using Word = std::uintptr_t;
+  using Count = std::size_t;
+
+  static NodeType *ToNode(Link link) noexcept { return link; }
+
+  static Link ToLink(NodeType *node) noexcept { return node; }
+
+  static NodeType *FromWord(Word word) noexcept {
+    return reinterpret_cast<NodeType *>(word);
+  }
+
+  static Word ToWord(NodeType *node) noexcept {
+    return reinterpret_cast<Word>(node);
+  }
+};
+
+/* Links as 32-bit indices into the node arena of ArenaNodeAllocator, 0
+ * stands for nullptr. A Word shifts the index up to free the low bit */
+template <typename NodeType>
+struct IndexAddress {
+  using Link = std::uint32_t;
+  using Word = std::uint32_t;
+  using Count = std::uint32_t;
+
+  /* NodeType is complete only once these are instantiated */
+  static NodeType *ToNode(Link index) noexcept {
+    using Chunks = typename ArenaNodeAllocator::Pool<NodeType>::Chunks;
+    return static_cast<NodeType *>(Chunks::At(index));
+  }
+
+  static Link ToLink(const NodeType *node) noexcept {
+    using Chunks = typename ArenaNodeAllocator::Pool<NodeType>::Chunks;
+    return Chunks::IndexOf(node);
+  }
+
+  static NodeType *FromWord(Word word) noexcept { return ToNode(word >> 1); }
+
+  static Word ToWord(NodeType *node) noexcept { return ToLink(node) << 1; }
+};
+
+/* Parent and children. The color takes the low bit of the parent word */
+template <typename NodeType, typename Address>
+class TreeLinks {
+ public:
+  [[nodiscard]] NodeType *GetParent() const noexcept {
+    return Address::FromWord(parent_and_color_ & ~kRedBit);
+  }
+
+  void SetParent(NodeType *parent) noexcept {
+    parent_and_color_ = Address::ToWord(parent) | (parent_and_color_ & kRedBit);
+  }
+
+  [[nodiscard]] Color GetColor() const noexcept {
+    return (parent_and_color_ & kRedBit) != 0 ? Color::kRed : Color::kBlack;
+  }
+
+  void SetColor(Color color) noexcept {
+    parent_and_color_ = (parent_and_color_ & ~kRedBit) |
+                        (color == Color::kRed ? kRedBit : Word{0});
+  }
+
+  [[nodiscard]] NodeType *GetLeft() const noexcept {
+    return Address::ToNode(left_);
+  }
+
+  void SetLeft(NodeType *left) noexcept { left_ = Address::ToLink(left); }
+
+  [[nodiscard]] NodeType *GetRight() const noexcept {
+    return Address::ToNode(right_);
+  }
+
+  void SetRight(NodeType *right) noexcept { right_ = Address::ToLink(right); }
+
+ private:
+  using Word = typename Address::Word;
+  static constexpr Word kRedBit = 1;
+
+  Word parent_and_color_{};
+  typename Address::Link left_{};
+  typename Address::Link right_{};
+};
+
+/* Number of nodes in the subtree, 0 for nil. Uncounted nodes drop it and
+ * ignore SetSize, the tree then counts its elements itself */
+template <typename Count, bool kCounted>
+class CountSlot {
+ public:
+  void SetSize(std::size_t) noexcept {}
+};
+
+template <typename Count>
+class CountSlot<Count, true> {
+ public:
+  [[nodiscard]] std::size_t GetSize() const noexcept { return size_; }
+
+  void SetSize(std::size_t size) noexcept { size_ = static_cast<Count>(size); }
+
+ private:
+  Count size_{};
+};
+
+/* In-order threads: prev and next close a ring through the nil sentinel,
+ * so an iterator step never climbs the tree. Empty unless kThreaded */
+template <typename NodeType, typename Address, bool kThreaded>
+class ThreadLinks {};
+
+template <typename NodeType, typename Address>
+class ThreadLinks<NodeType, Address, true> {
+ public:
+  [[nodiscard]] NodeType *GetPrev() const noexcept {
+    return Address::ToNode(prev_);
+  }
+
+  void SetPrev(NodeType *prev) noexcept { prev_ = Address::ToLink(prev); }
+
+  [[nodiscard]] NodeType *GetNext() const noexcept {
+    return Address::ToNode(next_);
+  }
+
+  void SetNext(NodeType *next) noexcept { next_ = Address::ToLink(next); }
+
+ private:
+  typename Address::Link prev_{};
+  typename Address::Link next_{};
+};
+
+/* Layouts tell the tree how nodes address each other, whether they carry
+ * threads and whether they count their subtree. Node allocators pick one */
+struct PointerLayout {
+  template <typename NodeType>
+  using Address = PointerAddress<NodeType>;
+
+  static constexpr bool kThreaded = false;
+  static constexpr bool kCounted = true;
+};
+
+struct IndexLayout {
+  template <typename NodeType>
+  using Address = IndexAddress<NodeType>;
+
+  static constexpr bool kThreaded = false;
+  static constexpr bool kCounted = true;
+};
+
+/* Layout plus the prev and next threads, two more links per node */
+template <typename Layout>
+struct ThreadedLinks : Layout {
+  static constexpr bool kThreaded = true;
+};
+
+/* Layout without subtree counts, which gives up rank and select */
+template <typename Layout>
+struct UncountedLinks : Layout {
+  static constexpr bool kCounted = false;
+};
+}  // namespace s21
+
+/* data_ is only alive in element nodes, the nil sentinel never constructs
+ * a T. Whoever frees an element node destroys data_ first.
+ * Layout picks how links are stored, whether the nodes are threaded and
+ * whether they are counted, it comes from the node allocator.
+ * Aggregate adds a summary of the subtree, nothing for NoAggregate */
+template <typename T, typename Layout = s21::PointerLayout,
+          typename Aggregate = s21::NoAggregate>
+struct Node
+    : s21::TreeLinks<Node<T, Layout, Aggregate>,
+                     typename Layout::template Address<
+                         Node<T, Layout, Aggregate>>>,
+      s21::ThreadLinks<Node<T, Layout, Aggregate>,
+                       typename Layout::template Address<
+                           Node<T, Layout, Aggregate>>,
+                       Layout::kThreaded>,
+      s21::CountSlot<typename Layout::template Address<
+                         Node<T, Layout, Aggregate>>::Count,
+                     Layout::kCounted>,
+      s21::AggregateSlot<Aggregate> {
+  static constexpr bool kThreaded = Layout::kThreaded;
+  static constexpr bool kCounted = Layout::kCounted;
+
+  union {
+    T data_;
+  };
 
-  explicit Node(const T &data)
-      : data_(data),
-        color_(Color::kRed),
-        parent_(nullptr),
-        left_(nullptr),
-        right_(nullptr){};
+  template <typename... Args>
+  explicit Node(std::in_place_t, Args &&...args)
+      : data_(std::forward<Args>(args)...) {
+    this->SetColor(Color::kRed);
+    this->SetSize(1);
+  }
 
-  Node()
-      : color_(Color::kBlack),
-        parent_(nullptr),
-        left_(nullptr),
-        right_(nullptr){};
+  Node() { this->SetColor(Color::kBlack); }
 
-  ~Node() = default;
+  ~Node() {}
 };
 
-#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_NODE_H_
\ No newline at end of file
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_NODE_H_
@@ -0,0 +1,368 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_NODE_ALLOCATOR_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_NODE_ALLOCATOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+struct PointerLayout;
+struct IndexLayout;
+template <typename Layout>
+struct ThreadedLinks;
+template <typename Layout>
+struct UncountedLinks;
+
+/* Node allocators hand out raw storage for one tree node at a time,
+ * RedBlackTree constructs and destroys the node in place. Layout tells
+ * the tree how nodes link to each other */
+struct HeapNodeAllocator {
+  using Layout = PointerLayout;
+
+  template <typename NodeType>
+  static void *Allocate() {
+    return ::operator new(sizeof(NodeType));
+  }
+
+  template <typename NodeType>
+  static void Deallocate(void *node) noexcept {
+    ::operator delete(node);
+  }
+
+  template <typename NodeType>
+  static void Reserve(std::size_t) {}
+};
+
+inline constexpr std::size_t kCacheLineSize = 64;
+
+/* Chunk sources give SlabPool storage for a run of slots and report how
+ * many slots they gave, at least one */
+template <std::size_t SlotSize, std::size_t ChunkAlignment>
+struct HeapChunks {
+  static std::pair<unsigned char *, std::size_t> Allocate(std::size_t count) {
+    auto *chunk = static_cast<unsigned char *>(
+        ::operator new(count * SlotSize, std::align_val_t{ChunkAlignment}));
+    return {chunk, count};
+  }
+};
+
+/* Chunks of kChunkBytes aligned to their own size, so a slot address turns
+ * into a 32-bit index and back in O(1). The first slot of every chunk
+ * holds the chunk number, which also keeps index 0 free for nullptr */
+template <std::size_t SlotSize, std::size_t ChunkAlignment>
+class ArenaChunks {
+ public:
+  static std::pair<unsigned char *, std::size_t> Allocate(std::size_t) {
+    std::uint32_t number = chunk_count_.fetch_add(1, std::memory_order_relaxed);
+    if (number >= kMaxChunks) {
+      throw std::bad_alloc{};
+    }
+    auto *chunk = static_cast<unsigned char *>(
+        ::operator new(kChunkBytes, std::align_val_t{kChunkBytes}));
+    std::memcpy(chunk, &number, sizeof(number));
+    chunks_[number] = chunk;
+    return {chunk + SlotSize, kSlotsPerChunk - 1};
+  }
+
+  [[nodiscard]] static std::uint32_t IndexOf(const void *slot) noexcept {
+    if (slot == nullptr) {
+      return 0;
+    }
+    auto address = reinterpret_cast<std::uintptr_t>(slot);
+    std::uintptr_t offset = address & (kChunkBytes - 1);
+    std::uint32_t number{};
+    std::memcpy(&number, reinterpret_cast<const void *>(address - offset),
+                sizeof(number));
+    auto slot_number = static_cast<std::uint32_t>(offset / SlotSize);
+    return number << kIndexShift | slot_number;
+  }
+
+  [[nodiscard]] static void *At(std::uint32_t index) noexcept {
+    if (index == 0) {
+      return nullptr;
+    }
+    return chunks_[index >> kIndexShift] + (index & kSlotMask) * SlotSize;
+  }
+
+ private:
+  static constexpr std::size_t kChunkBytes = std::size_t{1} << 20;
+  static_assert(ChunkAlignment <= kChunkBytes && 2 * SlotSize <= kChunkBytes);
+
+  static constexpr std::size_t kSlotsPerChunk = kChunkBytes / SlotSize;
+
+  static constexpr std::uint32_t GetBitWidth(std::size_t value) {
+    std::uint32_t width = 0;
+    for (; value != 0; value >>= 1) {
+      ++width;
+    }
+    return width;
+  }
+
+  /* Indices keep 31 bits, the parent link spends one on the color */
+  static constexpr std::uint32_t kIndexShift = GetBitWidth(kSlotsPerChunk - 1);
+  static constexpr std::uint32_t kSlotMask = (1U << kIndexShift) - 1;
+  static constexpr std::size_t kMaxChunks =
+      std::min<std::size_t>(std::size_t{1} << (31 - kIndexShift), 4096);
+
+  inline static unsigned char *chunks_[kMaxChunks]{};
+  inline static std::atomic<std::uint32_t> chunk_count_{0};
+};
+
+/* Chunk sources whose slots have 32-bit indices. A free slot of theirs
+ * links to the next one by index, so it needs no pointer alignment */
+template <template <std::size_t, std::size_t> class ChunkSource>
+inline constexpr bool kIndexedChunks = false;
+
+template <>
+inline constexpr bool kIndexedChunks<ArenaChunks> = true;
+
+/* Fixed size slots carved out of cache-line-aligned chunks. Every thread
+ * keeps its own free list, so churn is served without locks. Surplus slots
+ * and the slots of exiting threads go to a shared list. Chunks live until
+ * the process exits, nodes may be freed by any thread */
+template <std::size_t SlotSize, std::size_t SlotAlignment,
+          template <std::size_t, std::size_t> class ChunkSource = HeapChunks>
+class SlabPool {
+ public:
+  static void *Allocate() {
+    LocalCache &cache = GetLocalCache();
+    if (cache.head_ == nullptr) {
+      Refill(cache, kSlotsPerChunk);
+    }
+    void *slot = cache.head_;
+    cache.head_ = GetNextFree(slot);
+    --cache.size_;
+    return slot;
+  }
+
+  static void Deallocate(void *slot) noexcept {
+    LocalCache &cache = GetLocalCache();
+    if (cache.retired_) {
+      ReturnToShared(slot, slot, 1);
+      return;
+    }
+    SetNextFree(slot, cache.head_);
+    cache.head_ = slot;
+    ++cache.size_;
+    if (cache.size_ > cache.limit_) {
+      ReleaseBatch(cache, cache.size_ - cache.limit_ / 2);
+    }
+  }
+
+  /* Makes sure the calling thread can allocate count slots without
+   * touching the heap */
+  static void Reserve(std::size_t count) {
+    LocalCache &cache = GetLocalCache();
+    cache.limit_ = std::max(cache.limit_, count);
+    if (cache.size_ < count) {
+      Refill(cache, count - cache.size_);
+    }
+  }
+
+ private:
+  /* What a free slot stores in its first bytes to name the next one */
+  using FreeLink = std::conditional_t<kIndexedChunks<ChunkSource>,
+                                      std::uint32_t, void *>;
+
+  struct LocalCache {
+    void *head_;
+    std::size_t size_;
+    std::size_t limit_;
+    bool retired_;
+  };
+
+  struct SharedPool {
+    std::mutex mutex_;
+    void *head_{nullptr};
+    std::size_t size_{0};
+  };
+
+  /* Flushes the thread cache into the shared list when the thread exits */
+  struct CacheFlusher {
+    ~CacheFlusher() {
+      LocalCache &cache = local_cache_;
+      ReleaseBatch(cache, cache.size_);
+      cache.retired_ = true;
+    }
+  };
+
+  static constexpr std::size_t kSlotAlignment =
+      std::max(SlotAlignment, alignof(FreeLink));
+  static constexpr std::size_t kSlotSize =
+      (std::max(SlotSize, sizeof(FreeLink)) + kSlotAlignment - 1) /
+      kSlotAlignment * kSlotAlignment;
+  static constexpr std::size_t kChunkAlignment =
+      std::max(kSlotAlignment, kCacheLineSize);
+  static constexpr std::size_t kSlotsPerChunk =
+      std::max<std::size_t>(16 * kCacheLineSize / kSlotSize, 8);
+  static constexpr std::size_t kDefaultLocalLimit = 4 * kSlotsPerChunk;
+
+ public:
+  /* Exposed for nodes that address their slots by index */
+  using Chunks = ChunkSource<kSlotSize, kChunkAlignment>;
+
+ private:
+  inline static thread_local LocalCache local_cache_{nullptr, 0,
+                                                     kDefaultLocalLimit, false};
+  inline static thread_local CacheFlusher cache_flusher_{};
+
+  static LocalCache &GetLocalCache() {
+    /* Touching the flusher registers its destructor for this thread */
+    static_cast<void>(&cache_flusher_);
+    return local_cache_;
+  }
+
+  /* Slots are raw storage, the link is copied in and out bytewise */
+  static void *GetNextFree(const void *slot) noexcept {
+    FreeLink link{};
+    std::memcpy(&link, slot, sizeof(link));
+    if constexpr (kIndexedChunks<ChunkSource>) {
+      return Chunks::At(link);
+    } else {
+      return link;
+    }
+  }
+
+  static void SetNextFree(void *slot, void *next) noexcept {
+    FreeLink link{};
+    if constexpr (kIndexedChunks<ChunkSource>) {
+      link = Chunks::IndexOf(next);
+    } else {
+      link = next;
+    }
+    std::memcpy(slot, &link, sizeof(link));
+  }
+
+  static SharedPool &GetSharedPool() {
+    /* Intentionally leaked: nodes may be freed during static destruction */
+    static SharedPool *shared_pool = new SharedPool{};
+    return *shared_pool;
+  }
+
+  static void Refill(LocalCache &cache, std::size_t count) {
+    {
+      SharedPool &shared = GetSharedPool();
+      std::lock_guard<std::mutex> lock(shared.mutex_);
+      while (count > 0 && shared.head_ != nullptr) {
+        void *slot = shared.head_;
+        shared.head_ = GetNextFree(slot);
+        --shared.size_;
+        SetNextFree(slot, cache.head_);
+        cache.head_ = slot;
+        ++cache.size_;
+        --count;
+      }
+    }
+    if (count > 0) {
+      AllocateChunk(cache, std::max(count, kSlotsPerChunk));
+    }
+  }
+
+  static void AllocateChunk(LocalCache &cache, std::size_t slot_count) {
+    while (slot_count > 0) {
+      auto [chunk, count] = Chunks::Allocate(slot_count);
+      /* Linked back to front so the first allocations are adjacent */
+      for (std::size_t i = count; i > 0; --i) {
+        void *slot = chunk + (i - 1) * kSlotSize;
+        SetNextFree(slot, cache.head_);
+        cache.head_ = slot;
+      }
+      cache.size_ += count;
+      slot_count -= std::min(slot_count, count);
+    }
+  }
+
+  static void ReleaseBatch(LocalCache &cache, std::size_t count) {
+    if (count == 0) {
+      return;
+    }
+    void *first = cache.head_;
+    void *last = first;
+    for (std::size_t i = 1; i < count; ++i) {
+      last = GetNextFree(last);
+    }
+    cache.head_ = GetNextFree(last);
+    cache.size_ -= count;
+    ReturnToShared(first, last, count);
+  }
+
+  static void ReturnToShared(void *first, void *last,
+                             std::size_t count) noexcept {
+    SharedPool &shared = GetSharedPool();
+    std::lock_guard<std::mutex> lock(shared.mutex_);
+    SetNextFree(last, shared.head_);
+    shared.head_ = first;
+    shared.size_ += count;
+  }
+};
+
+struct SlabNodeAllocator {
+  using Layout = PointerLayout;
+
+  template <typename NodeType>
+  static void *Allocate() {
+    return SlabPool<sizeof(NodeType), alignof(NodeType)>::Allocate();
+  }
+
+  template <typename NodeType>
+  static void Deallocate(void *node) noexcept {
+    SlabPool<sizeof(NodeType), alignof(NodeType)>::Deallocate(node);
+  }
+
+  template <typename NodeType>
+  static void Reserve(std::size_t count) {
+    SlabPool<sizeof(NodeType), alignof(NodeType)>::Reserve(count);
+  }
+};
+
+/* Slab allocation from the index-addressable arena. Nodes link through
+ * 32-bit indices instead of pointers and count their subtree in 32 bits,
+ * 16 bytes of links per node instead of 32. Slots keep the alignment of
+ * the node. Each node type reserves its arena in 1 MiB chunks */
+struct ArenaNodeAllocator {
+  using Layout = IndexLayout;
+
+  template <typename NodeType>
+  using Pool = SlabPool<sizeof(NodeType), alignof(NodeType), ArenaChunks>;
+
+  template <typename NodeType>
+  static void *Allocate() {
+    return Pool<NodeType>::Allocate();
+  }
+
+  template <typename NodeType>
+  static void Deallocate(void *node) noexcept {
+    Pool<NodeType>::Deallocate(node);
+  }
+
+  template <typename NodeType>
+  static void Reserve(std::size_t count) {
+    Pool<NodeType>::Reserve(count);
+  }
+};
+
+/* NodeAllocator whose nodes also carry in-order threads. Iterator steps
+ * and range scans then follow one link instead of climbing the tree, at
+ * two more links per node */
+template <typename NodeAllocator>
+struct ThreadedNodes : NodeAllocator {
+  using Layout = ThreadedLinks<typename NodeAllocator::Layout>;
+};
+
+/* NodeAllocator whose nodes carry no subtree count: one word less per
+ * pointer-linked node. rank, select and the other order statistics are
+ * unavailable, set algebra and merge fall back to a linear merge */
+template <typename NodeAllocator>
+struct UncountedNodes : NodeAllocator {
+  using Layout = UncountedLinks<typename NodeAllocator::Layout>;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_NODE_ALLOCATOR_H_
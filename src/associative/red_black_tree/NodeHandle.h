@@ -0,0 +1,93 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_NODE_HANDLE_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_NODE_HANDLE_H_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "Node.h"
+
+namespace s21 {
+template <typename T, typename KeyOfValue, typename Compare,
+          typename NodeAllocator, typename Aggregate, typename Stats>
+class RedBlackTree;
+
+template <typename T, typename KeyOfValue, typename Compare,
+          std::size_t kNodeBytes>
+class BTree;
+
+/* Owns a node extracted from a tree. The node can be inserted into any tree
+ * with the same value type and allocator without being copied or
+ * reallocated, otherwise the handle frees it */
+template <typename T, typename NodeAllocator,
+          typename Aggregate = NoAggregate>
+class NodeHandle {
+ public:
+  using value_type = T;
+
+  NodeHandle() noexcept = default;
+
+  NodeHandle(NodeHandle &&other) noexcept
+      : node_(std::exchange(other.node_, nullptr)) {}
+
+  NodeHandle &operator=(NodeHandle &&other) noexcept {
+    if (this != &other) {
+      Reset();
+      node_ = std::exchange(other.node_, nullptr);
+    }
+    return *this;
+  }
+
+  ~NodeHandle() { Reset(); }
+
+  [[nodiscard]] bool empty() const noexcept { return node_ == nullptr; }
+
+  explicit operator bool() const noexcept { return node_ != nullptr; }
+
+  /* Element access, the handle must not be empty */
+  [[nodiscard]] value_type &value() const { return node_->data_; }
+
+  /* Map handles only */
+  [[nodiscard]] const auto &key() const { return node_->data_.first; }
+
+  [[nodiscard]] auto &mapped() const { return node_->data_.second; }
+
+  void swap(NodeHandle &other) noexcept { std::swap(node_, other.node_); }
+
+ private:
+  template <typename, typename, typename, typename, typename, typename>
+  friend class RedBlackTree;
+
+  template <typename, typename, typename, std::size_t>
+  friend class BTree;
+
+  using NodeType = Node<T, typename NodeAllocator::Layout, Aggregate>;
+
+  explicit NodeHandle(NodeType *node) noexcept : node_(node) {}
+
+  NodeType *Release() noexcept { return std::exchange(node_, nullptr); }
+
+  void Reset() noexcept {
+    if (node_ != nullptr) {
+      std::destroy_at(std::addressof(node_->data_));
+      node_->~Node();
+      NodeAllocator::template Deallocate<NodeType>(node_);
+      node_ = nullptr;
+    }
+  }
+
+  NodeType *node_{nullptr};
+};
+
+/* Result of inserting a node handle into a container with unique keys. On
+ * a duplicate the handle comes back in node and position points at the
+ * element that blocked it */
+template <typename Iterator, typename NodeType>
+struct InsertReturnType {
+  Iterator position;
+  bool inserted;
+  NodeType node;
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_NODE_HANDLE_H_
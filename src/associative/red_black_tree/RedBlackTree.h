@@ -2,15 +2,103 @@
 #define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_RED_BLACK_TREE_H_
 
 #include <algorithm>
+#include <exception>
+#include <functional>
 #include <iostream>
 #include <iterator>
-
+#include <limits>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "KeyCompare.h"
+#include "KeyOfValue.h"
 #include "Node.h"
+#include "NodeAllocator.h"
+#include "NodeHandle.h"
+#include "TreeStats.h"
 
 namespace s21 {
-template <typename T>
-class RedBlackTree {
+template <typename Iterator>
+using RequireInputIterator = std::enable_if_t<std::is_convertible_v<
+    typename std::iterator_traits<Iterator>::iterator_category,
+    std::input_iterator_tag>>;
+
+enum class SetOperation {
+  kUnion,
+  kIntersection,
+  kDifference,
+  kSymmetricDifference
+};
+
+/* [first, last) of scan iterators, for a range-based for */
+template <typename Iterator>
+class ScanRange {
+ public:
+  ScanRange(Iterator first, Iterator last) : first_(first), last_(last) {}
+
+  [[nodiscard]] Iterator begin() const { return first_; }
+
+  [[nodiscard]] Iterator end() const { return last_; }
+
+ private:
+  Iterator first_;
+  Iterator last_;
+};
+
+/* Element count of a tree whose nodes are not counted, empty otherwise */
+template <bool kKept>
+class ElementCount {};
+
+template <>
+class ElementCount<true> {
+ public:
+  [[nodiscard]] std::size_t GetElementCount() const noexcept {
+    return count_;
+  }
+
+  void SetElementCount(std::size_t count) noexcept { count_ = count; }
+
+ private:
+  std::size_t count_{};
+};
+
+/* Keys are ordered by Compare, two keys are equal when neither is less.
+ * Lookups are templated on the key type, so a transparent Compare serves
+ * them without building a key_type. An Aggregate policy keeps a summary of
+ * every subtree for Fold, see Aggregate.h. Stats counts the work done,
+ * see TreeStats.h */
+template <typename T, typename KeyOfValue = IdentityKey<T>,
+          typename Compare = std::less<>,
+          typename NodeAllocator = HeapNodeAllocator,
+          typename Aggregate = NoAggregate, typename Stats = NoTreeStats>
+class RedBlackTree : private KeyCompare<Compare>,
+                     private Stats,
+                     private ElementCount<!NodeAllocator::Layout::kCounted> {
+  using KeyCompareBase = KeyCompare<Compare>;
+
+  /* Every key comparison of the tree goes through here */
+  template <typename Left, typename Right>
+  [[nodiscard]] bool Less(const Left &left, const Right &right) const {
+    Stats::OnCompare();
+    return KeyCompareBase::Less(left, right);
+  }
+
  public:
+  /* Link layout follows the node allocator */
+  using NodeType = Node<T, typename NodeAllocator::Layout, Aggregate>;
+
+  static constexpr bool kAggregated = !std::is_same_v<Aggregate, NoAggregate>;
+
+  /* Whether the nodes carry in-order threads, see ThreadedNodes */
+  static constexpr bool kThreaded = NodeType::kThreaded;
+
+  /* Whether the nodes count their subtree, see UncountedNodes */
+  static constexpr bool kCounted = NodeType::kCounted;
+
   template <bool IsConst>
   class RedBlackTreeIteratorBase {
    public:
@@ -26,65 +114,36 @@ class RedBlackTree {
    public:
     RedBlackTreeIteratorBase() = default;
 
-    explicit RedBlackTreeIteratorBase(Node<T> *node, Node<T> *nil)
-        : current_node_(node), nil_(nil){};
+    explicit RedBlackTreeIteratorBase(NodeType *node) : current_node_(node){};
+
+    /* Mutable iterators convert to const ones */
+    template <bool OtherIsConst,
+              typename = std::enable_if_t<IsConst && !OtherIsConst>>
+    RedBlackTreeIteratorBase(
+        const RedBlackTreeIteratorBase<OtherIsConst> &other)
+        : current_node_(other.current_node_) {}
 
    public:
+    /* O(1) amortized by climbing the tree, O(1) worst case along the
+     * threads of threaded nodes. --end() is the last element */
     RedBlackTreeIteratorBase &operator++() {
-      if (current_node_ == nullptr || current_node_ == nil_ ||
-          nil_ == nullptr) {
-        return *this;
-      }
-
-      if (current_node_->right_ != nil_) {
-        current_node_ = current_node_->right_;
-        while (current_node_->left_ != nil_) {
-          current_node_ = current_node_->left_;
-        }
-      } else {
-        while (current_node_->parent_ != nullptr &&
-               current_node_ == current_node_->parent_->right_) {
-          current_node_ = current_node_->parent_;
-        }
-        if (current_node_->parent_ != nullptr) {
-          current_node_ = current_node_->parent_;
-        } else {
-          current_node_ = nil_;
-        }
-      }
-
+      current_node_ = NextNode(current_node_);
       return *this;
     }
 
     RedBlackTreeIteratorBase &operator--() {
-      if (current_node_ == nil_) {
-        current_node_ = nil_->parent_;
-      } else {
-        if (current_node_->left_ != nil_ && current_node_->left_ != nullptr) {
-          current_node_ = current_node_->left_;
-          while (current_node_->right_ != nil_) {
-            current_node_ = current_node_->right_;
-          }
-        } else {
-          while (current_node_->parent_ != nullptr &&
-                 current_node_ == current_node_->parent_->left_) {
-            current_node_ = current_node_->parent_;
-          }
-          current_node_ = current_node_->parent_;
-        }
-      }
-
+      current_node_ = PrevNode(current_node_);
       return *this;
     }
 
     RedBlackTreeIteratorBase operator--(int) {
-      RedBlackTreeIteratorBase iter(current_node_, nil_);
+      RedBlackTreeIteratorBase iter(current_node_);
       --(*this);
       return iter;
     }
 
     RedBlackTreeIteratorBase operator++(int) {
-      RedBlackTreeIteratorBase iter(current_node_, nil_);
+      RedBlackTreeIteratorBase iter(current_node_);
       ++(*this);
       return iter;
     }
@@ -101,72 +160,126 @@ class RedBlackTree {
       return current_node_ != other.current_node_;
     }
 
+    [[nodiscard]] NodeType *base() const { return current_node_; }
+
+   private:
+    template <bool>
+    friend class RedBlackTreeIteratorBase;
+
+    NodeType *current_node_;
+  };
+
+  /* Forward iterator for bulk scans. Each step prefetches the first node
+   * the next step reads, so it is in cache by the time it is needed */
+  template <bool IsConst>
+  class ScanIteratorBase {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using pointer = std::conditional_t<IsConst, const T *, T *>;
+    using reference = std::conditional_t<IsConst, const T &, T &>;
+
+    ScanIteratorBase() = default;
+
+    explicit ScanIteratorBase(NodeType *node) : current_node_(node) {
+      PrefetchSuccessor(node);
+    }
+
+    ScanIteratorBase &operator++() {
+      current_node_ = NextNode(current_node_);
+      PrefetchSuccessor(current_node_);
+      return *this;
+    }
+
+    ScanIteratorBase operator++(int) {
+      ScanIteratorBase iter(*this);
+      ++(*this);
+      return iter;
+    }
+
+    reference operator*() const { return current_node_->data_; }
+
+    pointer operator->() const { return &current_node_->data_; }
+
+    bool operator==(const ScanIteratorBase &other) const {
+      return current_node_ == other.current_node_;
+    }
+
+    bool operator!=(const ScanIteratorBase &other) const {
+      return current_node_ != other.current_node_;
+    }
+
    private:
-    Node<T> *current_node_;
-    Node<T> *nil_;
+    NodeType *current_node_{};
   };
 
  public:
   using RedBlackTreeIterator = RedBlackTreeIteratorBase<false>;
   using RedBlackTreeConstIterator = RedBlackTreeIteratorBase<true>;
+  using mutable_iterator = RedBlackTreeIterator;
 
   using mapped_type = T;
+  using key_type = std::remove_cv_t<std::remove_reference_t<
+      decltype(KeyOfValue{}(std::declval<const T &>()))>>;
   using reference = T &;
   using const_reference = const T &;
   using iterator = RedBlackTreeConstIterator;
   using const_iterator = RedBlackTreeConstIterator;
   using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using node_type = NodeHandle<T, NodeAllocator, Aggregate>;
+  using key_compare = Compare;
 
   RedBlackTree() = default;
 
+  explicit RedBlackTree(const Compare &compare) : KeyCompareBase(compare) {}
+
   RedBlackTree(std::initializer_list<T> const &items) {
-    for (const auto &item : items) {
-      Insert(item);
-    }
+    Assign(items.begin(), items.end(), false);
   }
 
-  RedBlackTree(const RedBlackTree &other) {
-    iterator other_iter = other.begin();
-    while (other_iter != other.end()) {
-      Insert(*other_iter);
-      ++other_iter;
-    }
+  /* Counters of Stats stay with other */
+  RedBlackTree(const RedBlackTree &other) : KeyCompareBase(other), Stats() {
+    CloneFrom(other, nullptr);
   }
 
-  RedBlackTree(RedBlackTree &&other) {
+  RedBlackTree(RedBlackTree &&other) : KeyCompareBase(other), Stats() {
     root_ = other.root_;
-    delete nil_;
+    SetUncountedSize(other.GetSize());
+    DestroyNil(nil_);
     nil_ = other.nil_;
-    other.nil_ = new Node<T>{};
-    other.root_ = other.nil_;
+    other.nil_ = CreateNil();
+    other.ResetToEmpty();
   }
 
   ~RedBlackTree() {
     Clear();
-    delete nil_;
-    nil_ = nullptr;
-    root_ = nil_;
+    DestroyNil(nil_);
+    root_ = nil_ = nullptr;
   }
 
+  /* Reuses the nodes already owned by this tree for the copy */
   RedBlackTree &operator=(const RedBlackTree &other) {
     if (this != &other) {
-      Clear();
-      iterator other_iter = other.begin();
-      while (other_iter != other.end()) {
-        Insert(*other_iter);
-        ++other_iter;
-      }
+      KeyCompareBase::operator=(other);
+      NodeType *reusable = DetachNodes();
+      ResetToEmpty();
+      CloneFrom(other, reusable);
     }
     return *this;
   }
 
   RedBlackTree &operator=(RedBlackTree &&other) {
     if (this != &other) {
+      Clear();
+      KeyCompareBase::operator=(other);
       root_ = other.root_;
-      delete nil_; /* Need to free already allocated for nil_ memory */
+      SetUncountedSize(other.GetSize());
+      DestroyNil(nil_);
       nil_ = other.nil_;
-      other.nil_ = new Node<T>{};
-      other.root_ = other.nil_;
+      other.nil_ = CreateNil();
+      other.ResetToEmpty();
     }
     return *this;
   }
@@ -192,420 +305,2282 @@ class RedBlackTree {
   }
 
  public:
-  [[nodiscard]] iterator GetLowerBoundIterator(const T &key) const {
-    iterator lower_bound_iter = --end();
-    for (iterator it = begin(); it != end(); ++it) {
-      if (*it >= key) {
-        lower_bound_iter = it;
-        break;
-      }
-    }
-    return lower_bound_iter;
+  [[nodiscard]] size_type GetMaxSize() const {
+    std::allocator<mapped_type> memory;
+    return std::min(memory.max_size(), std::numeric_limits<size_type>::max());
   }
 
-  [[nodiscard]] iterator GetLowerBoundIteratorForMap(const T &pair) const {
-    iterator lower_bound_iter = --end();
-    for (iterator it = begin(); it != end(); ++it) {
-      if ((*it).first >= pair.first) {
-        lower_bound_iter = it;
-        break;
-      }
+  [[nodiscard]] bool IsEmpty() const { return root_ == nil_; }
+
+  [[nodiscard]] size_type GetSize() const {
+    if constexpr (kCounted) {
+      return root_->GetSize();
+    } else {
+      return this->GetElementCount();
     }
-    return lower_bound_iter;
   }
 
-  [[nodiscard]] iterator GetUpperBoundIterator(const T &key) const {
-    iterator upper_bound_iter = --end();
-    for (iterator it = begin(); it != end(); ++it) {
-      if (*it > key) {
-        upper_bound_iter = it;
-        break;
-      }
+  [[nodiscard]] NodeType *GetRoot() const { return root_; }
+
+  [[nodiscard]] NodeType *GetNil() const { return nil_; }
+
+  [[nodiscard]] const Compare &GetCompare() const noexcept {
+    return KeyCompareBase::GetCompare();
+  }
+
+  /* Pre-allocates storage so the next count inserts skip the heap */
+  void ReserveNodes(size_type count) {
+    NodeAllocator::template Reserve<NodeType>(count);
+  }
+
+  /* Smallest and largest nodes in O(1), nil_ for an empty tree. nil_ keeps
+   * them in its left and parent links, or closes the thread ring */
+  [[nodiscard]] NodeType *GetLeftmost() const {
+    if constexpr (kThreaded) {
+      return nil_->GetNext();
+    } else {
+      return nil_->GetLeft();
     }
-    return upper_bound_iter;
   }
 
-  [[nodiscard]] iterator GetUpperBoundIteratorForMap(const T &pair) const {
-    iterator upper_bound_iter = --end();
-    for (iterator it = begin(); it != end(); ++it) {
-      if ((*it).first > pair.first) {
-        upper_bound_iter = it;
-        break;
-      }
+  [[nodiscard]] NodeType *GetRightmost() const {
+    if constexpr (kThreaded) {
+      return nil_->GetPrev();
+    } else {
+      return nil_->GetParent();
     }
-    return upper_bound_iter;
   }
 
-  [[nodiscard]] size_type GetMaxSize() const {
-    std::allocator<mapped_type> memory;
-    return std::min(memory.max_size(), std::numeric_limits<size_type>::max());
+  void Clear() {
+    ClearHelper(root_);
+    ResetToEmpty();
   }
 
-  [[nodiscard]] bool IsEmpty() const { return root_ == nil_; }
+  /* Replaces the content with [first, last). Sorted forward ranges are
+   * built in O(n), anything else falls back to one Insert per element.
+   * With unique set only the first element of equal keys is kept */
+  template <typename InputIt>
+  void Assign(InputIt first, InputIt last, bool unique) {
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+      if (IsSortedRange(first, last)) {
+        AssignSorted(first, last, unique);
+        return;
+      }
+    }
+    Clear();
+    for (; first != last; ++first) {
+      if (!unique || SearchByKey(KeyOfValue{}(*first)) == nil_) {
+        Insert(*first);
+      }
+    }
+  }
 
-  [[nodiscard]] size_type GetSize() const { return SizeHelper(root_); }
+  /* Trusts [first, last) to be sorted by key and builds a perfectly
+   * balanced tree in O(n) without comparisons against the tree */
+  template <typename ForwardIt>
+  void AssignSorted(ForwardIt first, ForwardIt last, bool unique) {
+    Clear();
+    size_type count = 0;
+    for (ForwardIt iter = first; iter != last; ++iter) {
+      ++count;
+    }
+    ReserveNodes(count);
+
+    /* Nodes are created up front and chained through the right links, so
+     * a throwing constructor leaves nothing behind */
+    NodeType *chain = nullptr;
+    NodeType *chain_tail = nullptr;
+    count = 0;
+    try {
+      for (ForwardIt previous = first; first != last; previous = first++) {
+        if (unique && count != 0 &&
+            !Less(KeyOfValue{}(*previous), KeyOfValue{}(*first))) {
+          continue;
+        }
+        AppendToChain(chain, chain_tail, CreateNode(*first));
+        ++count;
+      }
+    } catch (...) {
+      DestroyChain(chain, count);
+      throw;
+    }
+    AdoptSubtree(BuildSubtree(chain, count));
+    SetUncountedSize(count);
+  }
 
-  [[nodiscard]] Node<T> *GetRoot() const { return root_; }
+  /* Equal keys go after the ones already present. Keys past either end
+   * of the tree are linked without a descent from the root */
+  iterator Insert(const T &data) {
+    return iterator(InsertValue(nil_, data, false).first);
+  }
 
-  [[nodiscard]] Node<T> *GetNil() const { return nil_; }
+  iterator Insert(T &&data) {
+    return iterator(InsertValue(nil_, std::move(data), false).first);
+  }
 
-  void Clear() {
-    ClearHelper(root_);
-    nil_->parent_ = nullptr;
-    root_ = nil_;
+  /* Returns the node holding the key and whether it was inserted. Nothing
+   * is allocated when the key is present */
+  std::pair<NodeType *, bool> InsertUnique(const T &data) {
+    return InsertValue(nil_, data, true);
   }
 
-  iterator Insert(const T &data) {
-    Node<T> *new_node = new Node<T>(data);
-    new_node->parent_ = nullptr;
-    new_node->left_ = nil_;
-    new_node->right_ = nil_;
-    new_node->color_ = Color::kRed;
+  std::pair<NodeType *, bool> InsertUnique(T &&data) {
+    return InsertValue(nil_, std::move(data), true);
+  }
 
-    InsertNode(new_node);
-    iterator new_iterator(new_node, nil_);
-    return new_iterator;
+  /* Inserts as close as possible before hint. A correct hint costs O(1)
+   * comparisons and amortized O(1) rebalancing, a wrong one falls back to
+   * a plain insert */
+  std::pair<NodeType *, bool> InsertHint(NodeType *hint, const T &data,
+                                        bool unique) {
+    return InsertValue(hint, data, unique);
   }
 
-  void Remove(const T &data) {
-    auto node_to_remove = Search(data);
-    if (node_to_remove != nullptr) {
-      RemoveNode(node_to_remove);
-    }
+  std::pair<NodeType *, bool> InsertHint(NodeType *hint, T &&data,
+                                        bool unique) {
+    return InsertValue(hint, std::move(data), unique);
   }
 
- public:
-  [[maybe_unused]] void PrintTree() const {
-    if (root_ != nil_) {
-      PrintHelper(root_, "", true);
+  /* Inserts the next element of a sequence sorted by key. finger is the
+   * node returned for the previous element, nil_ for the first one. The
+   * search climbs from finger only until the key fits below, so nearby
+   * keys cost O(log d) comparisons for d nodes in between. data is left
+   * untouched when unique meets an equal key */
+  template <typename Value>
+  std::pair<NodeType *, bool> InsertAfter(NodeType *finger, Value &&data,
+                                          bool unique) {
+    const auto &key = KeyOfValue{}(data);
+    InsertPosition position{};
+    if (finger == nil_ || finger == nullptr) {
+      position = FindInsertPosition(key, unique);
     } else {
-      std::cerr << "Tree is IsEmpty\n";
+      while (finger->GetParent() != nullptr &&
+             !(finger == finger->GetParent()->GetLeft() &&
+               Less(key, KeyOfValue{}(finger->GetParent()->data_)))) {
+        finger = finger->GetParent();
+      }
+      position = DescendToPosition(finger, key, unique);
+    }
+    if (position.existing != nullptr) {
+      return {position.existing, false};
     }
+    return {LinkNode(CreateNode(std::forward<Value>(data)), position), true};
   }
 
- public:
-  [[nodiscard]] Node<T> *Search(const T &key) const {
-    return FindNode(root_, key);
+  /* Looks the key up first and builds the element from args only when it
+   * is absent, so args are left untouched on a duplicate */
+  template <typename... Args>
+  std::pair<NodeType *, bool> EmplaceIfAbsent(const key_type &key,
+                                             Args &&...args) {
+    InsertPosition position = FindInsertPosition(key, true);
+    if (position.existing != nullptr) {
+      return {position.existing, false};
+    }
+    return {LinkNode(CreateNode(std::forward<Args>(args)...), position), true};
   }
 
- public:
-  [[nodiscard]] const_iterator begin() const noexcept {
-    return RedBlackTreeConstIterator(FindMinNode(root_), nil_);
+  /* Same as InsertHint, the value is built in place from args first */
+  template <typename... Args>
+  std::pair<NodeType *, bool> EmplaceHint(NodeType *hint, bool unique,
+                                         Args &&...args) {
+    NodeType *new_node = CreateNode(std::forward<Args>(args)...);
+    InsertPosition position =
+        FindHintedPosition(hint, KeyOfValue{}(new_node->data_), unique);
+    if (position.existing != nullptr) {
+      DestroyNode(new_node);
+      return {position.existing, false};
+    }
+    return {LinkNode(new_node, position), true};
   }
 
-  [[nodiscard]] const_iterator end() const noexcept {
-    return RedBlackTreeConstIterator(nil_, nil_);
+  /* Links the node owned by handle as close as possible before hint, pass
+   * nil_ for no hint. With unique set and the key present nothing happens
+   * and the handle keeps its node. Empty handles yield nil_. A linked node
+   * counts as allocated by this tree */
+  std::pair<NodeType *, bool> InsertNode(NodeType *hint, node_type &handle,
+                                        bool unique) {
+    if (handle.empty()) {
+      return {nil_, false};
+    }
+    InsertPosition position =
+        FindHintedPosition(hint, KeyOfValue{}(handle.value()), unique);
+    if (position.existing != nullptr) {
+      return {position.existing, false};
+    }
+    Stats::OnAllocate();
+    return {LinkNode(handle.Release(), position), true};
   }
 
-  Node<T> *FindMinNode(Node<T> *root) const {
-    while (root->left_ != nil_ && root->left_ != nullptr) {
-      root = root->left_;
+  /* Unlinks the node in O(log n) and hands it over without destroying it,
+   * nil_ gives an empty handle. The node counts as freed by this tree, the
+   * handle owns it from now on */
+  node_type Extract(NodeType *node) {
+    if (node == nil_ || node == nullptr) {
+      return node_type{};
     }
-    return root;
+    UnlinkNode(node);
+    node->SetParent(nullptr);
+    node->SetLeft(nullptr);
+    node->SetRight(nullptr);
+    if constexpr (kThreaded) {
+      node->SetPrev(nullptr);
+      node->SetNext(nullptr);
+    }
+    Stats::OnDeallocate();
+    return node_type{node};
   }
 
-  Node<T> *FindMaxNode(Node<T> *root) const {
-    while (root->right_ != nil_) {
-      root = root->right_;
+  /* Destroys the node without searching for it again: the unlink and the
+   * fix-up cost amortized O(1) rotations. nil_ is ignored */
+  void Erase(NodeType *node) {
+    if (node != nil_ && node != nullptr) {
+      RemoveNode(node);
     }
-    return root;
   }
 
- private:
-  Node<T> *nil_{new Node<T>{}};
-  Node<T> *root_{nil_};
+  void Remove(const T &data) { RemoveByKey(KeyOfValue{}(data)); }
 
- private:
-  [[nodiscard]] size_type SizeHelper(Node<T> *node) const {
-    if (node == nil_) {
-      return 0;
+  template <typename K>
+  void RemoveByKey(const K &key) {
+    auto node_to_remove = SearchByKey(key);
+    if (node_to_remove != nil_) {
+      RemoveNode(node_to_remove);
     }
-    return 1 + SizeHelper(node->left_) + SizeHelper(node->right_);
   }
 
-  void ClearHelper(Node<T> *node) {
-    if (node != nil_) {
-      ClearHelper(node->left_);
-      ClearHelper(node->right_);
-      delete node;
-      node = nullptr;
+  /* Destroys the nodes in [first, last) and returns last. A range shorter
+   * than the tree height is unlinked node by node, a longer one is split
+   * off by rank and the two remaining parts are joined, O(k + log n).
+   * Uncounted trees always go node by node, O(k) amortized */
+  NodeType *EraseRange(NodeType *first, NodeType *last) {
+    if constexpr (kCounted) {
+      size_type offset = GetNodeRank(first);
+      size_type count = GetNodeRank(last) - offset;
+      if (count > GetFloorLog2(GetSize() + 1)) {
+        Subtree tree = AsSubtree();
+        ResetToEmpty();
+        auto [head, rest] = SplitAt(tree, offset);
+        auto [erased, tail] = SplitAt(rest, count);
+        ClearHelper(erased.root);
+        AdoptSubtree(Join(head, tail));
+        return last;
+      }
     }
+    while (first != last) {
+      NodeType *next = NextNode(first);
+      RemoveNode(first);
+      first = next;
+    }
+    return last;
   }
 
-  void LeftRotate(Node<T> *node) {
-    Node<T> *y = node->right_;
-    node->right_ = y->left_;
-
-    if (y->left_ != nil_) {
-      y->left_->parent_ = node;
+  /* Combines this tree with other, both sorted by key, in
+   * O(m log(n / m + 1)) where m is the smaller size. Nodes of other are
+   * relinked into this tree, never copied, and other is left empty. On
+   * equal keys elements of this tree win. Without unique the multiset
+   * rules of std::set_union and friends apply: max, min and difference of
+   * the multiplicities. With thread_count above one the key range is split
+   * into independent subproblems that run on worker threads. A throwing
+   * comparison on the split path, on any thread, leaves both trees empty.
+   * Uncounted trees merge both in order instead, O(n + m) on one thread */
+  void Combine(RedBlackTree &&other, SetOperation operation, bool unique,
+               std::size_t thread_count = 1) {
+    if (this == &other) {
+      if (operation == SetOperation::kDifference ||
+          operation == SetOperation::kSymmetricDifference) {
+        Clear();
+      }
+      return;
     }
-    y->parent_ = node->parent_;
-
-    if (node->parent_ == nullptr) {
-      root_ = y;
-    } else if (node == node->parent_->left_) {
-      node->parent_->left_ = y;
+    if (unique && operation != SetOperation::kIntersection &&
+        PrefersPointwise(other.GetSize())) {
+      CombinePointwise(other, operation);
+      return;
+    }
+    if constexpr (kCounted) {
+      Subtree first = AsSubtree();
+      Subtree second = TakeOver(other);
+      ResetToEmpty();
+      AdoptSubtree(
+          CombineSubtrees(first, second, operation, unique, thread_count));
     } else {
-      node->parent_->right_ = y;
+      CombineInOrder(other, operation);
     }
-
-    y->left_ = node;
-    node->parent_ = y;
   }
 
-  void RightRotate(Node<T> *node) {
-    Node<T> *x = node->left_;
-    node->left_ = x->right_;
-
-    if (x->right_ != nil_) {
-      x->right_->parent_ = node;
+  /* Moves the elements of other into this tree in O(m log(n / m + 1)).
+   * With unique set elements whose key is already present stay in other.
+   * Clear other_unique when other may repeat keys, its repeats then stay
+   * in other as well. A throwing comparison on the split path may leave
+   * both trees empty. Uncounted trees merge in order, O(n + m) */
+  void Merge(RedBlackTree &other, bool unique, std::size_t thread_count = 1,
+             bool other_unique = true) {
+    if (this == &other) {
+      return;
     }
-    x->parent_ = node->parent_;
-
-    if (node->parent_ == nullptr) {
-      root_ = x;
-    } else if (node == node->parent_->left_) {
-      node->parent_->left_ = x;
+    if (PrefersPointwise(other.GetSize())) {
+      MergePointwise(other, unique);
+      return;
+    }
+    if constexpr (!kCounted) {
+      MergeInOrder(other, unique);
     } else {
-      node->parent_->right_ = x;
+      MergeByJoins(other, unique, thread_count, other_unique);
     }
+  }
 
-    x->right_ = node;
-    node->parent_ = x;
+ private:
+  /* The split and join merge, it needs subtree counts */
+  void MergeByJoins(RedBlackTree &other, bool unique, std::size_t thread_count,
+                    bool other_unique) {
+    Subtree first = AsSubtree();
+    Subtree second = TakeOver(other);
+    Subtree repeats = EmptySubtree();
+    if (unique && !other_unique) {
+      std::tie(second, repeats) = SplitRepeats(second);
+    }
+    ResetToEmpty();
+    Subtree merged = EmptySubtree();
+    Subtree leftover = EmptySubtree();
+    try {
+      std::tie(merged, leftover) =
+          MergeSubtrees(first, second, unique, thread_count);
+      leftover = MergeSubtrees(Take(leftover), Take(repeats), false, 1).first;
+    } catch (...) {
+      ClearHelper(merged.root);
+      ClearHelper(repeats.root);
+      throw;
+    }
+    AdoptSubtree(merged);
+    if (leftover.root != nil_) {
+      RebindNil(leftover.root, nil_, other.nil_);
+      other.AdoptSubtree(leftover);
+    }
   }
 
-  void FixInsertHelper(Node<T> *&y, Node<T> *&node,
-                       std::function<void(Node<T> *)> first_rotate,
-                       std::function<void(Node<T> *)> second_rotate,
-                       const Node<T> *child_to_check) {
-    if (y && y->color_ == Color::kRed) {
-      y->color_ = Color::kBlack;
-      node->parent_->color_ = Color::kBlack;
-      node->parent_->parent_->color_ = Color::kRed;
-      node = node->parent_->parent_;
-    } else {
-      if (node == child_to_check) {
-        node = node->parent_;
-        first_rotate(node);
+ public:
+  /* Checks colors, black heights, parent links, subtree sizes, the
+   * extremes kept by nil_, the threads and the aggregates */
+  [[nodiscard]] bool IsValid() const {
+    if (nil_->GetRight() != nil_) {
+      return false;
+    }
+    if (root_ == nil_) {
+      return GetLeftmost() == nil_ && GetRightmost() == nil_;
+    }
+    if (root_->GetParent() != nullptr || root_->GetColor() != Color::kBlack) {
+      return false;
+    }
+    if constexpr (kThreaded) {
+      const NodeType *previous = nil_;
+      if (!ValidateThreads(root_, previous) || previous->GetNext() != nil_ ||
+          nil_->GetPrev() != previous) {
+        return false;
       }
-      node->parent_->color_ = Color::kBlack;
-      node->parent_->parent_->color_ = Color::kRed;
-      second_rotate(node->parent_->parent_);
+    } else if (GetLeftmost() != FindMinNode(root_) ||
+               GetRightmost() != FindMaxNode(root_)) {
+      return false;
     }
+    return ValidateHelper(root_) >= 0;
   }
 
-  void FixInsert(Node<T> *node) {
-    auto right_rotate{[this](Node<T> *temp_node) { RightRotate(temp_node); }};
-    auto left_rotate{[this](Node<T> *temp_node) { LeftRotate(temp_node); }};
-
-    while (node != root_ && node->parent_->color_ == Color::kRed) {
-      if (node->parent_ == node->parent_->parent_->right_) {
-        Node<T> *aunt_node = node->parent_->parent_->left_;
-        FixInsertHelper(aunt_node, node, right_rotate, left_rotate,
-                        node->parent_->left_);
-      } else {
-        Node<T> *uncle_node = node->parent_->parent_->right_;
-        FixInsertHelper(uncle_node, node, left_rotate, right_rotate,
-                        node->parent_->right_);
-      }
-      if (node == root_) {
-        break;
-      }
+  [[maybe_unused]] void PrintTree() const {
+    if (root_ != nil_) {
+      PrintHelper(root_, "", true);
+    } else {
+      std::cerr << "Tree is IsEmpty\n";
     }
-    root_->color_ = Color::kBlack;
-    UpdateParentForMaxNode();
   }
 
-  void UpdateParentForMaxNode() {
-    auto maxNode = FindMaxNode(root_);
-    maxNode->right_->parent_ = maxNode;
-    maxNode->left_->parent_ = maxNode;
+ public:
+  /* Both return nil_ when nothing is found */
+  [[nodiscard]] NodeType *Search(const T &data) const {
+    return FindNodeByKey(KeyOfValue{}(data));
+  }
+
+  template <typename K>
+  [[nodiscard]] NodeType *SearchByKey(const K &key) const {
+    return FindNodeByKey(key);
   }
 
-  void InsertNode(Node<T> *node) {
-    Node<T> *y = nullptr;
-    Node<T> *root = root_;
+  /* First node with key not less than the given one, nil_ if none */
+  template <typename K>
+  [[nodiscard]] NodeType *LowerBound(const K &key) const {
+    return FindLowerBound(root_, key, nil_);
+  }
+
+  /* First node with key greater than the given one, nil_ if none */
+  template <typename K>
+  [[nodiscard]] NodeType *UpperBound(const K &key) const {
+    return FindUpperBound(root_, key, nil_);
+  }
 
-    while (root != nil_) {
-      y = root;
-      if (node->data_ < root->data_) {
-        root = root->left_;
+  /* Both bounds at once: the descent is shared down to the first node with
+   * an equal key, then each bound is finished in one of its subtrees */
+  template <typename K>
+  [[nodiscard]] std::pair<NodeType *, NodeType *> EqualRange(
+      const K &key) const {
+    NodeType *node = root_;
+    NodeType *upper = nil_;
+    while (node != nil_) {
+      const key_type &node_key = KeyOfValue{}(node->data_);
+      if (Less(key, node_key)) {
+        upper = node;
+        node = node->GetLeft();
+      } else if (Less(node_key, key)) {
+        node = node->GetRight();
       } else {
-        root = root->right_;
+        return {FindLowerBound(node->GetLeft(), key, node),
+                FindUpperBound(node->GetRight(), key, upper)};
       }
     }
+    return {upper, upper};
+  }
 
-    node->parent_ = y;
-
-    if (y == nullptr) {
-      root_ = node;
-    } else if (node->data_ < y->data_) {
-      y->left_ = node;
+  /* Number of elements with an equal key, O(log n) however many there are.
+   * Uncounted trees step over the equal keys instead */
+  template <typename K>
+  [[nodiscard]] size_type CountKey(const K &key) const {
+    if constexpr (kCounted) {
+      return GetUpperRank(key) - GetRank(key);
     } else {
-      y->right_ = node;
+      auto [node, upper] = EqualRange(key);
+      size_type count = 0;
+      for (; node != upper; node = NextNode(node)) {
+        ++count;
+      }
+      return count;
     }
+  }
 
-    if (node->parent_ == nullptr) {
-      node->color_ = Color::kRed;
-      return;
+ public: /* Order statistics, every node keeps the size of its subtree */
+  /* Number of elements with key less than the given one */
+  template <typename K>
+  [[nodiscard]] size_type GetRank(const K &key) const {
+    static_assert(kCounted, "order statistics need counted nodes");
+    size_type rank = 0;
+    NodeType *node = root_;
+    while (node != nil_) {
+      if (Less(KeyOfValue{}(node->data_), key)) {
+        rank += node->GetLeft()->GetSize() + 1;
+        node = node->GetRight();
+      } else {
+        node = node->GetLeft();
+      }
     }
+    return rank;
+  }
 
-    if (node->parent_->parent_ == nullptr) {
-      return;
+  /* Number of elements with key less than or equal to the given one */
+  template <typename K>
+  [[nodiscard]] size_type GetUpperRank(const K &key) const {
+    static_assert(kCounted, "order statistics need counted nodes");
+    size_type rank = 0;
+    NodeType *node = root_;
+    while (node != nil_) {
+      if (Less(key, KeyOfValue{}(node->data_))) {
+        node = node->GetLeft();
+      } else {
+        rank += node->GetLeft()->GetSize() + 1;
+        node = node->GetRight();
+      }
     }
+    return rank;
+  }
 
-    FixInsert(node);
+  /* Position of the node in sorted order, GetSize() for nil_ */
+  [[nodiscard]] size_type GetNodeRank(const NodeType *node) const {
+    static_assert(kCounted, "order statistics need counted nodes");
+    if (node == nil_) {
+      return GetSize();
+    }
+    size_type rank = node->GetLeft()->GetSize();
+    while (node->GetParent() != nullptr) {
+      if (node == node->GetParent()->GetRight()) {
+        rank += node->GetParent()->GetLeft()->GetSize() + 1;
+      }
+      node = node->GetParent();
+    }
+    return rank;
   }
 
-  [[nodiscard]] Node<T> *GetMinimalNode(Node<T> *node) {
-    while (node->left_ != nil_) {
-      node = node->left_;
+  /* Zero-based k-th smallest node, nil_ when k is out of range */
+  [[nodiscard]] NodeType *Select(size_type k) const {
+    static_assert(kCounted, "order statistics need counted nodes");
+    NodeType *node = root_;
+    while (node != nil_) {
+      size_type left_size = node->GetLeft()->GetSize();
+      if (k < left_size) {
+        node = node->GetLeft();
+      } else if (k == left_size) {
+        return node;
+      } else {
+        k -= left_size + 1;
+        node = node->GetRight();
+      }
     }
-    return node;
+    return nil_;
   }
 
-  void Transplant(Node<T> *replaced_node, Node<T> *replacing_node) {
-    if (replaced_node->parent_ == nullptr) {
-      root_ = replacing_node;
-    } else if (replaced_node == replaced_node->parent_->left_) {
-      replaced_node->parent_->left_ = replacing_node;
-    } else {
-      replaced_node->parent_->right_ = replacing_node;
+  /* Moves the node n positions in O(log n), clamps to begin and nil_ */
+  [[nodiscard]] NodeType *Advance(const NodeType *node,
+                                 difference_type n) const {
+    auto rank = static_cast<difference_type>(GetNodeRank(node)) + n;
+    if (rank < 0) {
+      rank = 0;
     }
+    return Select(static_cast<size_type>(rank));
+  }
 
-    replacing_node->parent_ = replaced_node->parent_;
+  /* Number of elements with key in [low, high) */
+  [[nodiscard]] size_type CountRange(const key_type &low,
+                                     const key_type &high) const {
+    if (!Less(low, high)) {
+      return 0;
+    }
+    return GetRank(high) - GetRank(low);
   }
 
-  void RemoveNode(Node<T> *node_to_delete) {
-    Node<T> *successor_node;
-    Node<T> *child_node;
-    Color current_node_color = node_to_delete->color_;
+ public: /* Aggregates, every node keeps the summary of its subtree */
+  /* Aggregate of all elements in O(1) */
+  [[nodiscard]] auto Fold() const {
+    static_assert(kAggregated, "the tree has no Aggregate policy");
+    return SummaryOf(root_);
+  }
 
-    if (node_to_delete->left_ == nil_) {
-      child_node = node_to_delete->right_;
-      Transplant(node_to_delete, node_to_delete->right_);
-    } else if (node_to_delete->right_ == nil_) {
-      child_node = node_to_delete->left_;
-      Transplant(node_to_delete, node_to_delete->left_);
-    } else {
-      successor_node = GetMinimalNode(node_to_delete->right_);
-      current_node_color = successor_node->color_;
-      child_node = successor_node->right_;
+  /* Aggregate of the elements with key in [low, high), in key order. Walks
+   * down to the topmost node in the range, then along both bounds, so it
+   * reads O(log n) nodes */
+  template <typename K>
+  [[nodiscard]] auto Fold(const K &low, const K &high) const {
+    static_assert(kAggregated, "the tree has no Aggregate policy");
+    if (!Less(low, high)) {
+      return Aggregate::Identity();
+    }
+    NodeType *node = root_;
+    while (node != nil_) {
+      if (Less(KeyOfValue{}(node->data_), low)) {
+        node = node->GetRight();
+      } else if (!Less(KeyOfValue{}(node->data_), high)) {
+        node = node->GetLeft();
+      } else {
+        return Aggregate::Combine(
+            Aggregate::Combine(FoldFrom(node->GetLeft(), low),
+                               Aggregate::Lift(node->data_)),
+            FoldBelow(node->GetRight(), high));
+      }
+    }
+    return Aggregate::Identity();
+  }
 
-      if (successor_node->parent_ == node_to_delete) {
-        child_node->parent_ = successor_node;
+  /* Restores the summaries above a node whose element was changed in
+   * place, in O(log n) */
+  void Refresh(NodeType *node) { PullUpwards(node); }
+
+  /* The two searches below take keep, a predicate on summaries that holds
+   * for a summary exactly when it holds for one of the lifted elements it
+   * combines, like "the max is above x" for MaxAggregate. Subtrees whose
+   * summary fails keep are never entered */
+
+  /* First node in key order with key not greater than last whose element
+   * passes keep, nil_ if there is none. Reads O(log n) nodes */
+  template <typename K, typename Keep>
+  [[nodiscard]] NodeType *FindFirstMatching(const K &last, Keep keep) const {
+    NodeType *node = root_;
+    while (node != nil_ && keep(node->GetAggregate())) {
+      if (node->GetLeft() != nil_ && keep(node->GetLeft()->GetAggregate())) {
+        /* The left match precedes the node and everything to the right, if
+         * it lies past last they do too */
+        node = node->GetLeft();
+      } else if (Less(last, KeyOfValue{}(node->data_))) {
+        return nil_;
+      } else if (keep(Aggregate::Lift(node->data_))) {
+        return node;
       } else {
-        Transplant(successor_node, successor_node->right_);
-        successor_node->right_ = node_to_delete->right_;
-        successor_node->right_->parent_ = successor_node;
+        node = node->GetRight();
       }
-      Transplant(node_to_delete, successor_node);
-      successor_node->left_ = node_to_delete->left_;
-      successor_node->left_->parent_ = successor_node;
-      successor_node->color_ = node_to_delete->color_;
     }
+    return nil_;
+  }
 
-    delete node_to_delete;
-    node_to_delete = nullptr;
+  /* Calls function in key order on every element with key not greater
+   * than last that passes keep. Costs O(log n + k log(n / k)) for k calls,
+   * the union of the paths down to them */
+  template <typename K, typename Keep, typename Function>
+  void ForEachMatching(const K &last, Keep keep, Function &&function) const {
+    VisitMatching(root_, last, keep, function);
+  }
 
-    if (current_node_color == Color::kBlack) {
-      FixDelete(child_node);
+ private:
+  template <typename K, typename Keep, typename Function>
+  void VisitMatching(NodeType *node, const K &last, Keep &keep,
+                     Function &function) const {
+    while (node != nil_ && keep(node->GetAggregate())) {
+      VisitMatching(node->GetLeft(), last, keep, function);
+      if (Less(last, KeyOfValue{}(node->data_))) {
+        return;
+      }
+      if (keep(Aggregate::Lift(node->data_))) {
+        function(node->data_);
+      }
+      node = node->GetRight();
     }
   }
 
-  void FixDelete(Node<T> *node) {
-    while (node != root_ &&
-           (node == nullptr || node->color_ == Color::kBlack)) {
-      if (node == node->parent_->left_) {
-        Node<T> *sibling_node = node->parent_->right_;
-        if (sibling_node->color_ == Color::kRed) {
-          sibling_node->color_ = Color::kBlack;
-          node->parent_->color_ = Color::kRed;
-          LeftRotate(node->parent_);
-          sibling_node = node->parent_->right_;
-        }
-        if (sibling_node->left_->color_ == Color::kBlack &&
-            sibling_node->right_->color_ == Color::kBlack) {
-          sibling_node->color_ = Color::kRed;
-          node = node->parent_;
-        } else {
-          if (sibling_node->right_->color_ == Color::kBlack) {
-            sibling_node->left_->color_ = Color::kBlack;
-            sibling_node->color_ = Color::kRed;
-            RightRotate(sibling_node);
-            sibling_node = node->parent_->right_;
-          }
-          sibling_node->color_ = node->parent_->color_;
-          node->parent_->color_ = Color::kBlack;
-          sibling_node->right_->color_ = Color::kBlack;
-          LeftRotate(node->parent_);
-          node = root_;
-        }
+  /* Aggregate of the subtree elements with key not less than low */
+  template <typename K>
+  auto FoldFrom(const NodeType *node, const K &low) const {
+    auto result = Aggregate::Identity();
+    while (node != nil_) {
+      if (Less(KeyOfValue{}(node->data_), low)) {
+        node = node->GetRight();
       } else {
-        Node<T> *sibling_node = node->parent_->left_;
-        if (sibling_node->color_ == Color::kRed) {
-          sibling_node->color_ = Color::kBlack;
-          node->parent_->color_ = Color::kRed;
-          RightRotate(node->parent_);
-          sibling_node = node->parent_->left_;
-        }
-        if ((sibling_node->right_->color_ == Color::kBlack) &&
-            (sibling_node->left_->color_ == Color::kBlack)) {
-          sibling_node->color_ = Color::kRed;
-          node = node->parent_;
-        } else {
-          if (sibling_node->left_->color_ == Color::kBlack) {
-            sibling_node->right_->color_ = Color::kBlack;
-            sibling_node->color_ = Color::kRed;
-            LeftRotate(sibling_node);
-            sibling_node = node->parent_->left_;
-          }
-          sibling_node->color_ = node->parent_->color_;
-          node->parent_->color_ = Color::kBlack;
-          sibling_node->left_->color_ = Color::kBlack;
-          RightRotate(node->parent_);
-          node = root_;
-        }
+        result = Aggregate::Combine(
+            Aggregate::Combine(Aggregate::Lift(node->data_),
+                               SummaryOf(node->GetRight())),
+            result);
+        node = node->GetLeft();
       }
     }
-    node->color_ = Color::kBlack;
+    return result;
   }
 
-  Node<T> *FindNode(Node<T> *root, const T &data) const {
-    if (GetSize() == 0) {
-      return root;
+  /* Aggregate of the subtree elements with key less than high */
+  template <typename K>
+  auto FoldBelow(const NodeType *node, const K &high) const {
+    auto result = Aggregate::Identity();
+    while (node != nil_) {
+      if (Less(KeyOfValue{}(node->data_), high)) {
+        result = Aggregate::Combine(
+            result, Aggregate::Combine(SummaryOf(node->GetLeft()),
+                                       Aggregate::Lift(node->data_)));
+        node = node->GetRight();
+      } else {
+        node = node->GetLeft();
+      }
     }
-    if (root == nullptr) {
-      return nil_;
+    return result;
+  }
+
+ public: /* Statistics, only with TreeStats */
+  [[nodiscard]] TreeCounters GetCounters() const {
+    return Stats::GetCounters();
+  }
+
+  void ResetCounters() { Stats::ResetCounters(); }
+
+ public: /* Range scans */
+  /* First and past-the-last node with key in [low, high), both the same
+   * node when the range is empty */
+  template <typename K>
+  [[nodiscard]] std::pair<NodeType *, NodeType *> RangeBounds(
+      const K &low, const K &high) const {
+    NodeType *first = LowerBound(low);
+    if (!Less(low, high)) {
+      return {first, first};
     }
-    if (root->data_ == data) {
-      return root;
+    return {first, LowerBound(high)};
+  }
+
+  /* Calls function on every element with key in [low, high) in order. The
+   * next step is prefetched before function runs on the current node */
+  template <typename K, typename Function>
+  void ForEachRange(const K &low, const K &high, Function &&function) const {
+    auto [node, last] = RangeBounds(low, high);
+    while (node != last) {
+      PrefetchSuccessor(node);
+      function(node->data_);
+      node = NextNode(node);
     }
-    if (data < root->data_) {
-      return FindNode(root->left_, data);
+  }
+
+  /* A hint to pull the node into cache, it is never dereferenced */
+  static void Prefetch(const NodeType *node) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(node);
+#else
+    static_cast<void>(node);
+#endif
+  }
+
+  /* Prefetches what the step from node reads first: the successor along
+   * the threads, or the right child a climbing step descends into */
+  static void PrefetchSuccessor(const NodeType *node) noexcept {
+    if constexpr (kThreaded) {
+      Prefetch(node->GetNext());
     } else {
-      return FindNode(root->right_, data);
+      Prefetch(node->GetRight());
     }
   }
 
-  Node<T> *FindNodeByKey(Node<T> *root, const T &key) const {
-    if (GetSize() == 0) {
-      return root;
+  /* In-order neighbours, nil_ past either end. Without threads they climb
+   * the tree in O(1) amortized. nil_ is the only node whose right link
+   * points to itself, and its parent link holds the rightmost node */
+  static NodeType *NextNode(NodeType *node) noexcept {
+    if constexpr (kThreaded) {
+      return node->GetNext();
+    } else {
+      NodeType *right = node->GetRight();
+      if (!IsNil(right)) {
+        for (NodeType *left = right->GetLeft(); !IsNil(left);
+             left = right->GetLeft()) {
+          right = left;
+        }
+        return right;
+      }
+      NodeType *parent = node->GetParent();
+      while (parent != nullptr && parent->GetRight() == node) {
+        node = parent;
+        parent = parent->GetParent();
+      }
+      return parent != nullptr ? parent : right;
     }
-    if (root == nullptr) {
+  }
+
+  static NodeType *PrevNode(NodeType *node) noexcept {
+    if constexpr (kThreaded) {
+      return node->GetPrev();
+    } else {
+      if (IsNil(node)) {
+        return node->GetParent();
+      }
+      NodeType *left = node->GetLeft();
+      if (!IsNil(left)) {
+        for (NodeType *right = left->GetRight(); !IsNil(right);
+             right = left->GetRight()) {
+          left = right;
+        }
+        return left;
+      }
+      NodeType *parent = node->GetParent();
+      while (parent != nullptr && parent->GetLeft() == node) {
+        node = parent;
+        parent = parent->GetParent();
+      }
+      return parent != nullptr ? parent : left;
+    }
+  }
+
+  static bool IsNil(const NodeType *node) noexcept {
+    return node->GetRight() == node;
+  }
+
+ public:
+  [[nodiscard]] const_iterator begin() const noexcept {
+    return RedBlackTreeConstIterator(GetLeftmost());
+  }
+
+  [[nodiscard]] const_iterator end() const noexcept {
+    return RedBlackTreeConstIterator(nil_);
+  }
+
+  NodeType *FindMinNode(NodeType *root) const {
+    while (root->GetLeft() != nil_ && root->GetLeft() != nullptr) {
+      root = root->GetLeft();
+    }
+    return root;
+  }
+
+  NodeType *FindMaxNode(NodeType *root) const {
+    while (root->GetRight() != nil_) {
+      root = root->GetRight();
+    }
+    return root;
+  }
+
+ private:
+  NodeType *nil_{CreateNil()};
+  NodeType *root_{nil_};
+
+ private:
+  template <typename... Args>
+  NodeType *CreateNode(Args &&...args) {
+    void *storage = NodeAllocator::template Allocate<NodeType>();
+    Stats::OnAllocate();
+    try {
+      return new (storage) NodeType(std::in_place, std::forward<Args>(args)...);
+    } catch (...) {
+      NodeAllocator::template Deallocate<NodeType>(storage);
+      Stats::OnDeallocate();
+      throw;
+    }
+  }
+
+  template <typename ForwardIt>
+  [[nodiscard]] bool IsSortedRange(ForwardIt first, ForwardIt last) const {
+    if (first == last) {
+      return true;
+    }
+    for (ForwardIt next = std::next(first); next != last; first = next++) {
+      if (Less(KeyOfValue{}(*next), KeyOfValue{}(*first))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  [[nodiscard]] static size_type GetFloorLog2(size_type value) {
+    size_type result = 0;
+    while (value > 1) {
+      value >>= 1;
+      ++result;
+    }
+    return result;
+  }
+
+  /* Consumes count nodes from the chain in order. Splitting at the median
+   * keeps every nil_ at depth h or h + 1, so painting the nodes at depth h
+   * red gives every path the same number of black nodes */
+  NodeType *BuildFromChain(NodeType *&chain, size_type count, size_type depth,
+                          size_type red_depth) {
+    if (count == 0) {
       return nil_;
     }
-    if (root->data_.first == key) {
-      return root;
+    size_type left_count = (count - 1) / 2;
+    NodeType *left = BuildFromChain(chain, left_count, depth + 1, red_depth);
+
+    NodeType *node = chain;
+    chain = chain->GetRight();
+
+    NodeType *right =
+        BuildFromChain(chain, count - left_count - 1, depth + 1, red_depth);
+
+    node->SetLeft(left);
+    node->SetRight(right);
+    if (left != nil_) {
+      left->SetParent(node);
+    }
+    if (right != nil_) {
+      right->SetParent(node);
+    }
+    node->SetSize(count);
+    Pull(node);
+    node->SetColor(depth == red_depth ? Color::kRed : Color::kBlack);
+    return node;
+  }
+
+  void DestroyChain(NodeType *chain, size_type count) noexcept {
+    while (count-- > 0) {
+      NodeType *next = chain->GetRight();
+      DestroyNode(chain);
+      chain = next;
+    }
+  }
+
+  /* Copies shape, colors and sizes of other in O(n) without comparisons.
+   * Nodes are taken from the reusable chain first, leftovers are freed */
+  void CloneFrom(const RedBlackTree &other, NodeType *reusable) {
+    NodeType *last = nil_;
+    try {
+      CloneSubtree(other, other.root_, nullptr, false, last, reusable);
+    } catch (...) {
+      ClearHelper(root_);
+      ResetToEmpty();
+      DestroyReusable(reusable);
+      throw;
+    }
+    DestroyReusable(reusable);
+    ThreadNodes(last, nil_);
+    RefreshExtremes();
+    SetUncountedSize(other.GetSize());
+  }
+
+  /* Links every new node below parent before descending, so a throwing
+   * copy leaves a well-formed partial tree behind for cleanup. Threaded
+   * nodes are threaded after last, the previous node in order */
+  void CloneSubtree(const RedBlackTree &other, const NodeType *source,
+                    NodeType *parent, bool as_left, NodeType *&last,
+                    NodeType *&reusable) {
+    if (source == other.nil_) {
+      return;
+    }
+    NodeType *node = ReuseOrCreateNode(reusable, source->data_);
+    node->SetColor(source->GetColor());
+    CopySize(node, source);
+    if constexpr (kAggregated) {
+      node->SetAggregate(source->GetAggregate());
+    }
+    node->SetParent(parent);
+    node->SetLeft(nil_);
+    node->SetRight(nil_);
+    if (parent == nullptr) {
+      root_ = node;
+    } else if (as_left) {
+      parent->SetLeft(node);
+    } else {
+      parent->SetRight(node);
+    }
+    CloneSubtree(other, source->GetLeft(), node, true, last, reusable);
+    ThreadNodes(last, node);
+    last = node;
+    CloneSubtree(other, source->GetRight(), node, false, last, reusable);
+  }
+
+  /* Unlinks all nodes bottom-up in O(n) into a chain through the right
+   * links */
+  NodeType *DetachNodes() noexcept {
+    NodeType *chain = nullptr;
+    NodeType *node = root_;
+    while (node != nil_ && node != nullptr) {
+      if (node->GetLeft() != nil_) {
+        node = node->GetLeft();
+      } else if (node->GetRight() != nil_) {
+        node = node->GetRight();
+      } else {
+        NodeType *parent = node->GetParent();
+        if (parent != nullptr) {
+          if (parent->GetLeft() == node) {
+            parent->SetLeft(nil_);
+          } else {
+            parent->SetRight(nil_);
+          }
+        }
+        node->SetRight(chain);
+        chain = node;
+        node = parent;
+      }
+    }
+    return chain;
+  }
+
+  NodeType *ReuseOrCreateNode(NodeType *&reusable, const T &data) {
+    if (reusable == nullptr) {
+      return CreateNode(data);
+    }
+    NodeType *node = reusable;
+    reusable = node->GetRight();
+    std::destroy_at(std::addressof(node->data_));
+    node->~Node();
+    try {
+      return new (node) NodeType(std::in_place, data);
+    } catch (...) {
+      NodeAllocator::template Deallocate<NodeType>(node);
+      Stats::OnDeallocate();
+      throw;
+    }
+  }
+
+  void DestroyReusable(NodeType *&reusable) noexcept {
+    while (reusable != nullptr) {
+      NodeType *next = reusable->GetRight();
+      DestroyNode(reusable);
+      reusable = next;
+    }
+  }
+
+  void ResetToEmpty() {
+    root_ = nil_;
+    ResetNil(nil_);
+    SetUncountedSize(0);
+  }
+
+  /* The right link of nil pointing to itself tells it apart from element
+   * nodes. Without threads its left and parent links hold the leftmost and
+   * rightmost nodes, nil itself when empty */
+  static void ResetNil(NodeType *nil) noexcept {
+    nil->SetLeft(nil);
+    nil->SetRight(nil);
+    if constexpr (kThreaded) {
+      nil->SetParent(nullptr);
+      ThreadNodes(nil, nil);
+    } else {
+      nil->SetParent(nil);
+    }
+  }
+
+  /* Finds the extremes of a tree linked in bulk. Threaded trees keep them
+   * in the ring already */
+  void RefreshExtremes() noexcept {
+    if constexpr (!kThreaded) {
+      nil_->SetLeft(root_ == nil_ ? nil_ : FindMinNode(root_));
+      nil_->SetParent(root_ == nil_ ? nil_ : FindMaxNode(root_));
+    }
+  }
+
+  static void ThreadNodes(NodeType *previous, NodeType *next) noexcept {
+    if constexpr (kThreaded) {
+      previous->SetNext(next);
+      next->SetPrev(previous);
+    } else {
+      static_cast<void>(previous);
+      static_cast<void>(next);
+    }
+  }
+
+  /* Threads the first count nodes of a chain through right_ in order and
+   * returns the last of them, nil_ for unthreaded nodes */
+  NodeType *ThreadChain(NodeType *chain, size_type count) const noexcept {
+    if constexpr (!kThreaded) {
+      return nil_;
     }
-    if (key < root->data_.first) {
-      return FindNodeForMap(root->left_, key);
+    for (; count > 1; --count, chain = chain->GetRight()) {
+      ThreadNodes(chain, chain->GetRight());
+    }
+    return chain;
+  }
+
+  /* nil_ comes from the node allocator too, index links must reach it */
+  static NodeType *CreateNil() {
+    auto *nil = new (NodeAllocator::template Allocate<NodeType>()) NodeType{};
+    ResetNil(nil);
+    return nil;
+  }
+
+  static void DestroyNil(NodeType *nil) noexcept {
+    nil->~NodeType();
+    NodeAllocator::template Deallocate<NodeType>(nil);
+  }
+
+  void DestroyNode(NodeType *node) noexcept {
+    std::destroy_at(std::addressof(node->data_));
+    node->~Node();
+    NodeAllocator::template Deallocate<NodeType>(node);
+    Stats::OnDeallocate();
+  }
+
+  void ClearHelper(NodeType *node) {
+    if (node != nil_) {
+      ClearHelper(node->GetLeft());
+      ClearHelper(node->GetRight());
+      DestroyNode(node);
+    }
+  }
+
+  void LeftRotate(NodeType *node) { LeftRotate(node, root_); }
+
+  void RightRotate(NodeType *node) { RightRotate(node, root_); }
+
+  /* Rotations and the insert fix-up take the root explicitly, so they also
+   * work on detached subtrees during join. They never write to nil_ */
+  void LeftRotate(NodeType *node, NodeType *&root) {
+    Stats::OnRotate();
+    NodeType *y = node->GetRight();
+    node->SetRight(y->GetLeft());
+
+    if (y->GetLeft() != nil_) {
+      y->GetLeft()->SetParent(node);
+    }
+    y->SetParent(node->GetParent());
+
+    if (node->GetParent() == nullptr) {
+      root = y;
+    } else if (node == node->GetParent()->GetLeft()) {
+      node->GetParent()->SetLeft(y);
+    } else {
+      node->GetParent()->SetRight(y);
+    }
+
+    y->SetLeft(node);
+    node->SetParent(y);
+
+    CopySize(y, node);
+    CountChildren(node);
+    Pull(node);
+    Pull(y);
+  }
+
+  void RightRotate(NodeType *node, NodeType *&root) {
+    Stats::OnRotate();
+    NodeType *x = node->GetLeft();
+    node->SetLeft(x->GetRight());
+
+    if (x->GetRight() != nil_) {
+      x->GetRight()->SetParent(node);
+    }
+    x->SetParent(node->GetParent());
+
+    if (node->GetParent() == nullptr) {
+      root = x;
+    } else if (node == node->GetParent()->GetLeft()) {
+      node->GetParent()->SetLeft(x);
+    } else {
+      node->GetParent()->SetRight(x);
+    }
+
+    x->SetRight(node);
+    node->SetParent(x);
+
+    CopySize(x, node);
+    CountChildren(node);
+    Pull(node);
+    Pull(x);
+  }
+
+  void FixInsert(NodeType *node) {
+    FixRedViolation(node, root_);
+    root_->SetColor(Color::kBlack);
+  }
+
+  /* Restores the red rule above a red node, may leave the root red */
+  void FixRedViolation(NodeType *node, NodeType *&root) {
+    while (node != root && node->GetParent()->GetColor() == Color::kRed) {
+      Stats::OnInsertFixup();
+      NodeType *parent = node->GetParent();
+      NodeType *grandparent = parent->GetParent();
+      bool parent_is_left = parent == grandparent->GetLeft();
+      NodeType *uncle =
+          parent_is_left ? grandparent->GetRight() : grandparent->GetLeft();
+      if (uncle->GetColor() == Color::kRed) {
+        parent->SetColor(Color::kBlack);
+        uncle->SetColor(Color::kBlack);
+        grandparent->SetColor(Color::kRed);
+        node = grandparent;
+      } else if (parent_is_left) {
+        if (node == parent->GetRight()) {
+          LeftRotate(parent, root);
+          parent = node;
+        }
+        parent->SetColor(Color::kBlack);
+        grandparent->SetColor(Color::kRed);
+        RightRotate(grandparent, root);
+        return;
+      } else {
+        if (node == parent->GetLeft()) {
+          RightRotate(parent, root);
+          parent = node;
+        }
+        parent->SetColor(Color::kBlack);
+        grandparent->SetColor(Color::kRed);
+        LeftRotate(grandparent, root);
+        return;
+      }
+    }
+  }
+
+  /* Moves from data only once the element is known to be inserted */
+  template <typename Value>
+  std::pair<NodeType *, bool> InsertValue(NodeType *hint, Value &&data,
+                                         bool unique) {
+    InsertPosition position =
+        FindHintedPosition(hint, KeyOfValue{}(data), unique);
+    if (position.existing != nullptr) {
+      return {position.existing, false};
+    }
+    return {LinkNode(CreateNode(std::forward<Value>(data)), position), true};
+  }
+
+  /* Where a new key goes: below parent on the given side, or existing
+   * when a unique insert meets an equal key. parent is nullptr for an
+   * empty tree */
+  struct InsertPosition {
+    NodeType *parent;
+    bool as_left;
+    NodeType *existing;
+  };
+
+  InsertPosition FindInsertPosition(const key_type &key, bool unique) const {
+    if (root_ == nil_) {
+      return {nullptr, false, nullptr};
+    }
+    NodeType *rightmost = GetRightmost();
+    const key_type &max_key = KeyOfValue{}(rightmost->data_);
+    if (Less(max_key, key) || (!unique && !Less(key, max_key))) {
+      return {rightmost, false, nullptr};
+    }
+    NodeType *leftmost = GetLeftmost();
+    if (Less(key, KeyOfValue{}(leftmost->data_))) {
+      return {leftmost, true, nullptr};
+    }
+    return DescendToPosition(root_, key, unique);
+  }
+
+  /* Searches for the position of key below node, which must cover it */
+  template <typename K>
+  InsertPosition DescendToPosition(NodeType *node, const K &key,
+                                   bool unique) const {
+    NodeType *parent = nullptr;
+    bool as_left = false;
+    size_type path = 0;
+    for (; node != nil_; ++path) {
+      parent = node;
+      const key_type &node_key = KeyOfValue{}(node->data_);
+      if (Less(key, node_key)) {
+        as_left = true;
+        node = node->GetLeft();
+      } else if (unique && !Less(node_key, key)) {
+        Stats::OnSearch(path + 1);
+        return {nullptr, false, node};
+      } else {
+        as_left = false;
+        node = node->GetRight();
+      }
+    }
+    Stats::OnSearch(path);
+    return {parent, as_left, nullptr};
+  }
+
+  /* The key fits right before hint when it lies between the predecessor
+   * of hint and hint itself */
+  InsertPosition FindHintedPosition(NodeType *hint, const key_type &key,
+                                    bool unique) const {
+    if (hint == nil_ || root_ == nil_) {
+      return FindInsertPosition(key, unique);
+    }
+    const key_type &hint_key = KeyOfValue{}(hint->data_);
+    if (Less(key, hint_key) || (!unique && !Less(hint_key, key))) {
+      if (hint == GetLeftmost()) {
+        return {hint, true, nullptr};
+      }
+      NodeType *previous = PrevNode(hint);
+      const key_type &previous_key = KeyOfValue{}(previous->data_);
+      if (Less(previous_key, key) || (!unique && !Less(key, previous_key))) {
+        if (hint->GetLeft() == nil_) {
+          return {hint, true, nullptr};
+        }
+        return {previous, false, nullptr};
+      }
+    } else if (unique && !Less(hint_key, key)) {
+      return {nullptr, false, hint};
+    }
+    return FindInsertPosition(key, unique);
+  }
+
+  NodeType *LinkNode(NodeType *node, InsertPosition position) {
+    NodeType *parent = position.parent;
+    node->SetParent(parent);
+    node->SetLeft(nil_);
+    node->SetRight(nil_);
+    node->SetColor(Color::kRed);
+    node->SetSize(1);
+    if (parent == nullptr) {
+      root_ = node;
+    } else if (position.as_left) {
+      parent->SetLeft(node);
+    } else {
+      parent->SetRight(node);
+    }
+    /* A new leaf sits right next to its parent in key order */
+    if constexpr (kThreaded) {
+      NodeType *next = nil_;
+      if (parent != nullptr) {
+        next = position.as_left ? parent : parent->GetNext();
+      }
+      ThreadNodes(next->GetPrev(), node);
+      ThreadNodes(node, next);
+    } else {
+      if (parent == nullptr || (position.as_left && parent == GetLeftmost())) {
+        nil_->SetLeft(node);
+      }
+      if (parent == nullptr ||
+          (!position.as_left && parent == GetRightmost())) {
+        nil_->SetParent(node);
+      }
+    }
+    /* Sizes are bumped without comparisons along an already hot path */
+    Pull(node);
+    if constexpr (kCounted || kAggregated) {
+      for (; parent != nullptr; parent = parent->GetParent()) {
+        if constexpr (kCounted) {
+          parent->SetSize(parent->GetSize() + 1);
+        }
+        Pull(parent);
+      }
+    }
+    SetUncountedSize(GetSize() + 1);
+    FixInsert(node);
+    return node;
+  }
+
+  void InsertDetachedNode(NodeType *node) {
+    LinkNode(node, FindInsertPosition(KeyOfValue{}(node->data_), false));
+  }
+
+  void Transplant(NodeType *replaced_node, NodeType *replacing_node) {
+    if (replaced_node->GetParent() == nullptr) {
+      root_ = replacing_node;
+    } else if (replaced_node == replaced_node->GetParent()->GetLeft()) {
+      replaced_node->GetParent()->SetLeft(replacing_node);
+    } else {
+      replaced_node->GetParent()->SetRight(replacing_node);
+    }
+
+    replacing_node->SetParent(replaced_node->GetParent());
+  }
+
+  void RemoveNode(NodeType *node_to_delete) {
+    UnlinkNode(node_to_delete);
+    DestroyNode(node_to_delete);
+  }
+
+  void UnlinkNode(NodeType *node_to_delete) {
+    NodeType *successor_node;
+    NodeType *child_node;
+    /* The deepest node whose children change */
+    NodeType *changed_node = node_to_delete->GetParent();
+    Color current_node_color = node_to_delete->GetColor();
+    /* Transplant and FixDelete use the parent link of nil_ as scratch, the
+     * extremes it holds are put back at the end */
+    NodeType *leftmost = GetLeftmost();
+    NodeType *rightmost = GetRightmost();
+    if constexpr (kThreaded) {
+      ThreadNodes(node_to_delete->GetPrev(), node_to_delete->GetNext());
+    } else {
+      if (node_to_delete == leftmost) {
+        leftmost = NextNode(node_to_delete);
+      }
+      if (node_to_delete == rightmost) {
+        rightmost = PrevNode(node_to_delete);
+      }
+    }
+
+    if (node_to_delete->GetLeft() == nil_) {
+      DecrementSizesUpwards(node_to_delete->GetParent());
+      child_node = node_to_delete->GetRight();
+      Transplant(node_to_delete, node_to_delete->GetRight());
+    } else if (node_to_delete->GetRight() == nil_) {
+      DecrementSizesUpwards(node_to_delete->GetParent());
+      child_node = node_to_delete->GetLeft();
+      Transplant(node_to_delete, node_to_delete->GetLeft());
+    } else {
+      successor_node = NextNode(node_to_delete);
+      DecrementSizesUpwards(successor_node->GetParent());
+      current_node_color = successor_node->GetColor();
+      child_node = successor_node->GetRight();
+
+      if (successor_node->GetParent() == node_to_delete) {
+        child_node->SetParent(successor_node);
+        changed_node = successor_node;
+      } else {
+        changed_node = successor_node->GetParent();
+        Transplant(successor_node, successor_node->GetRight());
+        successor_node->SetRight(node_to_delete->GetRight());
+        successor_node->GetRight()->SetParent(successor_node);
+      }
+      Transplant(node_to_delete, successor_node);
+      successor_node->SetLeft(node_to_delete->GetLeft());
+      successor_node->GetLeft()->SetParent(successor_node);
+      successor_node->SetColor(node_to_delete->GetColor());
+      CopySize(successor_node, node_to_delete);
+    }
+    PullUpwards(changed_node);
+
+    if (current_node_color == Color::kBlack) {
+      FixDelete(child_node);
+    }
+    if constexpr (!kThreaded) {
+      nil_->SetLeft(leftmost);
+      nil_->SetParent(rightmost);
+    }
+    SetUncountedSize(GetSize() - 1);
+  }
+
+  void DecrementSizesUpwards(NodeType *node) {
+    if constexpr (kCounted) {
+      for (; node != nullptr; node = node->GetParent()) {
+        node->SetSize(node->GetSize() - 1);
+      }
+    } else {
+      static_cast<void>(node);
+    }
+  }
+
+  /* Subtree counts, nothing to do for uncounted nodes */
+  static void CountChildren(NodeType *node) noexcept {
+    if constexpr (kCounted) {
+      node->SetSize(node->GetLeft()->GetSize() + node->GetRight()->GetSize() +
+                    1);
+    }
+  }
+
+  static void CopySize(NodeType *node, const NodeType *source) noexcept {
+    if constexpr (kCounted) {
+      node->SetSize(source->GetSize());
+    }
+  }
+
+  /* The element count of an uncounted tree, counted trees read theirs
+   * off the root */
+  void SetUncountedSize(size_type count) noexcept {
+    if constexpr (!kCounted) {
+      this->SetElementCount(count);
     } else {
-      return FindNodeForMap(root->right_, key);
+      static_cast<void>(count);
+    }
+  }
+
+  /* Recomputes the summary of node from its element and children */
+  void Pull(NodeType *node) {
+    if constexpr (kAggregated) {
+      node->SetAggregate(Aggregate::Combine(
+          Aggregate::Combine(SummaryOf(node->GetLeft()),
+                             Aggregate::Lift(node->data_)),
+          SummaryOf(node->GetRight())));
+    }
+  }
+
+  void PullUpwards(NodeType *node) {
+    if constexpr (kAggregated) {
+      for (; node != nullptr; node = node->GetParent()) {
+        Pull(node);
+      }
+    }
+  }
+
+  auto SummaryOf(const NodeType *node) const {
+    return node == nil_ ? Aggregate::Identity() : node->GetAggregate();
+  }
+
+  void FixDelete(NodeType *node) {
+    while (node != root_ &&
+           (node == nullptr || node->GetColor() == Color::kBlack)) {
+      Stats::OnEraseFixup();
+      if (node == node->GetParent()->GetLeft()) {
+        NodeType *sibling_node = node->GetParent()->GetRight();
+        if (sibling_node->GetColor() == Color::kRed) {
+          sibling_node->SetColor(Color::kBlack);
+          node->GetParent()->SetColor(Color::kRed);
+          LeftRotate(node->GetParent());
+          sibling_node = node->GetParent()->GetRight();
+        }
+        if (sibling_node->GetLeft()->GetColor() == Color::kBlack &&
+            sibling_node->GetRight()->GetColor() == Color::kBlack) {
+          sibling_node->SetColor(Color::kRed);
+          node = node->GetParent();
+        } else {
+          if (sibling_node->GetRight()->GetColor() == Color::kBlack) {
+            sibling_node->GetLeft()->SetColor(Color::kBlack);
+            sibling_node->SetColor(Color::kRed);
+            RightRotate(sibling_node);
+            sibling_node = node->GetParent()->GetRight();
+          }
+          sibling_node->SetColor(node->GetParent()->GetColor());
+          node->GetParent()->SetColor(Color::kBlack);
+          sibling_node->GetRight()->SetColor(Color::kBlack);
+          LeftRotate(node->GetParent());
+          node = root_;
+        }
+      } else {
+        NodeType *sibling_node = node->GetParent()->GetLeft();
+        if (sibling_node->GetColor() == Color::kRed) {
+          sibling_node->SetColor(Color::kBlack);
+          node->GetParent()->SetColor(Color::kRed);
+          RightRotate(node->GetParent());
+          sibling_node = node->GetParent()->GetLeft();
+        }
+        if ((sibling_node->GetRight()->GetColor() == Color::kBlack) &&
+            (sibling_node->GetLeft()->GetColor() == Color::kBlack)) {
+          sibling_node->SetColor(Color::kRed);
+          node = node->GetParent();
+        } else {
+          if (sibling_node->GetLeft()->GetColor() == Color::kBlack) {
+            sibling_node->GetRight()->SetColor(Color::kBlack);
+            sibling_node->SetColor(Color::kRed);
+            LeftRotate(sibling_node);
+            sibling_node = node->GetParent()->GetLeft();
+          }
+          sibling_node->SetColor(node->GetParent()->GetColor());
+          node->GetParent()->SetColor(Color::kBlack);
+          sibling_node->GetLeft()->SetColor(Color::kBlack);
+          RightRotate(node->GetParent());
+          node = root_;
+        }
+      }
+    }
+    node->SetColor(Color::kBlack);
+  }
+
+  /* A detached red-black tree with a black root and a parent-less root,
+   * black_height counts the black nodes on any path below the root. With
+   * threaded nodes first and last are its extreme nodes: threads between
+   * its own nodes hold, the two leading out of it are stale until it is
+   * joined. Otherwise they are not kept up to date */
+  struct Subtree {
+    NodeType *root;
+    int black_height;
+    NodeType *first;
+    NodeType *last;
+  };
+
+  struct ExposedSubtree {
+    Subtree left;
+    NodeType *node;
+    Subtree right;
+  };
+
+  [[nodiscard]] Subtree EmptySubtree() const { return {nil_, 0, nil_, nil_}; }
+
+  /* Hands the subtree over and leaves an empty one behind */
+  Subtree Take(Subtree &tree) const {
+    return std::exchange(tree, EmptySubtree());
+  }
+
+  [[nodiscard]] Subtree AsSubtree() const {
+    if (root_ == nil_) {
+      return EmptySubtree();
+    }
+    return {root_, GetBlackHeight(root_), GetLeftmost(), GetRightmost()};
+  }
+
+  [[nodiscard]] int GetBlackHeight(const NodeType *node) const {
+    int black_height = 0;
+    for (; node != nil_; node = node->GetLeft()) {
+      black_height += node->GetColor() == Color::kBlack ? 1 : 0;
+    }
+    return black_height;
+  }
+
+  /* A handful of elements is cheaper to relink one by one. With m * m <= n
+   * the O(m log n) of that stays within O(m log(n / m + 1)) */
+  [[nodiscard]] bool PrefersPointwise(size_type other_size) const {
+    return other_size != 0 && other_size <= GetSize() / other_size;
+  }
+
+  void CombinePointwise(RedBlackTree &other, SetOperation operation) {
+    NodeType *chain = other.DetachInOrder();
+    while (chain != nullptr) {
+      NodeType *node = chain;
+      chain = chain->GetRight();
+      NodeType *existing = FindNodeByKey(KeyOfValue{}(node->data_));
+      if (existing != nil_) {
+        if (operation != SetOperation::kUnion) {
+          RemoveNode(existing);
+        }
+        DestroyNode(node);
+      } else if (operation == SetOperation::kDifference) {
+        DestroyNode(node);
+      } else {
+        InsertDetachedNode(node);
+      }
+    }
+  }
+
+  void MergePointwise(RedBlackTree &other, bool unique) {
+    NodeType *chain = other.DetachInOrder();
+    while (chain != nullptr) {
+      NodeType *node = chain;
+      chain = chain->GetRight();
+      if (unique && FindNodeByKey(KeyOfValue{}(node->data_)) != nil_) {
+        other.InsertDetachedNode(node);
+      } else {
+        InsertDetachedNode(node);
+      }
+    }
+  }
+
+  /* Set algebra by one pass over both trees flattened into sorted chains,
+   * O(n + m) and no subtree counts needed. Follows std::set_union and
+   * friends, of equal keys elements of this tree win. A throwing
+   * comparison frees the nodes of both trees */
+  void CombineInOrder(RedBlackTree &other, SetOperation operation) {
+    bool keeps_mine = operation != SetOperation::kIntersection;
+    bool keeps_theirs = operation == SetOperation::kUnion ||
+                        operation == SetOperation::kSymmetricDifference;
+    bool keeps_equal = operation == SetOperation::kUnion ||
+                       operation == SetOperation::kIntersection;
+    NodeType *mine = DetachInOrder();
+    NodeType *theirs = other.DetachInOrder();
+    NodeType *kept = nullptr;
+    NodeType *kept_tail = nullptr;
+    size_type count = 0;
+    auto move_or_destroy = [&](NodeType *&chain, bool keep) {
+      NodeType *node = chain;
+      chain = chain->GetRight();
+      if (keep) {
+        AppendToChain(kept, kept_tail, node);
+        ++count;
+      } else {
+        DestroyNode(node);
+      }
+    };
+    try {
+      while (mine != nullptr && theirs != nullptr) {
+        if (Less(KeyOfValue{}(mine->data_), KeyOfValue{}(theirs->data_))) {
+          move_or_destroy(mine, keeps_mine);
+        } else if (Less(KeyOfValue{}(theirs->data_),
+                        KeyOfValue{}(mine->data_))) {
+          move_or_destroy(theirs, keeps_theirs);
+        } else {
+          move_or_destroy(mine, keeps_equal);
+          move_or_destroy(theirs, false);
+        }
+      }
+    } catch (...) {
+      DestroyChain(kept, count);
+      DestroyReusable(mine);
+      DestroyReusable(theirs);
+      throw;
+    }
+    while (mine != nullptr) {
+      move_or_destroy(mine, keeps_mine);
+    }
+    while (theirs != nullptr) {
+      move_or_destroy(theirs, keeps_theirs);
+    }
+    AdoptSubtree(BuildSubtree(kept, count));
+    SetUncountedSize(count);
+  }
+
+  /* Merge by one pass over both sorted chains in O(n + m). With unique an
+   * element of other stays there when the last merged key equals its
+   * own, which also catches the repeats of other. A throwing comparison
+   * frees the nodes of both trees */
+  void MergeInOrder(RedBlackTree &other, bool unique) {
+    NodeType *mine = DetachInOrder();
+    NodeType *theirs = other.DetachInOrder();
+    NodeType *merged = nullptr;
+    NodeType *merged_tail = nullptr;
+    size_type merged_count = 0;
+    NodeType *leftover = nullptr;
+    NodeType *leftover_tail = nullptr;
+    size_type leftover_count = 0;
+    auto move = [](NodeType *&chain, NodeType *&head, NodeType *&tail,
+                   size_type &count) {
+      NodeType *node = chain;
+      chain = chain->GetRight();
+      AppendToChain(head, tail, node);
+      ++count;
+    };
+    try {
+      while (theirs != nullptr) {
+        if (mine != nullptr && !Less(KeyOfValue{}(theirs->data_),
+                                     KeyOfValue{}(mine->data_))) {
+          move(mine, merged, merged_tail, merged_count);
+        } else if (unique && merged_count != 0 &&
+                   !Less(KeyOfValue{}(merged_tail->data_),
+                         KeyOfValue{}(theirs->data_))) {
+          move(theirs, leftover, leftover_tail, leftover_count);
+        } else {
+          move(theirs, merged, merged_tail, merged_count);
+        }
+      }
+    } catch (...) {
+      DestroyChain(merged, merged_count);
+      DestroyChain(leftover, leftover_count);
+      DestroyReusable(mine);
+      DestroyReusable(theirs);
+      throw;
+    }
+    while (mine != nullptr) {
+      move(mine, merged, merged_tail, merged_count);
+    }
+    AdoptSubtree(BuildSubtree(merged, merged_count));
+    SetUncountedSize(merged_count);
+    other.AdoptSubtree(other.BuildSubtree(leftover, leftover_count));
+    other.SetUncountedSize(leftover_count);
+  }
+
+  /* Separates the first element of every key from its repeats in O(k),
+   * walking the subtree flattened into a chain. Frees the subtree when a
+   * comparison throws */
+  std::pair<Subtree, Subtree> SplitRepeats(Subtree tree) {
+    size_type count = tree.root->GetSize();
+    NodeType *firsts = nullptr;
+    NodeType *firsts_tail = nullptr;
+    NodeType *repeats = nullptr;
+    NodeType *repeats_tail = nullptr;
+    size_type firsts_count = 0;
+    NodeType *node = FlattenSubtree(tree.root);
+    for (size_type i = 0; i < count; ++i) {
+      NodeType *next = node->GetRight();
+      bool repeat{};
+      try {
+        repeat = firsts_count != 0 && !Less(KeyOfValue{}(firsts_tail->data_),
+                                            KeyOfValue{}(node->data_));
+      } catch (...) {
+        DestroyChain(firsts, firsts_count);
+        DestroyChain(repeats, i - firsts_count);
+        DestroyChain(node, count - i);
+        throw;
+      }
+      if (repeat) {
+        AppendToChain(repeats, repeats_tail, node);
+      } else {
+        AppendToChain(firsts, firsts_tail, node);
+        ++firsts_count;
+      }
+      node = next;
+    }
+    return {BuildSubtree(firsts, firsts_count),
+            BuildSubtree(repeats, count - firsts_count)};
+  }
+
+  Subtree BuildSubtree(NodeType *chain, size_type count) {
+    if (count == 0) {
+      return EmptySubtree();
+    }
+    NodeType *first = chain;
+    NodeType *last = ThreadChain(chain, count);
+    NodeType *root = BuildFromChain(chain, count, 0, GetFloorLog2(count + 1));
+    root->SetParent(nullptr);
+    return {root, GetBlackHeight(root), first, last};
+  }
+
+  /* Empties the tree into a chain through the right links sorted by key
+   * and ended by nullptr */
+  NodeType *DetachInOrder() {
+    NodeType *chain = FlattenSubtree(root_);
+    ResetToEmpty();
+    return chain;
+  }
+
+  /* Relinks a subtree into a chain through the right links sorted by key
+   * and ended by nullptr, in O(k) without threads. The walk runs from the
+   * largest key down and only rewrites right links it has left behind */
+  NodeType *FlattenSubtree(NodeType *root) const noexcept {
+    NodeType *chain = nullptr;
+    if (root == nil_) {
+      return chain;
+    }
+    for (NodeType *node = FindMaxNode(root); node != nullptr;) {
+      NodeType *previous = node->GetParent();
+      if (node->GetLeft() != nil_) {
+        previous = FindMaxNode(node->GetLeft());
+      } else {
+        for (NodeType *child = node;
+             previous != nullptr && previous->GetLeft() == child;
+             previous = previous->GetParent()) {
+          child = previous;
+        }
+      }
+      node->SetRight(chain);
+      chain = node;
+      node = previous;
+    }
+    return chain;
+  }
+
+  static void AppendToChain(NodeType *&head, NodeType *&tail,
+                            NodeType *node) noexcept {
+    if (tail == nullptr) {
+      head = node;
+    } else {
+      tail->SetRight(node);
+    }
+    tail = node;
+  }
+
+  /* Empties other and hands its nodes over, relinked to our nil_ */
+  Subtree TakeOver(RedBlackTree &other) {
+    if (other.IsEmpty()) {
+      return EmptySubtree();
+    }
+    Subtree tree = other.AsSubtree();
+    RebindNil(tree.root, other.nil_, nil_);
+    other.ResetToEmpty();
+    return tree;
+  }
+
+  void RebindNil(NodeType *node, const NodeType *old_nil, NodeType *new_nil) {
+    if (node->GetLeft() == old_nil) {
+      node->SetLeft(new_nil);
+    } else {
+      RebindNil(node->GetLeft(), old_nil, new_nil);
+    }
+    if (node->GetRight() == old_nil) {
+      node->SetRight(new_nil);
+    } else {
+      RebindNil(node->GetRight(), old_nil, new_nil);
+    }
+  }
+
+  /* Installs a detached subtree as the whole tree of an empty one */
+  void AdoptSubtree(Subtree tree) {
+    root_ = tree.root;
+    if (root_ != nil_) {
+      ThreadNodes(nil_, tree.first);
+      ThreadNodes(tree.last, nil_);
+    }
+    RefreshExtremes();
+  }
+
+  /* Cuts a child of a black root loose as a standalone subtree */
+  Subtree DetachChild(NodeType *child, int black_height, NodeType *first,
+                      NodeType *last) {
+    if (child == nil_) {
+      return EmptySubtree();
+    }
+    child->SetParent(nullptr);
+    return {child, BlackenRoot(child, black_height), first, last};
+  }
+
+  /* The threads around the root give the extremes of both halves, which
+   * are only tracked for threaded nodes */
+  ExposedSubtree Expose(Subtree tree) {
+    NodeType *node = tree.root;
+    int black_height = tree.black_height - 1;
+    NodeType *left_last = nil_;
+    NodeType *right_first = nil_;
+    if constexpr (kThreaded) {
+      left_last = node->GetPrev();
+      right_first = node->GetNext();
+    }
+    Subtree left =
+        DetachChild(node->GetLeft(), black_height, tree.first, left_last);
+    Subtree right =
+        DetachChild(node->GetRight(), black_height, right_first, tree.last);
+    return {left, node, right};
+  }
+
+  void LinkChildren(NodeType *node, NodeType *left, NodeType *right) {
+    node->SetLeft(left);
+    node->SetRight(right);
+    if (left != nil_) {
+      left->SetParent(node);
+    }
+    if (right != nil_) {
+      right->SetParent(node);
+    }
+    CountChildren(node);
+    Pull(node);
+  }
+
+  /* Returns the black height once the root is black */
+  static int BlackenRoot(NodeType *root, int black_height) {
+    if (root->GetColor() == Color::kRed) {
+      root->SetColor(Color::kBlack);
+      ++black_height;
+    }
+    return black_height;
+  }
+
+  /* Every key of left precedes the middle key, which precedes every key of
+   * right. Costs O(|black_height(left) - black_height(right)| + 1) */
+  Subtree Join(Subtree left, NodeType *middle, Subtree right) {
+    NodeType *first = middle;
+    NodeType *last = middle;
+    if (left.root != nil_) {
+      ThreadNodes(left.last, middle);
+      first = left.first;
+    }
+    if (right.root != nil_) {
+      ThreadNodes(middle, right.first);
+      last = right.last;
+    }
+    if (left.black_height == right.black_height) {
+      LinkChildren(middle, left.root, right.root);
+      middle->SetParent(nullptr);
+      middle->SetColor(Color::kBlack);
+      return {middle, left.black_height + 1, first, last};
+    }
+    bool into_left = left.black_height > right.black_height;
+    Subtree &taller = into_left ? left : right;
+    const Subtree &shorter = into_left ? right : left;
+
+    /* Walks down the facing spine of the taller tree to the first black
+     * node whose black height matches the shorter tree */
+    NodeType *root = taller.root;
+    NodeType *parent = nullptr;
+    NodeType *node = root;
+    int black_height = taller.black_height;
+    size_type added = shorter.root->GetSize() + 1;
+    while (node->GetColor() == Color::kRed ||
+           black_height != shorter.black_height) {
+      black_height -= node->GetColor() == Color::kBlack ? 1 : 0;
+      node->SetSize(node->GetSize() + added);
+      parent = node;
+      node = into_left ? node->GetRight() : node->GetLeft();
+    }
+
+    if (into_left) {
+      LinkChildren(middle, node, shorter.root);
+      parent->SetRight(middle);
+    } else {
+      LinkChildren(middle, shorter.root, node);
+      parent->SetLeft(middle);
+    }
+    middle->SetParent(parent);
+    middle->SetColor(Color::kRed);
+    PullUpwards(parent);
+    FixRedViolation(middle, root);
+    return {root, BlackenRoot(root, taller.black_height), first, last};
+  }
+
+  /* Join without a middle node */
+  Subtree Join(Subtree left, Subtree right) {
+    if (left.root == nil_) {
+      return right;
+    }
+    if (right.root == nil_) {
+      return left;
+    }
+    auto [rest, last] = SplitLast(left);
+    return Join(rest, last, right);
+  }
+
+  std::pair<Subtree, NodeType *> SplitLast(Subtree tree) {
+    auto [left, node, right] = Expose(tree);
+    if (right.root == nil_) {
+      return {left, node};
+    }
+    auto [rest, last] = SplitLast(right);
+    return {Join(left, node, rest), last};
+  }
+
+  /* Splits off the keys less than key, or not greater than key when
+   * equal_goes_left is set, into the first subtree. Frees the subtree when
+   * a comparison throws, like the set operations built on it */
+  std::pair<Subtree, Subtree> Split(Subtree tree, const key_type &key,
+                                    bool equal_goes_left) {
+    if (tree.root == nil_) {
+      return {EmptySubtree(), EmptySubtree()};
+    }
+    auto [left, node, right] = Expose(tree);
+    try {
+      const key_type &node_key = KeyOfValue{}(node->data_);
+      bool node_goes_left =
+          equal_goes_left ? !Less(key, node_key) : Less(node_key, key);
+      if (node_goes_left) {
+        auto [below, above] = Split(Take(right), key, equal_goes_left);
+        return {Join(left, node, below), above};
+      }
+      auto [below, above] = Split(Take(left), key, equal_goes_left);
+      return {below, Join(above, node, right)};
+    } catch (...) {
+      ClearHelper(left.root);
+      ClearHelper(right.root);
+      DestroyNode(node);
+      throw;
+    }
+  }
+
+  /* Splits off the first count elements into the first subtree */
+  std::pair<Subtree, Subtree> SplitAt(Subtree tree, size_type count) {
+    if (tree.root == nil_) {
+      return {EmptySubtree(), EmptySubtree()};
+    }
+    auto [left, node, right] = Expose(tree);
+    size_type left_size = left.root->GetSize();
+    if (count <= left_size) {
+      auto [head, tail] = SplitAt(left, count);
+      return {head, Join(tail, node, right)};
+    }
+    auto [head, tail] = SplitAt(right, count - left_size - 1);
+    return {Join(left, node, head), tail};
+  }
+
+  Subtree TakeLast(Subtree tree, size_type count) {
+    auto [head, tail] = SplitAt(tree, tree.root->GetSize() - count);
+    ClearHelper(head.root);
+    return tail;
+  }
+
+  Subtree TakeFirst(Subtree tree, size_type count) {
+    auto [head, tail] = SplitAt(tree, count);
+    ClearHelper(tail.root);
+    return head;
+  }
+
+  /* Pivots on the root of first and recurses on both sides, see
+   * Blelloch, Ferizovic and Sun, "Just Join for Parallel Ordered Sets" */
+  Subtree CombineSubtrees(Subtree first, Subtree second,
+                          SetOperation operation, bool unique,
+                          std::size_t thread_count) {
+    if (first.root == nil_ || second.root == nil_) {
+      bool keep_first = operation != SetOperation::kIntersection;
+      bool keep_second = operation == SetOperation::kUnion ||
+                         operation == SetOperation::kSymmetricDifference;
+      if (!keep_first) {
+        ClearHelper(first.root);
+        first = EmptySubtree();
+      }
+      if (!keep_second) {
+        ClearHelper(second.root);
+        second = EmptySubtree();
+      }
+      return first.root != nil_ ? first : second;
+    }
+
+    bool parallel = IsWorthForking(first, second, thread_count);
+    auto [exposed_less, pivot, exposed_greater] = Expose(first);
+    Subtree first_less = exposed_less;
+    Subtree first_greater = exposed_greater;
+    LinkChildren(pivot, nil_, nil_);
+    pivot->SetParent(nullptr);
+    pivot->SetColor(Color::kBlack);
+    Subtree first_equal{pivot, 1, pivot, pivot};
+    const key_type &key = KeyOfValue{}(pivot->data_);
+    /* Each piece is taken out before the call that consumes it, whatever
+     * is still held here is freed when a comparison throws */
+    Subtree equal_left = EmptySubtree();
+    Subtree equal_right = EmptySubtree();
+    Subtree second_less = EmptySubtree();
+    Subtree second_equal = EmptySubtree();
+    Subtree below = EmptySubtree();
+    Subtree above = EmptySubtree();
+    try {
+      if (!unique) {
+        std::tie(first_less, equal_left) = Split(Take(first_less), key, false);
+        std::tie(equal_right, first_greater) =
+            Split(Take(first_greater), key, true);
+        first_equal =
+            Join(Take(equal_left), Take(first_equal).root, Take(equal_right));
+      }
+      std::tie(second_less, second) = Split(Take(second), key, false);
+      std::tie(second_equal, second) = Split(Take(second), key, true);
+
+      if (parallel) {
+        std::size_t less_threads = thread_count / 2;
+        ForkJoin(
+            [&, mine = Take(first_less), theirs = Take(second_less)] {
+              below = CombineSubtrees(mine, theirs, operation, unique,
+                                      less_threads);
+            },
+            [&, mine = Take(first_greater), theirs = Take(second)] {
+              above = CombineSubtrees(mine, theirs, operation, unique,
+                                      thread_count - less_threads);
+            });
+      } else {
+        below = CombineSubtrees(Take(first_less), Take(second_less), operation,
+                                unique, 1);
+        above = CombineSubtrees(Take(first_greater), Take(second), operation,
+                                unique, 1);
+      }
+    } catch (...) {
+      for (const Subtree &piece :
+           {first_less, first_greater, first_equal, equal_left, equal_right,
+            second, second_less, second_equal, below, above}) {
+        ClearHelper(piece.root);
+      }
+      throw;
+    }
+    Subtree equal = CombineEqual(first_equal, second_equal, operation);
+    return Join(below, equal, above);
+  }
+
+  Subtree Join(Subtree below, Subtree equal, Subtree above) {
+    if (equal.root != nil_ && equal.root->GetSize() == 1) {
+      return Join(below, equal.root, above);
+    }
+    return Join(Join(below, equal), above);
+  }
+
+  /* Returns the merged tree and the elements of second left behind */
+  std::pair<Subtree, Subtree> MergeSubtrees(Subtree first, Subtree second,
+                                            bool unique,
+                                            std::size_t thread_count) {
+    if (first.root == nil_ || second.root == nil_) {
+      return {first.root != nil_ ? first : second, EmptySubtree()};
+    }
+    bool parallel = IsWorthForking(first, second, thread_count);
+    auto [exposed_less, pivot, exposed_greater] = Expose(first);
+    Subtree first_less = exposed_less;
+    Subtree first_greater = exposed_greater;
+    const key_type &key = KeyOfValue{}(pivot->data_);
+    Subtree second_less = EmptySubtree();
+    Subtree second_equal = EmptySubtree();
+    std::pair<Subtree, Subtree> below{EmptySubtree(), EmptySubtree()};
+    std::pair<Subtree, Subtree> above{EmptySubtree(), EmptySubtree()};
+    try {
+      /* Equal keys of second land after the equal keys of first, just as
+       * repeated inserts would place them */
+      std::tie(second_less, second) = Split(Take(second), key, false);
+      if (unique) {
+        std::tie(second_equal, second) = Split(Take(second), key, true);
+      }
+      if (parallel) {
+        std::size_t less_threads = thread_count / 2;
+        ForkJoin(
+            [&, mine = Take(first_less), theirs = Take(second_less)] {
+              below = MergeSubtrees(mine, theirs, unique, less_threads);
+            },
+            [&, mine = Take(first_greater), theirs = Take(second)] {
+              above = MergeSubtrees(mine, theirs, unique,
+                                    thread_count - less_threads);
+            });
+      } else {
+        below = MergeSubtrees(Take(first_less), Take(second_less), unique, 1);
+        above = MergeSubtrees(Take(first_greater), Take(second), unique, 1);
+      }
+    } catch (...) {
+      for (const Subtree &piece :
+           {first_less, first_greater, second, second_less, second_equal,
+            below.first, below.second, above.first, above.second}) {
+        ClearHelper(piece.root);
+      }
+      DestroyNode(pivot);
+      throw;
+    }
+    return {Join(below.first, pivot, above.first),
+            Join(below.second, second_equal, above.second)};
+  }
+
+  /* Below this many elements a thread costs more than it saves */
+  static constexpr size_type kParallelGrain = size_type{1} << 14;
+
+  [[nodiscard]] static bool IsWorthForking(Subtree first, Subtree second,
+                                           std::size_t thread_count) {
+    return thread_count > 1 &&
+           first.root->GetSize() + second.root->GetSize() >= kParallelGrain;
+  }
+
+  /* Runs first_task on a worker thread and second_task on this one. Falls
+   * back to running both here when no thread can be started. Subproblems
+   * own disjoint nodes and only read nil_, so they need no locking. Both
+   * tasks always run to the end. An exception of first_task is rethrown
+   * here after the join, one of second_task takes precedence */
+  template <typename FirstTask, typename SecondTask>
+  static void ForkJoin(FirstTask first_task, SecondTask second_task) {
+    std::exception_ptr first_error{};
+    auto guarded_first_task = [&first_task, &first_error] {
+      try {
+        first_task();
+      } catch (...) {
+        first_error = std::current_exception();
+      }
+    };
+    std::thread worker{};
+    try {
+      worker = std::thread(guarded_first_task);
+    } catch (const std::system_error &) {
+      guarded_first_task();
+    }
+    try {
+      second_task();
+    } catch (...) {
+      if (worker.joinable()) {
+        worker.join();
+      }
+      throw;
+    }
+    if (worker.joinable()) {
+      worker.join();
+    }
+    if (first_error) {
+      std::rethrow_exception(first_error);
+    }
+  }
+
+  /* Both subtrees hold elements with one and the same key */
+  Subtree CombineEqual(Subtree first, Subtree second, SetOperation operation) {
+    size_type first_count = first.root->GetSize();
+    size_type second_count = second.root->GetSize();
+    Subtree result = EmptySubtree();
+    switch (operation) {
+      case SetOperation::kUnion:
+        if (second_count > first_count) {
+          return Join(first, TakeLast(second, second_count - first_count));
+        }
+        result = first;
+        break;
+      case SetOperation::kIntersection:
+        result = TakeFirst(first, std::min(first_count, second_count));
+        break;
+      case SetOperation::kDifference:
+      case SetOperation::kSymmetricDifference:
+        if (first_count > second_count) {
+          result = TakeLast(first, first_count - second_count);
+        } else {
+          ClearHelper(first.root);
+          if (operation == SetOperation::kSymmetricDifference &&
+              second_count > first_count) {
+            return TakeLast(second, second_count - first_count);
+          }
+        }
+        break;
+    }
+    ClearHelper(second.root);
+    return result;
+  }
+
+  /* Bound searches below node, bound is the answer if none qualifies */
+  template <typename K>
+  NodeType *FindLowerBound(NodeType *node, const K &key,
+                           NodeType *bound) const {
+    size_type path = 0;
+    for (; node != nil_; ++path) {
+      if (Less(KeyOfValue{}(node->data_), key)) {
+        node = node->GetRight();
+      } else {
+        bound = node;
+        node = node->GetLeft();
+      }
+    }
+    Stats::OnSearch(path);
+    return bound;
+  }
+
+  template <typename K>
+  NodeType *FindUpperBound(NodeType *node, const K &key,
+                           NodeType *bound) const {
+    size_type path = 0;
+    for (; node != nil_; ++path) {
+      if (Less(key, KeyOfValue{}(node->data_))) {
+        bound = node;
+        node = node->GetLeft();
+      } else {
+        node = node->GetRight();
+      }
+    }
+    Stats::OnSearch(path);
+    return bound;
+  }
+
+  /* Key-only descent: mapped values are never compared */
+  template <typename K>
+  NodeType *FindNodeByKey(const K &key) const {
+    NodeType *node = root_;
+    size_type path = 0;
+    for (; node != nil_; ++path) {
+      const key_type &node_key = KeyOfValue{}(node->data_);
+      if (Less(key, node_key)) {
+        node = node->GetLeft();
+      } else if (Less(node_key, key)) {
+        node = node->GetRight();
+      } else {
+        Stats::OnSearch(path + 1);
+        return node;
+      }
+    }
+    Stats::OnSearch(path);
+    return nil_;
+  }
+
+  /* Follows the nodes in order and checks each is threaded after previous */
+  bool ValidateThreads(const NodeType *node, const NodeType *&previous) const {
+    if (node == nil_) {
+      return true;
+    }
+    if (!ValidateThreads(node->GetLeft(), previous) ||
+        previous->GetNext() != node || node->GetPrev() != previous) {
+      return false;
+    }
+    previous = node;
+    return ValidateThreads(node->GetRight(), previous);
+  }
+
+  /* Black height of the subtree or -1 if it breaks an invariant */
+  int ValidateHelper(const NodeType *node) const {
+    if (node == nil_) {
+      return 0;
+    }
+    const NodeType *left = node->GetLeft();
+    const NodeType *right = node->GetRight();
+    const key_type &key = KeyOfValue{}(node->data_);
+    if (left != nil_ &&
+        (left->GetParent() != node || Less(key, KeyOfValue{}(left->data_)))) {
+      return -1;
+    }
+    if (right != nil_ &&
+        (right->GetParent() != node || Less(KeyOfValue{}(right->data_), key))) {
+      return -1;
+    }
+    if (node->GetColor() == Color::kRed &&
+        (left->GetColor() == Color::kRed || right->GetColor() == Color::kRed)) {
+      return -1;
+    }
+    if constexpr (kCounted) {
+      if (node->GetSize() != left->GetSize() + right->GetSize() + 1) {
+        return -1;
+      }
+    }
+    if constexpr (kAggregated) {
+      if (!(node->GetAggregate() ==
+            Aggregate::Combine(Aggregate::Combine(SummaryOf(left),
+                                                  Aggregate::Lift(node->data_)),
+                               SummaryOf(right)))) {
+        return -1;
+      }
+    }
+    int left_height = ValidateHelper(left);
+    int right_height = ValidateHelper(right);
+    if (left_height < 0 || left_height != right_height) {
+      return -1;
     }
+    return left_height + (node->GetColor() == Color::kBlack ? 1 : 0);
   }
 
-  void PrintHelper(Node<T> *root, std::string indent, bool last) const {
+  void PrintHelper(NodeType *root, std::string indent, bool last) const {
     if (root != nil_) {
       std::cerr << indent;
       if (last) {
@@ -615,14 +2590,15 @@ class RedBlackTree {
         std::cerr << "L----";
         indent += "|    ";
       }
-      std::string print_color = root->color_ == Color::kRed ? "RED" : "BLACK";
+      std::string print_color =
+          root->GetColor() == Color::kRed ? "RED" : "BLACK";
       std::cerr << root->data_ << "(" << print_color << ")"
                 << "\n";
-      PrintHelper(root->left_, indent, false);
-      PrintHelper(root->right_, indent, true);
+      PrintHelper(root->GetLeft(), indent, false);
+      PrintHelper(root->GetRight(), indent, true);
     }
   }
 };
 }  // namespace s21
 
-#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_RED_BLACK_TREE_H_
\ No newline at end of file
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_RED_BLACK_TREE_H_
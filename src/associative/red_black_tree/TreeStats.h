@@ -0,0 +1,113 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_TREE_STATS_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_TREE_STATS_H_
+
+#include <atomic>
+#include <cstddef>
+
+namespace s21 {
+/* What a RedBlackTree did since it was built or its counters were reset.
+ * Search paths are counted in nodes visited by key descents */
+struct TreeCounters {
+  std::size_t comparisons{};
+  std::size_t rotations{};
+  std::size_t insert_fixups{}; /* Red rule repair steps, joins included */
+  std::size_t erase_fixups{};
+  std::size_t allocations{};
+  std::size_t deallocations{};
+  std::size_t searches{};
+  std::size_t search_path_nodes{};
+  std::size_t max_search_path{};
+};
+
+/* Statistics policies of RedBlackTree. NoTreeStats compiles every hook
+ * away and takes no space */
+struct NoTreeStats {
+  void OnCompare() const noexcept {}
+
+  void OnRotate() const noexcept {}
+
+  void OnInsertFixup() const noexcept {}
+
+  void OnEraseFixup() const noexcept {}
+
+  void OnAllocate() const noexcept {}
+
+  void OnDeallocate() const noexcept {}
+
+  void OnSearch(std::size_t) const noexcept {}
+};
+
+/* Counts into relaxed atomics, so the worker threads of a parallel set
+ * operation add up exactly. Counters stay with their tree, copies start
+ * from zero */
+class TreeStats {
+ public:
+  TreeStats() = default;
+
+  TreeStats(const TreeStats &) noexcept {}
+
+  TreeStats &operator=(const TreeStats &) noexcept { return *this; }
+
+  void OnCompare() const noexcept { Bump(comparisons_); }
+
+  void OnRotate() const noexcept { Bump(rotations_); }
+
+  void OnInsertFixup() const noexcept { Bump(insert_fixups_); }
+
+  void OnEraseFixup() const noexcept { Bump(erase_fixups_); }
+
+  void OnAllocate() const noexcept { Bump(allocations_); }
+
+  void OnDeallocate() const noexcept { Bump(deallocations_); }
+
+  void OnSearch(std::size_t path) const noexcept {
+    Bump(searches_);
+    Bump(search_path_nodes_, path);
+    std::size_t longest = max_search_path_.load(std::memory_order_relaxed);
+    while (path > longest &&
+           !max_search_path_.compare_exchange_weak(
+               longest, path, std::memory_order_relaxed)) {
+    }
+  }
+
+  [[nodiscard]] TreeCounters GetCounters() const noexcept {
+    return {Load(comparisons_),   Load(rotations_),
+            Load(insert_fixups_), Load(erase_fixups_),
+            Load(allocations_),   Load(deallocations_),
+            Load(searches_),      Load(search_path_nodes_),
+            Load(max_search_path_)};
+  }
+
+  void ResetCounters() noexcept {
+    for (Counter *counter :
+         {&comparisons_, &rotations_, &insert_fixups_, &erase_fixups_,
+          &allocations_, &deallocations_, &searches_, &search_path_nodes_,
+          &max_search_path_}) {
+      counter->store(0, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  using Counter = std::atomic<std::size_t>;
+
+  static void Bump(Counter &counter, std::size_t count = 1) noexcept {
+    counter.fetch_add(count, std::memory_order_relaxed);
+  }
+
+  static std::size_t Load(const Counter &counter) noexcept {
+    return counter.load(std::memory_order_relaxed);
+  }
+
+  mutable Counter comparisons_{};
+  mutable Counter rotations_{};
+  mutable Counter insert_fixups_{};
+  mutable Counter erase_fixups_{};
+  mutable Counter allocations_{};
+  mutable Counter deallocations_{};
+  mutable Counter searches_{};
+  mutable Counter search_path_nodes_{};
+  mutable Counter max_search_path_{};
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RED_BLACK_TREE_TREE_STATS_H_
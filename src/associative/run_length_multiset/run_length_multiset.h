@@ -0,0 +1,258 @@
+#ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RUN_LENGTH_MULTISET_RUN_LENGTH_MULTISET_H_
+#define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RUN_LENGTH_MULTISET_RUN_LENGTH_MULTISET_H_
+
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "../map/map.h"
+
+namespace s21 {
+/* Multiset that keeps one node per distinct key together with the number
+ * of its copies, so memory grows with the distinct keys rather than with
+ * the inserts. Copies of a key are indistinguishable: inserting a present
+ * key bumps its count, erasing one copy lowers it. Iteration still visits
+ * every copy. Erasing a copy invalidates only the iterators to the last
+ * copy of that key */
+template <typename Key, typename Compare = std::less<Key>,
+          typename NodeAllocator = HeapNodeAllocator>
+class run_length_multiset {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using const_reference = const value_type &;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  /* Distinct key -> number of copies */
+  using run_map = map<Key, size_type, Compare, NodeAllocator>;
+
+  /* Walks the runs and repeats each key count times */
+  class RunLengthIterator {
+    using RunIterator = typename run_map::iterator;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key *;
+    using reference = const Key &;
+
+    RunLengthIterator() = default;
+
+    reference operator*() const { return run_->first; }
+
+    pointer operator->() const { return &run_->first; }
+
+    RunLengthIterator &operator++() {
+      if (++copy_ == run_->second) {
+        ++run_;
+        copy_ = 0;
+      }
+      return *this;
+    }
+
+    RunLengthIterator operator++(int) {
+      RunLengthIterator copy{*this};
+      ++*this;
+      return copy;
+    }
+
+    RunLengthIterator &operator--() {
+      if (copy_ == 0) {
+        --run_;
+        copy_ = run_->second;
+      }
+      --copy_;
+      return *this;
+    }
+
+    RunLengthIterator operator--(int) {
+      RunLengthIterator copy{*this};
+      --*this;
+      return copy;
+    }
+
+    bool operator==(const RunLengthIterator &other) const {
+      return run_ == other.run_ && copy_ == other.copy_;
+    }
+
+    bool operator!=(const RunLengthIterator &other) const {
+      return !(*this == other);
+    }
+
+    /* Zero-based index of this copy among the copies of its key */
+    [[nodiscard]] size_type copy_index() const { return copy_; }
+
+   private:
+    friend class run_length_multiset;
+
+    RunLengthIterator(RunIterator run, size_type copy)
+        : run_(run), copy_(copy) {}
+
+    RunIterator run_{};
+    size_type copy_{0};
+  };
+
+  using iterator = RunLengthIterator;
+  using const_iterator = RunLengthIterator;
+
+ public: /* Member */
+  run_length_multiset() = default;
+
+  explicit run_length_multiset(const Compare &compare) : runs_(compare) {}
+
+  run_length_multiset(std::initializer_list<value_type> const &items) {
+    insert_range(items.begin(), items.end());
+  }
+
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  run_length_multiset(InputIt first, InputIt last) {
+    insert_range(first, last);
+  }
+
+ public: /* Iterators */
+  [[nodiscard]] const_iterator begin() const { return {runs_.begin(), 0}; }
+
+  [[nodiscard]] const_iterator end() const { return {runs_.end(), 0}; }
+
+ public: /* Element access */
+  /* Smallest and largest keys, the multiset must not be empty */
+  [[nodiscard]] const_reference front() const { return runs_.front().first; }
+
+  [[nodiscard]] const_reference back() const { return runs_.back().first; }
+
+  /* The underlying key -> count map, one element per distinct key */
+  [[nodiscard]] const run_map &runs() const { return runs_; }
+
+ public: /* Capacity */
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+
+  /* Number of copies, counted the same way as in multiset */
+  [[nodiscard]] size_type size() const { return size_; }
+
+  [[nodiscard]] size_type distinct_size() const { return runs_.size(); }
+
+  [[nodiscard]] size_type max_size() const { return runs_.max_size(); }
+
+ public: /* Modifiers */
+  void clear() {
+    runs_.clear();
+    size_ = 0;
+  }
+
+  /* O(log n), allocates a node only for a new key. Returns the last copy */
+  iterator insert(const value_type &value) { return insert(value, 1); }
+
+  /* Adds count copies at once, end() when count is zero */
+  iterator insert(const value_type &value, size_type count) {
+    if (count == 0) {
+      return end();
+    }
+    auto [run, inserted] = runs_.try_emplace(value, 0);
+    run->second += count;
+    size_ += count;
+    return {run, run->second - 1};
+  }
+
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  void insert_range(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      insert(*first);
+    }
+  }
+
+  /* Removes every copy of key and returns how many there were */
+  size_type erase(const key_type &key) { return erase(key, max_size()); }
+
+  /* Removes up to count copies of key, returns how many were removed */
+  size_type erase(const key_type &key, size_type count) {
+    auto run = runs_.find(key);
+    if (run == runs_.end() || count == 0) {
+      return 0;
+    }
+    if (count < run->second) {
+      run->second -= count;
+    } else {
+      count = run->second;
+      runs_.erase(run);
+    }
+    size_ -= count;
+    return count;
+  }
+
+  /* Removes one copy of the key at position, through its run without
+   * searching again */
+  void erase(const_iterator position) {
+    if (--position.run_->second == 0) {
+      runs_.erase(position.run_);
+    }
+    --size_;
+  }
+
+  void swap(run_length_multiset &other) noexcept {
+    runs_.swap(other.runs_);
+    std::swap(size_, other.size_);
+  }
+
+  /* Moves every copy of other into this multiset */
+  void merge(run_length_multiset &other) {
+    for (const auto &[key, count] : other.runs_) {
+      insert(key, count);
+    }
+    other.clear();
+  }
+
+ public: /* Lookup */
+  /* Each is a single O(log n) descent whatever the number of copies */
+  [[nodiscard]] size_type count(const key_type &key) const {
+    auto run = runs_.find(key);
+    return run == runs_.end() ? 0 : run->second;
+  }
+
+  [[nodiscard]] bool contains(const key_type &key) const {
+    return runs_.contains(key);
+  }
+
+  /* First copy of key, end() if there is none */
+  [[nodiscard]] const_iterator find(const key_type &key) const {
+    return {runs_.find(key), 0};
+  }
+
+  [[nodiscard]] const_iterator lower_bound(const key_type &key) const {
+    return {runs_.lower_bound(key), 0};
+  }
+
+  [[nodiscard]] const_iterator upper_bound(const key_type &key) const {
+    return {runs_.upper_bound(key), 0};
+  }
+
+  [[nodiscard]] std::pair<const_iterator, const_iterator> equal_range(
+      const key_type &key) const {
+    auto [lower, upper] = runs_.equal_range(key);
+    return {{lower, 0}, {upper, 0}};
+  }
+
+ public: /* Observers */
+  [[nodiscard]] key_compare key_comp() const { return runs_.key_comp(); }
+
+  [[nodiscard]] value_compare value_comp() const { return runs_.key_comp(); }
+
+ public: /* Run access */
+  /* Calls function(key, count) once per distinct key in order */
+  template <typename Function>
+  void for_each_run(Function function) const {
+    for (const auto &[key, count] : runs_) {
+      function(key, count);
+    }
+  }
+
+ private:
+  run_map runs_;
+  size_type size_{0};
+};
+}  // namespace s21
+
+#endif  // CPP2_S21_CONTAINERS_1_ASSOCIATIVE_RUN_LENGTH_MULTISET_RUN_LENGTH_MULTISET_H_
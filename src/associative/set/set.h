@@ -4,86 +4,189 @@
 #include "../set_base/set_base.h"
 
 namespace s21 {
-template <typename Key>
-class set : public set_base<Key> {
+template <typename Key, typename Compare, typename NodeAllocator,
+          typename Stats>
+class multiset;
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename NodeAllocator = HeapNodeAllocator,
+          typename Stats = NoTreeStats>
+class set : public set_base<Key, Compare, NodeAllocator, Stats> {
   using key_type = Key;
   using value_type = Key;
   using reference = value_type &;
   using const_reference = const value_type &;
 
-  using RedBlackTreeType = RedBlackTree<Key>;
-  using iterator = typename RedBlackTreeType::const_iterator;
-  using const_iterator = typename RedBlackTreeType::const_iterator;
+  using TreeType =
+      typename set_base<Key, Compare, NodeAllocator, Stats>::TreeType;
+  using iterator = typename TreeType::const_iterator;
+  using const_iterator = typename TreeType::const_iterator;
 
   using size_type = std::size_t;
 
+ public:
+  using node_type = typename TreeType::node_type;
+  using insert_return_type = InsertReturnType<iterator, node_type>;
+
  public: /* Member */
   set() = default;
 
   set(std::initializer_list<value_type> const &items) {
-    for (const auto &item : items) {
-      insert(item);
-    }
+    this->tree_.Assign(items.begin(), items.end(), true);
   };
 
-  set(const set &other) {
-    iterator other_iterator = other.begin();
-    while (other_iterator != other.end()) {
-      insert(*other_iterator);
-      ++other_iterator;
-    }
+  /* Sorted forward ranges are built in O(n) */
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  set(InputIt first, InputIt last) {
+    this->tree_.Assign(first, last, true);
   }
 
+  explicit set(const Compare &compare)
+      : set_base<Key, Compare, NodeAllocator, Stats>(compare) {}
+
+  set(const set &other)
+      : set_base<Key, Compare, NodeAllocator, Stats>(other) {}
+
   set(set &&other) noexcept { this->tree_ = std::move(other.tree_); }
 
   ~set() = default;
 
  public: /* Operators */
-  set<Key> &operator=(const set &other) {
+  set &operator=(const set &other) {
     this->tree_ = other.tree_;
-    iterator other_iterator = other.begin();
-    while (other_iterator != other.end()) {
-      insert(*other_iterator);
-      ++other_iterator;
-    }
     return *this;
   }
 
-  set<Key> &operator=(set &&other) noexcept {
+  set &operator=(set &&other) noexcept {
     this->tree_ = std::move(other.tree_);
     return *this;
   }
 
  public: /* Modifiers */
-  void merge(set &other) {
-    for (const auto &item : other) {
-      insert(item);
-    }
-    other.clear();
+  /* Replaces the content in O(n), [first, last) must be sorted */
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    this->tree_.AssignSorted(first, last, true);
+  }
+
+  /* Moves the elements of other with new keys, the rest stay in other.
+   * Large merges with BTreeNodes or UncountedNodes take one O(n + m) pass
+   * on the calling thread and ignore thread_count */
+  void merge(set &other, std::size_t thread_count = 1) {
+    this->tree_.Merge(other.tree_, true, thread_count);
   }
 
+  /* Keys repeated in other or already present here stay in other */
+  void merge(multiset<Key, Compare, NodeAllocator, Stats> &other,
+             std::size_t thread_count = 1) {
+    this->tree_.Merge(this->GetTree(other), true, thread_count, false);
+  }
+
+  /* One descent, nothing is allocated when the key is present */
   std::pair<iterator, bool> insert(const Key &value) {
-    std::pair<iterator, bool> result{};
-    result.first = this->find(value);
-    if (result.first != this->end()) {
-      return result;
-    }
-    result.first = this->tree_.Insert(value);
-    result.second = true;
-    return result;
+    auto [node, inserted] = this->tree_.InsertUnique(value);
+    return {iterator(node), inserted};
+  }
+
+  std::pair<iterator, bool> insert(Key &&value) {
+    auto [node, inserted] = this->tree_.InsertUnique(std::move(value));
+    return {iterator(node), inserted};
   }
 
+  /* Amortized O(1) when value belongs right before hint, end() included */
+  iterator insert(const_iterator hint, const Key &value) {
+    auto [node, inserted] = this->tree_.InsertHint(hint.base(), value, true);
+    return iterator(node);
+  }
+
+  iterator insert(const_iterator hint, Key &&value) {
+    auto [node, inserted] =
+        this->tree_.InsertHint(hint.base(), std::move(value), true);
+    return iterator(node);
+  }
+
+  /* The element is built in place inside its node, which is freed again
+   * when the key turns out to be present */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    auto [node, inserted] = this->tree_.EmplaceHint(
+        this->tree_.GetNil(), true, std::forward<Args>(args)...);
+    return {iterator(node), inserted};
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args) {
+    auto [node, inserted] = this->tree_.EmplaceHint(
+        hint.base(), true, std::forward<Args>(args)...);
+    return iterator(node);
+  }
+
+  /* Relinks the node of handle, on a duplicate key the handle is returned
+   * in the result untouched */
+  template <typename Tree = TreeType, typename = RequireNodeHandles<Tree>>
+  insert_return_type insert(node_type &&handle) {
+    auto [node, inserted] =
+        this->tree_.InsertNode(this->tree_.GetNil(), handle, true);
+    return {iterator(node), inserted, std::move(handle)};
+  }
+
+  /* On a duplicate key the handle keeps its node */
+  template <typename Tree = TreeType, typename = RequireNodeHandles<Tree>>
+  iterator insert(const_iterator hint, node_type &&handle) {
+    auto [node, inserted] = this->tree_.InsertNode(hint.base(), handle, true);
+    return iterator(node);
+  }
+
+  /* Every argument is forwarded into its own element */
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args &&...args) {
-    std::initializer_list<value_type> items = {std::forward<Args>(args)...};
     std::vector<std::pair<iterator, bool>> result{};
-
-    for (const_reference item : items) {
-      std::pair<iterator, bool> pair = this->insert(item);
-      result.push_back(pair);
-    }
+    result.reserve(sizeof...(Args));
+    (result.push_back(emplace(std::forward<Args>(args))), ...);
     return result;
   }
+
+  /* Inserts an unsorted batch with one sort and one merge instead of a
+   * descent per element, see InsertBatch. Returns how many were new */
+  template <typename InputIt, typename = RequireInputIterator<InputIt>>
+  size_type insert_batch(InputIt first, InputIt last) {
+    return InsertBatch<Key, IdentityKey<Key>>(this->tree_, first, last, true,
+                                              nullptr);
+  }
+
+  /* Also writes the keys that were new to new_keys in order */
+  template <typename InputIt, typename OutputIt,
+            typename = RequireInputIterator<InputIt>>
+  size_type insert_batch(InputIt first, InputIt last, OutputIt new_keys) {
+    return InsertBatch<Key, IdentityKey<Key>>(this->tree_, first, last, true,
+                                              new_keys);
+  }
+
+ public: /* Set algebra */
+  /* Each runs in O(m log(n / m + 1)) and relinks the nodes of other instead
+   * of copying them, pass an rvalue to skip the copy of other itself.
+   * Large inputs are split by key range across thread_count threads. With
+   * BTreeNodes or UncountedNodes both are merged in one O(n + m) pass on
+   * the calling thread instead and thread_count is ignored */
+  void set_union(set other, std::size_t thread_count = 1) {
+    this->tree_.Combine(std::move(other.tree_), SetOperation::kUnion, true,
+                        thread_count);
+  }
+
+  void set_intersection(set other, std::size_t thread_count = 1) {
+    this->tree_.Combine(std::move(other.tree_), SetOperation::kIntersection,
+                        true, thread_count);
+  }
+
+  void set_difference(set other, std::size_t thread_count = 1) {
+    this->tree_.Combine(std::move(other.tree_), SetOperation::kDifference, true,
+                        thread_count);
+  }
+
+  void symmetric_difference(set other, std::size_t thread_count = 1) {
+    this->tree_.Combine(std::move(other.tree_),
+                        SetOperation::kSymmetricDifference, true, thread_count);
+  }
 };
 }  // namespace s21
 
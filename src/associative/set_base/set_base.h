@@ -1,10 +1,12 @@
 #ifndef CPP2_S21_CONTAINERS_1_ASSOCIATIVE_SET_BASE_SET_BASE_H_
 #define CPP2_S21_CONTAINERS_1_ASSOCIATIVE_SET_BASE_SET_BASE_H_
 
-#include "../red_black_tree/RedBlackTree.h"
+#include "../b_tree/TreeBackend.h"
 
 namespace s21 {
-template <typename Key>
+template <typename Key, typename Compare = std::less<Key>,
+          typename NodeAllocator = HeapNodeAllocator,
+          typename Stats = NoTreeStats>
 class set_base {
  public:
   using key_type = Key;
@@ -12,11 +14,27 @@ class set_base {
   using reference = value_type &;
   using const_reference = const value_type &;
 
-  using RedBlackTreeType = RedBlackTree<Key>;
-  using iterator = typename RedBlackTreeType::const_iterator;
-  using const_iterator = typename RedBlackTreeType::const_iterator;
+  using key_compare = Compare;
+  using value_compare = Compare;
+
+  /* A RedBlackTree on NodeAllocator, or a BTree for BTreeNodes */
+  using TreeType = TreeFor<Key, IdentityKey<Key>, Compare, NodeAllocator,
+                           NoAggregate, Stats>;
+  using iterator = typename TreeType::const_iterator;
+  using const_iterator = typename TreeType::const_iterator;
 
   using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using node_type = typename TreeType::node_type;
+  using scan_iterator =
+      typename TreeType::template ScanIteratorBase<true>;
+  using scan_range = ScanRange<scan_iterator>;
+  using range_type = ScanRange<const_iterator>;
+
+ public: /* Member */
+  set_base() = default;
+
+  explicit set_base(const Compare &compare) : tree_(compare) {}
 
  public: /* Iterators */
   iterator begin() { return tree_.begin(); }
@@ -27,13 +45,59 @@ class set_base {
 
   const_iterator end() const { return tree_.end(); }
 
+ public: /* Element access */
+  /* Smallest and largest elements in O(1), the set must not be empty */
+  [[nodiscard]] const_reference front() const { return *begin(); }
+
+  [[nodiscard]] const_reference back() const { return *std::prev(end()); }
+
  public: /* Modifiers */
   void clear() { tree_.Clear(); }
 
   void erase(const value_type &value) { tree_.Remove(value); }
 
+  /* Erases [first, last) in O(k + log n) and returns last */
+  iterator erase(const_iterator first, const_iterator last) {
+    return iterator(tree_.EraseRange(first.base(), last.base()));
+  }
+
+  /* Erases every element in [low, high), returns how many there were */
+  size_type erase_range(const key_type &low, const key_type &high) {
+    auto [first, last] = tree_.RangeBounds(low, high);
+    size_type old_size = size();
+    tree_.EraseRange(first, last);
+    return old_size - size();
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>,
+            typename = std::enable_if_t<!std::is_convertible_v<K, iterator>>>
+  void erase(const K &key) {
+    tree_.RemoveByKey(key);
+  }
+
   void swap(set_base &other) { std::swap(tree_, other.tree_); }
 
+  /* Unlinks the element in O(log n) without copying or freeing it, an
+   * empty handle if there is nothing to extract. Of equal keys the first
+   * one is taken. Node handles are left out with BTreeNodes */
+  template <typename Tree = TreeType, typename = RequireNodeHandles<Tree>>
+  node_type extract(const_iterator position) {
+    return tree_.Extract(position.base());
+  }
+
+  template <typename Tree = TreeType, typename = RequireNodeHandles<Tree>>
+  node_type extract(const key_type &key) {
+    iterator position = lower_bound(key);
+    if (position != end() && key_comp()(key, *position)) {
+      return node_type{};
+    }
+    return tree_.Extract(position.base());
+  }
+
+  /* Pre-allocates nodes so the next count inserts skip the heap, only
+   * SlabNodeAllocator keeps them */
+  void reserve_nodes(size_type count) { tree_.ReserveNodes(count); }
+
  public: /* Capacity */
   [[nodiscard]] size_t max_size() const { return tree_.GetMaxSize(); }
 
@@ -43,25 +107,130 @@ class set_base {
 
  public: /* Lookup */
   [[nodiscard]] iterator find(const value_type &value) const {
-    iterator iter = begin();
-    iterator end_iter = end();
-
-    while (iter != end_iter) {
-      if (*iter == value) {
-        return iter;
-      }
-      ++iter;
-    }
-
-    return end();
+    return iterator(tree_.SearchByKey(value));
   }
 
   [[nodiscard]] bool contains(const value_type &value) const {
-    return tree_.Search(value) != nullptr;
+    return tree_.SearchByKey(value) != tree_.GetNil();
+  }
+
+  [[nodiscard]] size_type count(const key_type &key) const {
+    return tree_.CountKey(key);
+  }
+
+  /* Bounds are O(log n) and end() when no element qualifies */
+  [[nodiscard]] iterator lower_bound(const key_type &key) const {
+    return iterator(tree_.LowerBound(key));
+  }
+
+  [[nodiscard]] iterator upper_bound(const key_type &key) const {
+    return iterator(tree_.UpperBound(key));
+  }
+
+  [[nodiscard]] std::pair<iterator, iterator> equal_range(
+      const key_type &key) const {
+    auto [lower, upper] = tree_.EqualRange(key);
+    return {iterator(lower), iterator(upper)};
+  }
+
+  /* Heterogeneous lookups, only with a transparent Compare. The argument is
+   * compared against stored keys as is, no key_type is built */
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] iterator find(const K &key) const {
+    return iterator(tree_.SearchByKey(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] bool contains(const K &key) const {
+    return tree_.SearchByKey(key) != tree_.GetNil();
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] size_type count(const K &key) const {
+    return tree_.CountKey(key);
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] iterator lower_bound(const K &key) const {
+    return iterator(tree_.LowerBound(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] iterator upper_bound(const K &key) const {
+    return iterator(tree_.UpperBound(key));
+  }
+
+  template <typename K, typename = RequireTransparent<Compare, K>>
+  [[nodiscard]] std::pair<iterator, iterator> equal_range(const K &key) const {
+    auto [lower, upper] = tree_.EqualRange(key);
+    return {iterator(lower), iterator(upper)};
+  }
+
+ public: /* Observers */
+  [[nodiscard]] key_compare key_comp() const { return tree_.GetCompare(); }
+
+  [[nodiscard]] value_compare value_comp() const { return tree_.GetCompare(); }
+
+ public: /* Order statistics */
+  /* Number of elements less than the key */
+  [[nodiscard]] size_type rank(const key_type &key) const {
+    return tree_.GetRank(key);
+  }
+
+  /* Zero-based k-th smallest element, end() if k >= size() */
+  [[nodiscard]] iterator select(size_type k) const {
+    return iterator(tree_.Select(k));
+  }
+
+  [[nodiscard]] iterator advance(const_iterator position,
+                                 difference_type n) const {
+    return iterator(tree_.Advance(position.base(), n));
+  }
+
+  /* Number of elements in [low, high) */
+  [[nodiscard]] size_type count_range(const key_type &low,
+                                      const key_type &high) const {
+    return tree_.CountRange(low, high);
+  }
+
+ public: /* Statistics */
+  /* Work done by the tree since it was built or reset_stats, only with
+   * Stats = TreeStats */
+  [[nodiscard]] TreeCounters stats() const { return tree_.GetCounters(); }
+
+  void reset_stats() { tree_.ResetCounters(); }
+
+ public: /* Range scans */
+  /* Visits the elements in [low, high) in order, prefetching the next
+   * step. Suits long scans of large sets, more so with ThreadedNodes */
+  template <typename Function>
+  void for_each_range(const key_type &low, const key_type &high,
+                      Function function) const {
+    tree_.ForEachRange(low, high, [&function](const value_type &value) {
+      function(value);
+    });
+  }
+
+  /* Forward range over [low, high) with the same prefetching */
+  [[nodiscard]] scan_range scan(const key_type &low,
+                                const key_type &high) const {
+    auto [first, last] = tree_.RangeBounds(low, high);
+    return {scan_iterator(first), scan_iterator(last)};
+  }
+
+  /* Bidirectional view of the elements in [low, high). Both ends are found
+   * up front, iterating then follows the node links without searching */
+  [[nodiscard]] range_type range(const key_type &low,
+                                 const key_type &high) const {
+    auto [first, last] = tree_.RangeBounds(low, high);
+    return {const_iterator(first), const_iterator(last)};
   }
 
  protected:
-  RedBlackTreeType tree_;
+  /* Lets set and multiset reach each other's tree for merge */
+  static TreeType &GetTree(set_base &other) { return other.tree_; }
+
+  TreeType tree_;
 };
 }  // namespace s21
 
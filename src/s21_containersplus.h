@@ -1,7 +1,15 @@
 #ifndef CPP2_S21_CONTAINERS_1_S21_CONTAINERSPLUS_H_
 #define CPP2_S21_CONTAINERS_1_S21_CONTAINERSPLUS_H_
 
+#include "associative/concurrent_map/concurrent_map.h"
+#include "associative/flat_map/flat_map.h"
+#include "associative/flat_set/flat_set.h"
+#include "associative/interval_map/interval_map.h"
+#include "associative/interval_set/interval_set.h"
 #include "associative/multiset/multiset.h"
+#include "associative/persistent_map/persistent_map.h"
+#include "associative/persistent_set/persistent_set.h"
+#include "associative/run_length_multiset/run_length_multiset.h"
 #include "sequence/array/array.h"
 
 #endif  // CPP2_S21_CONTAINERS_1_S21_CONTAINERSPLUS_H_
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <initializer_list>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <utility>
 
 namespace s21 {
 template <typename T>
@@ -201,7 +203,7 @@ class list {
     while (current != tail_) {
       Node *old_node{current};
       current = current->next;
-      delete old_node;
+      destroy_node(old_node);
     }
 
     link_head_and_tail();
@@ -210,19 +212,22 @@ class list {
   }
 
   iterator insert(iterator position, const_reference value) {
-    Node *new_node{new Node{value}};
-    if (size_ == 0) {
-      head_->next = new_node;
-      tail_->prev = new_node;
-      new_node->next = tail_;
-      new_node->prev = head_;
-    } else {
-      Node *node_at_position{position.base()};
-      new_node->prev = node_at_position->prev;
-      new_node->next = node_at_position;
-      node_at_position->prev->next = new_node;
-      node_at_position->prev = new_node;
-    }
+    return emplace(position, value);
+  }
+
+  iterator insert(iterator position, value_type &&value) {
+    return emplace(position, std::move(value));
+  }
+
+  /* Builds the element in place inside the new node */
+  template <typename... Args>
+  iterator emplace(const_iterator position, Args &&...args) {
+    Node *new_node{new Node{std::in_place, std::forward<Args>(args)...}};
+    Node *node_at_position{position.base()};
+    new_node->prev = node_at_position->prev;
+    new_node->next = node_at_position;
+    node_at_position->prev->next = new_node;
+    node_at_position->prev = new_node;
 
     ++size_;
 
@@ -235,16 +240,30 @@ class list {
     Node *node_at_position{position.base()};
     node_at_position->prev->next = node_at_position->next;
     node_at_position->next->prev = node_at_position->prev;
-    delete node_at_position;
+    destroy_node(node_at_position);
 
     --size_;
   }
 
-  void push_back(const_reference value) { insert(end(), value); }
+  void push_back(const_reference value) { emplace(cend(), value); }
+
+  void push_back(value_type &&value) { emplace(cend(), std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    return *emplace(cend(), std::forward<Args>(args)...);
+  }
 
   void pop_back() { erase(std::prev(end())); }
 
-  void push_front(const_reference value) { insert(begin(), value); }
+  void push_front(const_reference value) { emplace(cbegin(), value); }
+
+  void push_front(value_type &&value) { emplace(cbegin(), std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_front(Args &&...args) {
+    return *emplace(cbegin(), std::forward<Args>(args)...);
+  }
 
   void pop_front() { erase(begin()); }
 
@@ -317,7 +336,7 @@ class list {
       if (next_element->data == current->data) {
         current->next = next_element->next;
         next_element->next->prev = current;
-        delete next_element;
+        destroy_node(next_element);
         --size_;
       } else {
         current = current->next;
@@ -328,38 +347,42 @@ class list {
   void sort() {
     if (size_ < 2) return;
 
-    merge_sort(head_);
+    /* Only element nodes are sorted, the sentinels are relinked after */
+    Node *first{merge_sort(head_->next)};
+    head_->next = first;
+    first->prev = head_;
+    Node *last{first};
+    while (last->next != tail_) {
+      last = last->next;
+    }
+    tail_->prev = last;
   }
 
+  /* Every argument is forwarded into its own node, in order before
+   * position. Returns the first inserted element or position */
   template <typename... Args>
   iterator insert_many(iterator position, Args &&...arguments) {
-    std::initializer_list<value_type> items{arguments...};
-
-    iterator current_position{position};
-    iterator first_inserted_position{position};
-    for (const auto &item : items) {
-      current_position = insert(current_position, item);
-
-      if (first_inserted_position == position)
-        first_inserted_position = current_position;
-
-      ++current_position;
-    }
-
-    return first_inserted_position;
+    Node *before_first{position.base()->prev};
+    (emplace(position, std::forward<Args>(arguments)), ...);
+    return iterator{before_first->next};
   }
 
   template <typename... Args>
   void insert_many_back(Args &&...arguments) {
-    insert_many(end(), arguments...);
+    insert_many(end(), std::forward<Args>(arguments)...);
   }
 
   template <typename... Args>
   void insert_many_front(Args &&...arguments) {
-    insert_many(begin(), arguments...);
+    insert_many(begin(), std::forward<Args>(arguments)...);
   }
 
  private:
+  void destroy_node(Node *node) noexcept {
+    std::destroy_at(std::addressof(node->data));
+    delete node;
+  }
+
   void link_head_and_tail() {
     head_->next = tail_;
     tail_->prev = head_;
@@ -422,14 +445,22 @@ class list {
   }
 
  private:
+  /* data is only alive in element nodes, the head and tail sentinels
+   * never construct a value_type. destroy_node ends its lifetime */
   struct Node {
     Node *next{nullptr};
     Node *prev{nullptr};
-    value_type data{};
+    union {
+      value_type data;
+    };
+
+    Node() {}
 
-    Node() = default;
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args &&...args)
+        : data(std::forward<Args>(args)...) {}
 
-    explicit Node(const value_type &value) : data{value} {}
+    ~Node() {}
   };
 
   Node *head_{};
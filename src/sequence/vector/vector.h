@@ -3,8 +3,14 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <initializer_list>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace s21 {
 template <typename T>
@@ -119,23 +125,37 @@ class vector {
   vector() = default;
 
   explicit vector(size_type size)
-      : data_{new T[size]{}}, capacity_{size}, size_{size} {}
+      : data_{allocate(size)}, capacity_{size}, size_{size} {
+    try {
+      std::uninitialized_value_construct_n(data_, size);
+    } catch (...) {
+      deallocate(data_, capacity_);
+      throw;
+    }
+  }
 
   vector(const std::initializer_list<T> &items)
-      : data_{new T[items.size()]{}},
+      : data_{allocate(items.size())},
         capacity_{items.size()},
         size_{items.size()} {
-    size_type index{0};
-    for (const auto &item : items) {
-      data_[index++] = item;
+    try {
+      std::uninitialized_copy(items.begin(), items.end(), data_);
+    } catch (...) {
+      deallocate(data_, capacity_);
+      throw;
     }
   }
 
   vector(const vector &other)
-      : data_{new T[other.capacity()]{}},
+      : data_{allocate(other.capacity())},
         capacity_{other.capacity()},
         size_{other.size()} {
-    std::copy_n(other.begin(), size_, begin());
+    try {
+      std::uninitialized_copy_n(other.data_, size_, data_);
+    } catch (...) {
+      deallocate(data_, capacity_);
+      throw;
+    }
   }
 
   vector(vector &&other) noexcept
@@ -146,19 +166,15 @@ class vector {
   }
 
   ~vector() {
-    delete[] data_;
+    clear();
+    deallocate(data_, capacity_);
     data_ = nullptr;
   }
 
   vector &operator=(const vector &other) {
     if (this != &other) {
-      delete[] data_;
-
-      size_ = other.size_;
-      capacity_ = other.capacity_;
-      data_ = new T[capacity_]{};
-
-      std::copy_n(other.begin(), size_, begin());
+      vector copy{other};
+      swap(copy);
     }
 
     return *this;
@@ -166,7 +182,8 @@ class vector {
 
   vector &operator=(vector &&other) noexcept {
     if (this != &other) {
-      delete[] data_;
+      clear();
+      deallocate(data_, capacity_);
 
       data_ = other.data_;
       size_ = other.size_;
@@ -206,28 +223,30 @@ class vector {
 
   [[nodiscard]] const_reference back() const { return *(end() - 1); }
 
-  [[nodiscard]] iterator begin() noexcept { return iterator{&data_[0]}; }
+  [[nodiscard]] iterator begin() noexcept { return iterator{data_}; }
 
-  [[nodiscard]] iterator end() noexcept { return iterator{&data_[size()]}; }
+  [[nodiscard]] iterator end() noexcept { return iterator{data_ + size_}; }
 
   [[nodiscard]] const_iterator begin() const noexcept {
-    return const_iterator{&data_[0]};
+    return const_iterator{data_};
   }
 
   [[nodiscard]] const_iterator end() const noexcept {
-    return const_iterator{&data_[size()]};
+    return const_iterator{data_ + size_};
   }
 
   [[nodiscard]] const_iterator cbegin() const noexcept {
-    return const_iterator{&data_[0]};
+    return const_iterator{data_};
   }
 
   [[nodiscard]] const_iterator cend() const noexcept {
-    return const_iterator{&data_[size()]};
+    return const_iterator{data_ + size_};
   }
 
   [[nodiscard]] T *data() noexcept { return data_; }
 
+  [[nodiscard]] const T *data() const noexcept { return data_; }
+
   [[nodiscard]] bool empty() const noexcept { return (begin() == end()); }
 
   [[nodiscard]] size_type size() const noexcept { return size_; }
@@ -257,90 +276,159 @@ class vector {
     reallocate(size_);
   }
 
+  /* Destroys the elements, the storage is kept for reuse */
   void clear() noexcept {
-    delete[] data_;
-    data_ = nullptr;
+    std::destroy_n(data_, size_);
     size_ = 0;
   }
 
   iterator insert(iterator position, const_reference value) {
-    auto distance{position - begin()};
-    if (size_ == capacity_) {
-      reserve(capacity_ * 2);
-      position = begin() + distance;
-    }
-
-    size_type index_to_insert{static_cast<size_type>(position - begin())};
-    T previous_element{data_[index_to_insert]};
-    for (size_type i{index_to_insert + 1}; i <= size(); ++i) {
-      std::swap(data_[i], previous_element);
-    }
-
-    data_[index_to_insert] = value;
+    return emplace(position, value);
+  }
 
-    ++size_;
+  iterator insert(iterator position, value_type &&value) {
+    return emplace(position, std::move(value));
+  }
 
-    return position;
+  /* Builds the element in place from args, which may refer to elements of
+   * this vector */
+  template <typename... Args>
+  iterator emplace(const_iterator position, Args &&...args) {
+    size_type index{static_cast<size_type>(position - cbegin())};
+    insert_constructed(index, 1, [&](T *destination) {
+      ::new (static_cast<void *>(destination)) T(std::forward<Args>(args)...);
+    });
+    return begin() + static_cast<std::ptrdiff_t>(index);
   }
 
   void erase(iterator position) {
     if (empty()) return;
 
-    size_type index_to_erase{static_cast<size_type>(position - begin())};
-
-    data_[index_to_erase].~T();
-
-    for (size_type i{index_to_erase + 1}; i < size(); ++i) {
-      data_[i - 1] = data_[i];
-    }
+    T *erased{data_ + (position - begin())};
+    std::move(erased + 1, data_ + size_, erased);
+    std::destroy_at(data_ + size_ - 1);
 
     --size_;
   }
 
-  void push_back(const_reference value) { insert(end(), value); }
+  void push_back(const_reference value) { emplace_back(value); }
+
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    return *emplace(cend(), std::forward<Args>(args)...);
+  }
 
   void pop_back() { erase(end() - 1); }
 
-  void swap(vector &other) {
+  void swap(vector &other) noexcept {
     std::swap(size_, other.size_);
     std::swap(capacity_, other.capacity_);
     std::swap(data_, other.data_);
   }
 
+  /* Every argument is forwarded into its own element, built in place */
   template <typename... Args>
   iterator insert_many(const_iterator position, Args &&...arguments) {
-    auto distance{position - cbegin()};
-    size_type number_of_arguments{sizeof...(arguments)};
-
-    if (size_ + number_of_arguments > capacity_) {
-      reserve(size_ + number_of_arguments);
-      position = cbegin() + distance;
-    }
+    size_type index{static_cast<size_type>(position - cbegin())};
+    insert_constructed(index, sizeof...(Args), [&](T *destination) {
+      size_type constructed{0};
+      try {
+        ((::new (static_cast<void *>(destination + constructed))
+              T(std::forward<Args>(arguments)),
+          ++constructed),
+         ...);
+      } catch (...) {
+        std::destroy_n(destination, constructed);
+        throw;
+      }
+    });
+    return begin() + static_cast<std::ptrdiff_t>(index);
+  }
 
-    size_type index_to_insert{static_cast<size_type>(position - cbegin())};
-    for (size_type i{size()}; i > index_to_insert; --i) {
-      data_[i + number_of_arguments - 1] = data_[i - 1];
-    }
+  template <typename... Args>
+  void insert_many_back(Args &&...arguments) {
+    insert_many(cend(), std::forward<Args>(arguments)...);
+  }
 
-    ((data_[index_to_insert++] = std::forward<Args>(arguments)), ...);
+ private:
+  static T *allocate(size_type capacity) {
+    return capacity == 0 ? nullptr : std::allocator<T>{}.allocate(capacity);
+  }
 
-    size_ += number_of_arguments;
+  static void deallocate(T *data, size_type capacity) noexcept {
+    if (data != nullptr) {
+      std::allocator<T>{}.deallocate(data, capacity);
+    }
+  }
 
-    return begin() + distance;
+  /* Moves the elements into fresh storage, copies them when the move
+   * constructor may throw so a failure leaves the vector untouched */
+  static void relocate(T *first, size_type count, T *destination) {
+    if constexpr (std::is_nothrow_move_constructible_v<T> ||
+                  !std::is_copy_constructible_v<T>) {
+      std::uninitialized_move_n(first, count, destination);
+    } else {
+      std::uninitialized_copy_n(first, count, destination);
+    }
   }
 
-  template <typename... Args>
-  void insert_many_back(Args &&...arguments) {
-    insert_many(cend(), arguments...);
+  void reallocate(size_type new_capacity) {
+    T *new_data{allocate(new_capacity)};
+    try {
+      relocate(data_, size_, new_data);
+    } catch (...) {
+      deallocate(new_data, new_capacity);
+      throw;
+    }
+    std::destroy_n(data_, size_);
+    deallocate(data_, capacity_);
+    capacity_ = new_capacity;
+    data_ = new_data;
   }
 
- private:
-  void reallocate(size_type new_size) {
-    T *new_data{new T[new_size]{}};
-    std::copy_n(begin(), size_, new_data);
-    delete[] data_;
-    capacity_ = new_size;
+  /* Opens a gap of count elements at index and lets construct fill it. The
+   * new elements are built before anything is moved, so arguments that
+   * alias elements of this vector stay valid. Capacity grows geometrically
+   * to keep repeated appends amortized O(1) */
+  template <typename Construct>
+  void insert_constructed(size_type index, size_type count,
+                          Construct construct) {
+    if (count == 0) return;
+    if (size_ + count <= capacity_) {
+      construct(data_ + size_);
+      std::rotate(data_ + index, data_ + size_, data_ + size_ + count);
+      size_ += count;
+      return;
+    }
+
+    if (size_ + count > max_size())
+      throw std::length_error{
+          "s21::vector<T>::insert: size exceeded max_size of vector"};
+    size_type new_capacity{std::max(size_ + count, capacity_ * 2)};
+    T *new_data{allocate(new_capacity)};
+    size_type relocated{0};
+    try {
+      construct(new_data + index);
+      try {
+        relocate(data_, index, new_data);
+        relocated = index;
+        relocate(data_ + index, size_ - index, new_data + index + count);
+      } catch (...) {
+        std::destroy_n(new_data, relocated);
+        std::destroy_n(new_data + index, count);
+        throw;
+      }
+    } catch (...) {
+      deallocate(new_data, new_capacity);
+      throw;
+    }
+    std::destroy_n(data_, size_);
+    deallocate(data_, capacity_);
     data_ = new_data;
+    capacity_ = new_capacity;
+    size_ += count;
   }
 
  private:
@@ -0,0 +1,402 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "../src/associative/map/map.h"
+#include "../src/associative/multiset/multiset.h"
+#include "../src/associative/set/set.h"
+#include "test_utils.h"
+
+namespace s21 {
+class BTreeTest : public ::testing::Test {
+ protected:
+  /* Small nodes so a few thousand elements already make several levels */
+  using SmallTree = BTree<int, IdentityKey<int>, std::less<>, 64>;
+  using BTreeSet = s21::set<int, std::less<int>, BTreeNodes<64>>;
+  using BTreeMultiset = s21::multiset<int, std::less<int>, BTreeNodes<64>>;
+  using BTreeMap = s21::map<int, std::string, std::less<int>, BTreeNodes<64>>;
+
+  std::mt19937 generator_{2024};
+
+  static std::vector<int> Contents(const SmallTree &tree) {
+    return {tree.begin(), tree.end()};
+  }
+
+  template <typename Key>
+  void ExpectCountsMatchScalar(std::vector<Key> keys) {
+    std::sort(keys.begin(), keys.end());
+    for (std::size_t count{0}; count <= keys.size(); ++count) {
+      for (Key key : keys) {
+        std::size_t below{0};
+        std::size_t not_above{0};
+        for (std::size_t i{0}; i < count; ++i) {
+          below += keys[i] < key ? 1 : 0;
+          not_above += key < keys[i] ? 0 : 1;
+        }
+        ASSERT_EQ(CountKeysBelow<false>(keys.data(), count, key), below);
+        ASSERT_EQ(CountKeysBelow<true>(keys.data(), count, key), not_above);
+      }
+    }
+  }
+};
+
+TEST_F(BTreeTest, ChurnMatchesStdMultisetTest) {
+  std::uniform_int_distribution<int> distribution{0, 999};
+  std::multiset<int> stdMultiset{};
+  SmallTree tree{};
+  for (int i{0}; i < 20000; ++i) {
+    int value{distribution(generator_)};
+    if (i % 3 == 2) {
+      auto found{stdMultiset.find(value)};
+      if (found != stdMultiset.end()) {
+        stdMultiset.erase(found);
+      }
+      tree.Remove(value);
+    } else {
+      stdMultiset.insert(value);
+      tree.Insert(value);
+    }
+    if (i % 500 == 0) {
+      ASSERT_TRUE(tree.IsValid());
+    }
+  }
+  ASSERT_TRUE(tree.IsValid());
+  ASSERT_GT(tree.GetHeight(), 2U);
+  ASSERT_EQ(Contents(tree),
+            std::vector<int>(stdMultiset.begin(), stdMultiset.end()));
+  while (!tree.IsEmpty()) {
+    tree.Remove(*SmallTree::const_iterator(tree.Select(tree.GetSize() / 2)));
+  }
+  ASSERT_TRUE(tree.IsValid());
+  ASSERT_EQ(tree.begin(), tree.end());
+}
+
+TEST_F(BTreeTest, OrderStatisticsTest) {
+  SmallTree tree{};
+  for (int i{0}; i < 3000; ++i) {
+    tree.Insert((i * 7919) % 3000 / 2);
+  }
+  ASSERT_TRUE(tree.IsValid());
+  for (std::size_t k{0}; k < tree.GetSize(); k += 7) {
+    auto position{tree.Select(k)};
+    ASSERT_EQ(*SmallTree::const_iterator(position), static_cast<int>(k / 2));
+    ASSERT_EQ(tree.GetNodeRank(position), k);
+    ASSERT_EQ(tree.GetRank(static_cast<int>(k / 2)), k / 2 * 2);
+    ASSERT_EQ(tree.GetUpperRank(static_cast<int>(k / 2)), k / 2 * 2 + 2);
+  }
+  ASSERT_EQ(tree.Select(tree.GetSize()), tree.GetNil());
+  ASSERT_EQ(tree.Advance(tree.Select(10), 100), tree.Select(110));
+  ASSERT_EQ(tree.Advance(tree.Select(10), -100), tree.Select(0));
+  ASSERT_EQ(tree.CountRange(100, 200), 200U);
+  ASSERT_EQ(tree.CountKey(1499), 2U);
+}
+
+TEST_F(BTreeTest, BulkBuildTest) {
+  std::vector<int> values(1001);
+  for (std::size_t i{0}; i < values.size(); ++i) {
+    values[i] = static_cast<int>(i / 3);
+  }
+  SmallTree tree{};
+  tree.AssignSorted(values.begin(), values.end(), true);
+  ASSERT_TRUE(tree.IsValid());
+  ASSERT_EQ(tree.GetSize(), 334U);
+  tree.Assign(values.rbegin(), values.rend(), false);
+  ASSERT_TRUE(tree.IsValid());
+  ASSERT_EQ(Contents(tree), values);
+  SmallTree copy{tree};
+  ASSERT_TRUE(copy.IsValid());
+  ASSERT_EQ(Contents(copy), values);
+}
+
+TEST_F(BTreeTest, CountKeysBelowMatchesScalarTest) {
+  ExpectCountsMatchScalar<int>({-5, 3, 3, 9, -100, 42, 0, 7, 7, 7, 1});
+  ExpectCountsMatchScalar<unsigned>({0U, 1U, 4000000000U, 2147483648U, 5U});
+  ExpectCountsMatchScalar<float>({-1.5F, 0.0F, 2.25F, 2.25F, 1e9F, -3e8F});
+  ExpectCountsMatchScalar<double>({-1.5, 0.0, 2.25, 1e300, -1e300, 7.0});
+  ExpectCountsMatchScalar<long>({-5L, 3L, 1L << 40, -(1L << 50), 0L, 3L});
+  ExpectCountsMatchScalar<std::uint64_t>({0U, ~0ULL, 1ULL << 63, 17U, 17U});
+  ExpectCountsMatchScalar<short>({-5, 3, 300, -300, 0});
+}
+
+TEST_F(BTreeTest, SetAndMultisetMatchStdTest) {
+  std::uniform_int_distribution<int> distribution{0, 4999};
+  std::set<int> stdSet{};
+  std::multiset<int> stdMultiset{};
+  BTreeSet mySet{};
+  BTreeMultiset myMultiset{};
+  for (int i{0}; i < 10000; ++i) {
+    int value{distribution(generator_)};
+    ASSERT_EQ(mySet.insert(value).second, stdSet.insert(value).second);
+    stdMultiset.insert(value);
+    myMultiset.insert(value);
+  }
+  for (int i{0}; i < 5000; i += 2) {
+    stdSet.erase(i);
+    mySet.erase(i);
+    ASSERT_EQ(myMultiset.count(i), stdMultiset.count(i));
+  }
+  AssertContainerEquality(stdSet, mySet);
+  AssertContainerEquality(stdMultiset, myMultiset);
+  ASSERT_EQ(mySet.front(), *stdSet.begin());
+  ASSERT_EQ(mySet.back(), *stdSet.rbegin());
+  ASSERT_EQ(*mySet.lower_bound(2500), *stdSet.lower_bound(2500));
+  ASSERT_EQ(*myMultiset.upper_bound(2500), *stdMultiset.upper_bound(2500));
+}
+
+TEST_F(BTreeTest, MapMatchesStdTest) {
+  std::map<int, std::string> stdMap{};
+  BTreeMap myMap{};
+  for (int i{0}; i < 2000; ++i) {
+    int key{(i * 7919) % 2000};
+    std::string value(static_cast<std::size_t>(i % 40), 'x');
+    stdMap[key] = value;
+    myMap[key] = value;
+  }
+  for (int i{0}; i < 2000; i += 3) {
+    stdMap.erase(i);
+    myMap.erase(i);
+  }
+  ASSERT_FALSE(myMap.try_emplace(1, "y").second);
+  ASSERT_TRUE(myMap.try_emplace(3, "y").second);
+  stdMap.try_emplace(3, "y");
+  AssertContainerEquality(stdMap, myMap);
+  myMap.at(4) = "z";
+  ASSERT_EQ(myMap.find(4)->second, "z");
+  ASSERT_EQ(myMap.front().first, 1);
+  ASSERT_EQ(myMap.back().first, 1999);
+}
+
+template <typename Container, typename = void>
+struct HasNodeHandles : std::false_type {};
+
+template <typename Container>
+struct HasNodeHandles<
+    Container,
+    std::void_t<decltype(std::declval<Container &>().extract(
+                    std::declval<Container &>().begin())),
+                decltype(std::declval<Container &>().insert(
+                    std::declval<typename Container::node_type &&>()))>>
+    : std::true_type {};
+
+TEST_F(BTreeTest, NodeHandlesTest) {
+  /* Leaves hold the elements, there are no nodes to extract */
+  static_assert(!HasNodeHandles<BTreeSet>::value);
+  static_assert(!HasNodeHandles<BTreeMultiset>::value);
+  static_assert(!HasNodeHandles<BTreeMap>::value);
+  static_assert(HasNodeHandles<s21::set<int>>::value);
+  static_assert(HasNodeHandles<s21::multiset<int>>::value);
+  static_assert(HasNodeHandles<s21::map<int, std::string>>::value);
+}
+
+TEST_F(BTreeTest, MergeTest) {
+  std::set<int> stdSet{};
+  std::set<int> stdOther{};
+  BTreeSet mySet{};
+  BTreeSet myOther{};
+  for (int i{0}; i < 3000; ++i) {
+    if (i % 2 == 0) {
+      stdSet.insert(i);
+      mySet.insert(i);
+    }
+    if (i % 3 == 0) {
+      stdOther.insert(i);
+      myOther.insert(i);
+    }
+  }
+  stdSet.merge(stdOther);
+  mySet.merge(myOther);
+  AssertContainerEquality(stdSet, mySet);
+  AssertContainerEquality(stdOther, myOther);
+  BTreeMultiset myMultiset{1, 1, 2};
+  myMultiset.merge(mySet);
+  ASSERT_TRUE(mySet.empty());
+  ASSERT_EQ(myMultiset.size(), stdSet.size() + 3);
+  ASSERT_EQ(myMultiset.count(2), 2U);
+}
+
+TEST_F(BTreeTest, SetAlgebraTest) {
+  std::vector<int> first{};
+  std::vector<int> second{};
+  for (int i{0}; i < 2000; ++i) {
+    first.push_back(i / 2 * 3);
+    second.push_back(i / 3 * 2);
+  }
+  auto check = [&](auto operation, auto std_operation) {
+    BTreeMultiset mine(first.begin(), first.end());
+    operation(mine, BTreeMultiset(second.begin(), second.end()));
+    std::vector<int> expected{};
+    std_operation(first.begin(), first.end(), second.begin(), second.end(),
+                  std::back_inserter(expected));
+    AssertContainerEquality(expected, mine);
+  };
+  using It = std::vector<int>::iterator;
+  using Out = std::back_insert_iterator<std::vector<int>>;
+  check([](auto &a, auto b) { a.set_union(b); }, std::set_union<It, It, Out>);
+  check([](auto &a, auto b) { a.set_intersection(b); },
+        std::set_intersection<It, It, Out>);
+  check([](auto &a, auto b) { a.set_difference(b); },
+        std::set_difference<It, It, Out>);
+  check([](auto &a, auto b) { a.symmetric_difference(b); },
+        std::set_symmetric_difference<It, It, Out>);
+  BTreeSet mySet{1, 2, 3, 4, 5, 6, 7, 8, 9};
+  mySet.set_difference(BTreeSet{2, 4});
+  AssertContainerEquality(std::set<int>{1, 3, 5, 6, 7, 8, 9}, mySet);
+}
+
+TEST_F(BTreeTest, ScansTest) {
+  BTreeMap myMap{};
+  for (int i{0}; i < 1000; ++i) {
+    myMap.insert(i, std::to_string(i));
+  }
+  int expected{100};
+  myMap.for_each_range(100, 700, [&expected](auto &item) {
+    ASSERT_EQ(item.first, expected++);
+  });
+  ASSERT_EQ(expected, 700);
+  std::size_t visited{0};
+  for (auto &[key, value] : myMap.scan(350, 360)) {
+    ASSERT_EQ(value, std::to_string(key));
+    ++visited;
+  }
+  ASSERT_EQ(visited, 10U);
+  ASSERT_EQ(myMap.count_range(10, 20), 10U);
+}
+
+TEST_F(BTreeTest, HintedAppendsFillLeavesTest) {
+  SmallTree tree{};
+  for (int i{0}; i < 5000; ++i) {
+    tree.InsertHint(tree.GetNil(), i, true);
+  }
+  ASSERT_TRUE(tree.IsValid());
+  SmallTree appended{};
+  for (int i{0}; i < 5000; ++i) {
+    appended.Insert(i);
+  }
+  ASSERT_LE(appended.GetHeight(), tree.GetHeight());
+  BTreeSet mySet{};
+  auto hint{mySet.end()};
+  for (int i{999}; i >= 0; --i) {
+    hint = mySet.insert(hint, i);
+  }
+  ASSERT_EQ(mySet.size(), 1000U);
+  ASSERT_EQ(*mySet.insert(mySet.find(500), 500), 500);
+  ASSERT_EQ(mySet.size(), 1000U);
+}
+
+TEST_F(BTreeTest, CopyAndMoveTest) {
+  BTreeMap myMap{};
+  for (int i{0}; i < 500; ++i) {
+    myMap.insert(i, std::string(40, 'a'));
+  }
+  BTreeMap copy{myMap};
+  BTreeMap moved{std::move(myMap)};
+  ASSERT_TRUE(myMap.empty());
+  AssertContainerEquality(copy, moved);
+  myMap = moved;
+  moved.clear();
+  ASSERT_EQ(myMap.size(), 500U);
+  ASSERT_EQ(std::prev(myMap.end())->first, 499);
+}
+
+TEST_F(BTreeTest, TransparentStringKeysTest) {
+  /* pair<const std::string, int> copies its key on a move, which may throw,
+   * so the keys are views into strings that outlive the map */
+  std::vector<std::string> names{};
+  for (int i{0}; i < 300; ++i) {
+    names.push_back(std::to_string(i));
+  }
+  s21::map<std::string_view, int, std::less<>, BTreeNodes<>> myMap{};
+  for (int i{0}; i < 300; ++i) {
+    myMap[names[static_cast<std::size_t>(i)]] = i;
+  }
+  ASSERT_EQ(myMap.find("42")->second, 42);
+  ASSERT_TRUE(myMap.contains(std::string{"299"}));
+  ASSERT_FALSE(myMap.contains("300"));
+}
+
+TEST_F(BTreeTest, EraseRangeTest) {
+  std::uniform_int_distribution<int> distribution{0, 999};
+  BTreeMultiset myMultiset{};
+  std::multiset<int> stdMultiset{};
+  for (int i{0}; i < 3000; ++i) {
+    int key = distribution(generator_);
+    myMultiset.insert(key);
+    stdMultiset.insert(key);
+  }
+  for (int low : {10, 500, 990, 0}) {
+    int high = low + (low == 0 ? 1000 : low / 10 + 1);
+    auto first = stdMultiset.lower_bound(low);
+    auto last = stdMultiset.lower_bound(high);
+    auto expected = static_cast<std::size_t>(std::distance(first, last));
+    stdMultiset.erase(first, last);
+    ASSERT_EQ(myMultiset.erase_range(low, high), expected);
+    AssertContainerEquality(myMultiset, stdMultiset);
+  }
+  BTreeMap myMap{};
+  for (int key{0}; key < 500; ++key) {
+    myMap.insert(key, std::to_string(key));
+  }
+  auto next = myMap.erase(myMap.find(3), myMap.find(7));
+  ASSERT_EQ(next->first, 7);
+  next = myMap.erase(myMap.find(100), myMap.find(400));
+  ASSERT_EQ(next->first, 400);
+  ASSERT_EQ(myMap.size(), 196U);
+  int keys{0};
+  for (const auto &item : myMap.range(0, 10)) {
+    keys += item.first;
+  }
+  ASSERT_EQ(keys, 0 + 1 + 2 + 7 + 8 + 9);
+}
+
+TEST_F(BTreeTest, EraseRangeRepairsBothPathsTest) {
+  std::uniform_int_distribution<int> distribution{0, 4999};
+  SmallTree tree{};
+  std::vector<int> expected{};
+  for (int i{0}; i < 6000; ++i) {
+    int value{distribution(generator_)};
+    tree.Insert(value);
+    expected.insert(std::upper_bound(expected.begin(), expected.end(), value),
+                    value);
+  }
+  while (expected.size() > 1) {
+    std::uniform_int_distribution<std::size_t> offsets{0, expected.size()};
+    std::size_t first{offsets(generator_)};
+    std::size_t last{offsets(generator_)};
+    if (first > last) {
+      std::swap(first, last);
+    }
+    if (expected.size() % 5 == 0) {
+      last = expected.size();
+    }
+    auto next{tree.EraseRange(tree.Select(first), tree.Select(last))};
+    expected.erase(expected.begin() + static_cast<std::ptrdiff_t>(first),
+                   expected.begin() + static_cast<std::ptrdiff_t>(last));
+    ASSERT_TRUE(tree.IsValid());
+    ASSERT_EQ(next, tree.Select(first));
+    ASSERT_EQ(Contents(tree), expected);
+  }
+  BTreeMap myMap{};
+  std::map<int, std::string> stdMap{};
+  for (int key{0}; key < 3000; ++key) {
+    myMap.insert(key, std::string(static_cast<std::size_t>(key % 30), 'x'));
+    stdMap.emplace(key, std::string(static_cast<std::size_t>(key % 30), 'x'));
+  }
+  for (int low : {1, 2500, 700, 0}) {
+    int high{low + 400};
+    stdMap.erase(stdMap.lower_bound(low), stdMap.lower_bound(high));
+    myMap.erase(myMap.lower_bound(low), myMap.lower_bound(high));
+    AssertContainerEquality(myMap, stdMap);
+  }
+}
+
+}  // namespace s21
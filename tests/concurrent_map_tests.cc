@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/associative/concurrent_map/concurrent_map.h"
+
+namespace s21 {
+class ConcurrentMapTest : public ::testing::Test {
+ protected:
+  template <typename ConcurrentMap, typename StdMap>
+  static void AssertSameElements(const ConcurrentMap &concurrent,
+                                 const StdMap &expected) {
+    auto snapshot = concurrent.snapshot();
+    ASSERT_EQ(snapshot.size(), expected.size());
+    ASSERT_EQ(concurrent.size(), expected.size());
+    auto expected_item = expected.begin();
+    for (const auto &item : snapshot) {
+      ASSERT_EQ(item.first, expected_item->first);
+      ASSERT_EQ(item.second, expected_item->second);
+      ++expected_item;
+    }
+  }
+
+  std::mt19937 generator_{2024};
+};
+
+TEST_F(ConcurrentMapTest, MatchesStdMapTest) {
+  std::uniform_int_distribution<int> distribution{0, 999};
+  std::map<int, int> stdMap{};
+  s21::concurrent_map<int, int> myMap{7};
+  for (int i{0}; i < 5000; ++i) {
+    int key = distribution(generator_);
+    switch (i % 3) {
+      case 0:
+        ASSERT_EQ(myMap.insert(key, i), stdMap.try_emplace(key, i).second);
+        break;
+      case 1:
+        ASSERT_EQ(myMap.insert_or_assign(key, i),
+                  stdMap.insert_or_assign(key, i).second);
+        break;
+      default:
+        ASSERT_EQ(myMap.erase(key), stdMap.erase(key) == 1);
+    }
+  }
+  AssertSameElements(myMap, stdMap);
+  for (int key{0}; key < 1000; ++key) {
+    auto found = myMap.find(key);
+    ASSERT_EQ(found.has_value(), stdMap.count(key) == 1);
+    if (found) {
+      ASSERT_EQ(*found, stdMap[key]);
+    }
+  }
+}
+
+TEST_F(ConcurrentMapTest, BatchOperationsTest) {
+  s21::concurrent_map<int, std::string> myMap{{1, "one"}, {2, "two"}};
+  std::vector<std::pair<int, std::string>> items{
+      {2, "zwei"}, {3, "three"}, {4, "four"}, {3, "drei"}};
+  ASSERT_EQ(myMap.insert_batch(items.begin(), items.end()), 2u);
+  std::vector<int> keys{4, 0, 2, 3};
+  auto found = myMap.find_batch(keys.begin(), keys.end());
+  ASSERT_EQ(found.size(), 4u);
+  ASSERT_EQ(found[0], "four");
+  ASSERT_FALSE(found[1].has_value());
+  ASSERT_EQ(found[2], "two");
+  ASSERT_EQ(found[3], "three");
+  ASSERT_EQ(myMap.erase_batch(keys.begin(), keys.end()), 3u);
+  AssertSameElements(myMap, std::map<int, std::string>{{1, "one"}});
+}
+
+TEST_F(ConcurrentMapTest, OrderedSnapshotsTest) {
+  s21::concurrent_map<int, int, std::greater<int>> myMap{5};
+  std::map<int, int, std::greater<int>> stdMap{};
+  for (int key{0}; key < 300; ++key) {
+    myMap.insert(key * 7 % 300, key);
+    stdMap.emplace(key * 7 % 300, key);
+  }
+  AssertSameElements(myMap, stdMap);
+  std::vector<int> visited{};
+  myMap.for_each_range(200, 100, [&visited](const auto &item) {
+    visited.push_back(item.first);
+  });
+  ASSERT_EQ(visited.size(), 100u);
+  ASSERT_EQ(visited.front(), 200);
+  ASSERT_EQ(visited.back(), 101);
+  ASSERT_TRUE(myMap.update(5, [](int &value) { value = -1; }));
+  ASSERT_FALSE(myMap.update(300, [](int &value) { value = -1; }));
+  ASSERT_EQ(myMap.find(5), -1);
+}
+
+TEST_F(ConcurrentMapTest, ParallelWritersTest) {
+  constexpr int kThreads = 4;
+  constexpr int kKeysPerThread = 2000;
+  s21::concurrent_map<int, int> myMap{};
+  std::vector<std::thread> threads{};
+  for (int thread{0}; thread < kThreads; ++thread) {
+    threads.emplace_back([&myMap, thread] {
+      for (int i{0}; i < kKeysPerThread; ++i) {
+        int key = i * kThreads + thread;
+        myMap.insert(key, key);
+        myMap.update(key, [](int &value) { value *= 2; });
+        if (i % 2 == 1) {
+          myMap.erase(key);
+        }
+        (void)myMap.snapshot(key - 8, key);
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  std::map<int, int> stdMap{};
+  for (int key{0}; key < kThreads * kKeysPerThread; ++key) {
+    if (key / kThreads % 2 == 0) {
+      stdMap.emplace(key, key * 2);
+    }
+  }
+  AssertSameElements(myMap, stdMap);
+}
+}  // namespace s21
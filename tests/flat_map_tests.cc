@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/associative/flat_map/flat_map.h"
+
+namespace s21 {
+class FlatMapTest : public ::testing::Test {
+ protected:
+  std::mt19937 generator_{2024};
+
+  /* Elements are pairs of references, compared member by member */
+  template <typename StdMap, typename FlatMap>
+  static void AssertSameElements(const StdMap &stdMap, const FlatMap &myMap) {
+    ASSERT_EQ(stdMap.size(), myMap.size());
+    auto position = myMap.begin();
+    for (const auto &[key, value] : stdMap) {
+      ASSERT_EQ(position->first, key);
+      ASSERT_EQ(position->second, value);
+      ++position;
+    }
+  }
+};
+
+TEST_F(FlatMapTest, ListConstructorTest) {
+  std::map<int, std::string> stdMap{{3, "c"}, {1, "a"}, {2, "b"}, {1, "x"}};
+  s21::flat_map<int, std::string> myMap{
+      {3, "c"}, {1, "a"}, {2, "b"}, {1, "x"}};
+  AssertSameElements(stdMap, myMap);
+  ASSERT_EQ(myMap.front().second, "a");
+  ASSERT_EQ(myMap.back().first, 3);
+}
+
+TEST_F(FlatMapTest, InsertAndEraseMatchStdTest) {
+  std::uniform_int_distribution<int> distribution{0, 499};
+  std::map<int, std::string> stdMap{};
+  s21::flat_map<int, std::string> myMap{};
+  for (int i{0}; i < 3000; ++i) {
+    int key{distribution(generator_)};
+    if (i % 3 == 2) {
+      stdMap.erase(key);
+      myMap.erase(key);
+    } else {
+      std::string value(static_cast<std::size_t>(i % 30), 'v');
+      ASSERT_EQ(myMap.insert(key, value).second,
+                stdMap.insert({key, value}).second);
+    }
+  }
+  AssertSameElements(stdMap, myMap);
+  ASSERT_EQ(myMap.keys().size(), myMap.values().size());
+}
+
+TEST_F(FlatMapTest, ElementAccessTest) {
+  s21::flat_map<std::string, int> myMap{};
+  myMap["b"] = 2;
+  myMap["a"] = 1;
+  ++myMap["b"];
+  ASSERT_EQ(myMap.at("b"), 3);
+  ASSERT_THROW(myMap.at("c"), std::out_of_range);
+  ASSERT_FALSE(myMap.try_emplace("a", 10).second);
+  ASSERT_FALSE(myMap.insert_or_assign("a", 10).second);
+  ASSERT_EQ(myMap.find("a")->second, 10);
+  ASSERT_TRUE(myMap.emplace("c", 5).second);
+  const auto &constMap = myMap;
+  ASSERT_EQ(constMap.at("c"), 5);
+  ASSERT_EQ((*constMap.find("c")).second, 5);
+}
+
+TEST_F(FlatMapTest, InsertRangeMergesTest) {
+  std::uniform_int_distribution<int> distribution{0, 9999};
+  std::map<int, int> stdMap{};
+  s21::flat_map<int, int> myMap{};
+  for (int round{0}; round < 5; ++round) {
+    std::vector<std::pair<int, int>> batch{};
+    for (int i{0}; i < 1000; ++i) {
+      batch.emplace_back(distribution(generator_), round * 1000 + i);
+    }
+    stdMap.insert(batch.begin(), batch.end());
+    myMap.insert_range(batch.begin(), batch.end());
+    AssertSameElements(stdMap, myMap);
+  }
+}
+
+TEST_F(FlatMapTest, IteratorsTest) {
+  s21::flat_map<int, int> myMap{};
+  for (int i{0}; i < 100; ++i) {
+    myMap[i] = i;
+  }
+  for (auto item : myMap) {
+    item.second *= 2;
+  }
+  ASSERT_EQ(myMap.at(10), 20);
+  auto position = myMap.lower_bound(50);
+  ASSERT_EQ(position - myMap.begin(), 50);
+  ASSERT_EQ((position + 5)->first, 55);
+  ASSERT_EQ(position[-1].second, 98);
+  s21::flat_map<int, int>::const_iterator constPosition = position;
+  ASSERT_EQ(constPosition, position);
+  ASSERT_LT(myMap.begin(), constPosition);
+  myMap.erase(position);
+  ASSERT_FALSE(myMap.contains(50));
+  ASSERT_EQ(myMap.size(), 99U);
+}
+
+TEST_F(FlatMapTest, OrderStatisticsAndScansTest) {
+  s21::flat_map<int, int> myMap{};
+  std::vector<std::pair<int, int>> sorted{};
+  for (int i{0}; i < 100; ++i) {
+    sorted.emplace_back(i * 2, i);
+  }
+  myMap.assign_sorted(sorted.begin(), sorted.end());
+  ASSERT_EQ(myMap.rank(10), 5U);
+  ASSERT_EQ(myMap.select(5)->first, 10);
+  ASSERT_EQ(myMap.count_range(10, 20), 5U);
+  ASSERT_EQ(myMap.advance(myMap.begin(), 1000), myMap.end());
+  myMap.for_each_range(0, 10, [](auto item) { item.second = -1; });
+  ASSERT_EQ(myMap.at(8), -1);
+  ASSERT_EQ(myMap.at(10), 5);
+  int visited{0};
+  for (auto [key, value] : myMap.scan(100, 110)) {
+    ASSERT_EQ(key, value * 2);
+    ++visited;
+  }
+  ASSERT_EQ(visited, 5);
+}
+
+TEST_F(FlatMapTest, TransparentLookupTest) {
+  s21::flat_map<std::string, int, std::less<>> myMap{{"one", 1}, {"two", 2}};
+  ASSERT_EQ(myMap.find("two")->second, 2);
+  ASSERT_TRUE(myMap.contains("one"));
+  myMap.erase("one");
+  ASSERT_EQ(myMap.count("one"), 0U);
+}
+}  // namespace s21
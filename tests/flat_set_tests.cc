@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../src/associative/flat_set/flat_set.h"
+#include "test_utils.h"
+
+namespace s21 {
+class FlatSetTest : public ::testing::Test {
+ protected:
+  std::mt19937 generator_{2024};
+};
+
+TEST_F(FlatSetTest, ListConstructorTest) {
+  std::set<int> stdSet{5, 1, 4, 2, 3, 4, 3, 2, 1};
+  s21::flat_set<int> mySet{5, 1, 4, 2, 3, 4, 3, 2, 1};
+  AssertContainerEquality(stdSet, mySet);
+  ASSERT_EQ(mySet.front(), 1);
+  ASSERT_EQ(mySet.back(), 5);
+}
+
+TEST_F(FlatSetTest, InsertAndEraseMatchStdTest) {
+  std::uniform_int_distribution<int> distribution{0, 499};
+  std::set<int> stdSet{};
+  s21::flat_set<int> mySet{};
+  for (int i{0}; i < 3000; ++i) {
+    int value{distribution(generator_)};
+    if (i % 3 == 2) {
+      stdSet.erase(value);
+      mySet.erase(value);
+    } else {
+      auto [position, inserted] = mySet.insert(value);
+      ASSERT_EQ(inserted, stdSet.insert(value).second);
+      ASSERT_EQ(*position, value);
+    }
+  }
+  AssertContainerEquality(stdSet, mySet);
+}
+
+TEST_F(FlatSetTest, InsertRangeMergesTest) {
+  std::uniform_int_distribution<int> distribution{0, 9999};
+  std::set<int> stdSet{};
+  s21::flat_set<int> mySet{};
+  for (int round{0}; round < 5; ++round) {
+    std::vector<int> batch{};
+    for (int i{0}; i < 1000; ++i) {
+      batch.push_back(distribution(generator_));
+    }
+    stdSet.insert(batch.begin(), batch.end());
+    mySet.insert_range(batch.begin(), batch.end());
+    AssertContainerEquality(stdSet, mySet);
+  }
+  mySet.insert_range({20000, 20001, 20000});
+  ASSERT_EQ(mySet.size(), stdSet.size() + 2);
+  ASSERT_EQ(mySet.back(), 20001);
+}
+
+TEST_F(FlatSetTest, BoundsMatchStdTest) {
+  std::vector<int> values{};
+  for (int i{0}; i < 1000; ++i) {
+    values.push_back(i * 3);
+  }
+  std::set<int> stdSet(values.begin(), values.end());
+  s21::flat_set<int> mySet(values.begin(), values.end());
+  for (int key{-2}; key < 3005; ++key) {
+    ASSERT_EQ(mySet.lower_bound(key) - mySet.begin(),
+              std::distance(stdSet.begin(), stdSet.lower_bound(key)));
+    ASSERT_EQ(mySet.upper_bound(key) - mySet.begin(),
+              std::distance(stdSet.begin(), stdSet.upper_bound(key)));
+    ASSERT_EQ(mySet.contains(key), stdSet.count(key) == 1);
+  }
+  ASSERT_EQ(mySet.rank(30), 10U);
+  ASSERT_EQ(*mySet.select(10), 30);
+  ASSERT_EQ(mySet.select(5000), mySet.end());
+  ASSERT_EQ(mySet.count_range(30, 60), 10U);
+  ASSERT_EQ(*mySet.advance(mySet.begin(), 4), 12);
+}
+
+TEST_F(FlatSetTest, AssignSortedAndScanTest) {
+  std::vector<int> sorted{1, 1, 2, 3, 3, 3, 5, 8};
+  s21::flat_set<int> mySet{};
+  mySet.assign_sorted(sorted.begin(), sorted.end());
+  AssertContainerEquality(std::set<int>{1, 2, 3, 5, 8}, mySet);
+  std::vector<int> visited{};
+  mySet.for_each_range(2, 8, [&visited](int value) {
+    visited.push_back(value);
+  });
+  ASSERT_EQ(visited, (std::vector<int>{2, 3, 5}));
+  int sum{0};
+  for (int value : mySet.scan(3, 100)) {
+    sum += value;
+  }
+  ASSERT_EQ(sum, 16);
+}
+
+TEST_F(FlatSetTest, TransparentLookupTest) {
+  s21::flat_set<std::string, std::less<>> mySet{"pear", "apple", "fig"};
+  ASSERT_TRUE(mySet.contains("fig"));
+  ASSERT_EQ(*mySet.find("apple"), "apple");
+  mySet.erase("fig");
+  ASSERT_FALSE(mySet.contains("fig"));
+  ASSERT_EQ(mySet.count("pear"), 1U);
+}
+}  // namespace s21
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../src/associative/interval_map/interval_map.h"
+#include "../src/associative/interval_set/interval_set.h"
+
+namespace s21 {
+class IntervalTest : public ::testing::Test {
+ protected:
+  std::mt19937 generator_{2024};
+};
+
+namespace {
+using Interval = std::pair<int, int>;
+
+std::vector<Interval> BruteOverlap(const std::set<Interval> &intervals,
+                                   int low, int high) {
+  std::vector<Interval> result{};
+  for (const Interval &interval : intervals) {
+    if (interval.first < high && low < interval.second && low < high) {
+      result.push_back(interval);
+    }
+  }
+  return result;
+}
+}  // namespace
+
+TEST_F(IntervalTest, OverlapMatchesBruteForceTest) {
+  std::uniform_int_distribution<int> starts{0, 9999};
+  std::uniform_int_distribution<int> lengths{1, 200};
+  s21::interval_set<int> mySet{};
+  std::set<Interval> expected{};
+  for (int i{0}; i < 3000; ++i) {
+    int low = starts(generator_);
+    int high = low + lengths(generator_);
+    if (i % 4 == 3 && !expected.empty()) {
+      auto position = expected.lower_bound({low, 0});
+      Interval victim =
+          position == expected.end() ? *expected.begin() : *position;
+      mySet.erase(victim.first, victim.second);
+      expected.erase(victim);
+    } else {
+      ASSERT_EQ(mySet.insert(low, high).second,
+                expected.insert({low, high}).second);
+    }
+  }
+  ASSERT_EQ(mySet.size(), expected.size());
+  for (int i{0}; i < 300; ++i) {
+    int low = starts(generator_);
+    int high = low + lengths(generator_) - 20;
+    std::vector<Interval> found{};
+    mySet.for_each_overlap(low, high, [&found](const Interval &interval) {
+      found.push_back(interval);
+    });
+    std::vector<Interval> brute = BruteOverlap(expected, low, high);
+    ASSERT_EQ(found, brute);
+    auto first = mySet.find_overlap(low, high);
+    if (brute.empty()) {
+      ASSERT_EQ(first, mySet.end());
+    } else {
+      ASSERT_EQ(*first, brute.front());
+    }
+    found.clear();
+    mySet.for_each_containing(low, [&found](const Interval &interval) {
+      found.push_back(interval);
+    });
+    ASSERT_EQ(found, BruteOverlap(expected, low, low + 1));
+  }
+}
+
+TEST_F(IntervalTest, IntervalSetBoundariesTest) {
+  s21::interval_set<int> mySet{{0, 10}, {10, 20}, {5, 6}};
+  ASSERT_THROW(mySet.insert(3, 3), std::invalid_argument);
+  ASSERT_FALSE(mySet.insert(0, 10).second);
+  ASSERT_EQ(*mySet.find_overlap(9, 10), Interval(0, 10));
+  ASSERT_EQ(*mySet.find_overlap(10, 11), Interval(10, 20));
+  ASSERT_EQ(mySet.find_overlap(20, 30), mySet.end());
+  ASSERT_EQ(mySet.find_overlap(7, 7), mySet.end());
+  int hits{0};
+  mySet.for_each_containing(5, [&hits](const Interval &) { ++hits; });
+  ASSERT_EQ(hits, 2);
+  mySet.erase(mySet.find(5, 6));
+  ASSERT_FALSE(mySet.contains(5, 6));
+  ASSERT_EQ(mySet.size(), 2U);
+}
+
+TEST_F(IntervalTest, IntervalMapTest) {
+  s21::interval_map<double, std::string> reservations{
+      {{9.0, 10.5}, "alice"}, {{10.0, 11.0}, "bob"}};
+  reservations.insert(13.0, 14.0, "carol");
+  ASSERT_FALSE(reservations.insert(13.0, 14.0, "dave").second);
+  reservations.insert_or_assign(13.0, 14.0, "dave");
+  ASSERT_EQ(reservations.at(13.0, 14.0), "dave");
+  ASSERT_THROW(reservations.at(1.0, 2.0), std::out_of_range);
+  std::vector<std::string> names{};
+  reservations.for_each_overlap(
+      10.25, 13.5, [&names](auto &item) { names.push_back(item.second); });
+  ASSERT_EQ(names, (std::vector<std::string>{"alice", "bob", "dave"}));
+  ASSERT_EQ(reservations.find_overlap(11.0, 13.0), reservations.end());
+  auto position = reservations.find_overlap(10.75, 12.0);
+  position->second = "robert";
+  ASSERT_EQ(reservations.at(10.0, 11.0), "robert");
+}
+
+TEST_F(IntervalTest, IntervalMapConstAccessTest) {
+  const s21::interval_map<int, int> readOnly{{{1, 2}, 7}, {{3, 5}, 8}};
+  static_assert(std::is_same_v<decltype(readOnly.at(1, 2)), const int &>);
+  ASSERT_EQ(readOnly.at(1, 2), 7);
+  ASSERT_EQ(readOnly.at(3, 5), 8);
+  ASSERT_THROW(readOnly.at(2, 3), std::out_of_range);
+  s21::interval_map<int, int> writable{{{1, 2}, 7}};
+  static_assert(std::is_same_v<decltype(writable.at(1, 2)), int &>);
+  writable.at(1, 2) = 99;
+  ASSERT_EQ(writable.at(1, 2), 99);
+}
+}  // namespace s21
@@ -1,5 +1,7 @@
 #include <iterator>
 #include <list>
+#include <memory>
+#include <string>
 
 #include "../src/sequence/list/list.h"
 #include "test_utils.h"
@@ -315,4 +317,57 @@ TEST_F(ListTest, InsertManyBackTest) {
   s21::list<int> result{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 5, 6, 7};
   AssertContainerEquality(myListTenElements, result);
 }
+
+TEST_F(ListTest, EmplaceTest) {
+  std::list<std::string> list{"b"};
+  s21::list<std::string> myList{"b"};
+  list.emplace_front(2, 'a');
+  ASSERT_EQ(myList.emplace_front(2, 'a'), "aa");
+  list.emplace_back("cde", 1);
+  ASSERT_EQ(myList.emplace_back("cde", 1), "c");
+  list.emplace(std::next(list.begin()), "x");
+  ASSERT_EQ(*myList.emplace(std::next(myList.cbegin()), "x"), "x");
+  AssertContainerEquality(list, myList);
+}
+
+TEST_F(ListTest, MoveOnlyTest) {
+  s21::list<std::unique_ptr<int>> myList{};
+  myList.push_back(std::make_unique<int>(2));
+  myList.push_front(std::make_unique<int>(1));
+  auto iter = myList.insert_many(myList.end(), std::make_unique<int>(3),
+                                 std::make_unique<int>(4));
+  ASSERT_EQ(**iter, 3);
+  myList.insert(myList.begin(), std::make_unique<int>(0));
+  int expected{0};
+  for (const auto &pointer : myList) {
+    ASSERT_EQ(*pointer, expected++);
+  }
+  myList.pop_front();
+  ASSERT_EQ(*myList.front(), 1);
+}
+
+TEST_F(ListTest, NoDefaultConstructorTest) {
+  struct Value {
+    explicit Value(int number) : number_{number} {}
+    int number_;
+  };
+  s21::list<Value> myList{};
+  myList.emplace_back(3);
+  myList.emplace_front(1);
+  myList.emplace(std::next(myList.cbegin()), 2);
+  int expected{1};
+  for (const auto &value : myList) {
+    ASSERT_EQ(value.number_, expected++);
+  }
+}
+
+TEST_F(ListTest, SortWithNegativeValuesTest) {
+  std::list<int> list{3, -5, 0, -1, 7, -5};
+  s21::list<int> myList{3, -5, 0, -1, 7, -5};
+  list.sort();
+  myList.sort();
+  AssertContainerEquality(list, myList);
+  ASSERT_EQ(myList.back(), 7);
+  ASSERT_EQ(*std::prev(myList.end()), 7);
+}
 }  // namespace s21
@@ -1,7 +1,17 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <vector>
 
 #include "../src/associative/map/map.h"
 #include "test_utils.h"
@@ -319,25 +329,43 @@ TEST_F(MapTest, EqualRange2) {
   AssertContainerEquality(stdMapTenElements, myMapTenElements);
 }
 
-///* Firstly wanted to set find_data bigger then maximum key value in the tree,
-// * but I don't understand why original equal_range returns
-// * minimal node of right child of root in case when it finds no suitable node.
-// * That's wierd, so I will have my implementation here */
-//    TEST_F(MapTest, EqualRange3) {
-//        int find_data = 9; /* Supposed to set bigger value here,
-// * If set upper bound value and bigger, it will work not like original one*/
-//
-//        auto std_pair = stdMapTenElements.equal_range(find_data);
-//
-//        auto my_pair = myMapTenElements.equal_range(find_data);
-//
-//        std::cout << "\n";
-//
-//        ASSERT_EQ(*std_pair.first, *my_pair.first);
-//        ASSERT_EQ(*std_pair.second, *my_pair.second);
-//
-//        AssertContainerEquality(stdMapTenElements, myMapTenElements);
-//    }
+TEST_F(MapTest, EqualRange3) {
+  int find_data = 11;
+
+  auto my_pair = myMapTenElements.equal_range(find_data);
+
+  ASSERT_EQ(my_pair.first, myMapTenElements.end());
+  ASSERT_EQ(my_pair.second, myMapTenElements.end());
+  ASSERT_EQ(myMapTenElements.lower_bound(find_data), myMapTenElements.end());
+  ASSERT_EQ(myMapTenElements.upper_bound(10), myMapTenElements.end());
+}
+
+TEST_F(MapTest, BoundsMissingKeysTest) {
+  std::map<int, int> stdMap{};
+  s21::map<int, int> myMap{};
+  for (int key{0}; key < 200; key += 5) {
+    stdMap.insert({key, -key});
+    myMap.insert(key, -key);
+  }
+  for (int key{-3}; key < 205; ++key) {
+    auto std_lower = stdMap.lower_bound(key);
+    auto std_upper = stdMap.upper_bound(key);
+    auto [lower, upper] = myMap.equal_range(key);
+    if (std_lower == stdMap.end()) {
+      ASSERT_EQ(lower, myMap.end());
+    } else {
+      ASSERT_EQ(*lower, *std_lower);
+    }
+    if (std_upper == stdMap.end()) {
+      ASSERT_EQ(upper, myMap.end());
+    } else {
+      ASSERT_EQ(*upper, *std_upper);
+    }
+    ASSERT_EQ(myMap.lower_bound(key), lower);
+    ASSERT_EQ(myMap.upper_bound(key), upper);
+    ASSERT_EQ(myMap.count(key), stdMap.count(key));
+  }
+}
 
 TEST_F(MapTest, AtExistedKeyAccessor) {
   int find_data = 9;
@@ -420,6 +448,193 @@ TEST_F(MapTest, ContainsNonExistTest) {
   AssertContainerEquality(stdMapTenElements, myMapTenElements);
 }
 
+TEST_F(MapTest, FindExistTest) {
+  for (int key{0}; key <= 10; ++key) {
+    auto std_iter = stdMapTenElements.find(key);
+    auto my_iter = myMapTenElements.find(key);
+    ASSERT_NE(my_iter, myMapTenElements.end());
+    ASSERT_EQ(std_iter->first, my_iter->first);
+    ASSERT_EQ(std_iter->second, my_iter->second);
+  }
+}
+
+TEST_F(MapTest, FindNonExistTest) {
+  ASSERT_EQ(myMapTenElements.find(-1), myMapTenElements.end());
+  ASSERT_EQ(myMapTenElements.find(11), myMapTenElements.end());
+  s21::map<int, int> myEmptyMap{};
+  ASSERT_EQ(myEmptyMap.find(0), myEmptyMap.end());
+}
+
+TEST_F(MapTest, FindIgnoresMappedValueTest) {
+  s21::map<int, int> myMap{{1, 100}, {2, 50}, {3, 0}};
+  ASSERT_EQ(myMap.find(2)->second, 50);
+  myMap.at(2) = 1000;
+  ASSERT_EQ(myMap.find(2)->second, 1000);
+  ASSERT_TRUE(myMap.contains(3));
+}
+
+TEST_F(MapTest, FindLargeTest) {
+  std::map<int, int> stdMap{};
+  s21::map<int, int> myMap{};
+  for (int i{0}; i < 1000; ++i) {
+    int key{(i * 7919) % 1000};
+    stdMap.insert({key, i});
+    myMap.insert({key, i});
+  }
+  for (int key{-5}; key < 1005; ++key) {
+    ASSERT_EQ(stdMap.count(key) == 1, myMap.contains(key));
+  }
+  myMap.erase(500);
+  stdMap.erase(500);
+  ASSERT_FALSE(myMap.contains(500));
+  AssertContainerEquality(stdMap, myMap);
+}
+
+TEST_F(MapTest, OrderStatisticsChurnTest) {
+  std::map<int, int> stdMap{};
+  s21::map<int, int> myMap{};
+  for (int i{0}; i < 2000; ++i) {
+    int key{(i * 7919) % 613};
+    if (i % 3 == 2) {
+      stdMap.erase(key);
+      myMap.erase(key);
+    } else {
+      stdMap.insert({key, i});
+      myMap.insert({key, i});
+    }
+    ASSERT_EQ(stdMap.size(), myMap.size());
+  }
+  std::size_t index{0};
+  for (const auto &[key, value] : stdMap) {
+    auto iter = myMap.select(index);
+    ASSERT_EQ(iter->first, key);
+    ASSERT_EQ(iter->second, value);
+    ASSERT_EQ(myMap.rank(key), index);
+    ++index;
+  }
+  ASSERT_EQ(myMap.count_range(100, 200),
+            static_cast<std::size_t>(std::distance(stdMap.lower_bound(100),
+                                                   stdMap.lower_bound(200))));
+}
+
+TEST_F(MapTest, AdvanceTest) {
+  auto iter = myMapTenElements.advance(myMapTenElements.begin(), 3);
+  ASSERT_EQ(iter->first, 3);
+  iter = myMapTenElements.advance(iter, 7);
+  ASSERT_EQ(iter->first, 10);
+  iter = myMapTenElements.advance(iter, 1);
+  ASSERT_EQ(iter, myMapTenElements.end());
+}
+
+TEST_F(MapTest, FrontBackTest) {
+  ASSERT_EQ(myMapTenElements.front().first, 0);
+  ASSERT_EQ(myMapTenElements.back().first, 10);
+  myMapTenElements.back().second = 7;
+  ASSERT_EQ(myMapTenElements.at(10), 7);
+  myMapTenElements.erase(0);
+  myMapTenElements.erase(10);
+  ASSERT_EQ(myMapTenElements.front().first, 1);
+  ASSERT_EQ(myMapTenElements.back().first, 9);
+  ASSERT_EQ(std::prev(myMapTenElements.end())->first, 9);
+}
+
+TEST_F(MapTest, RangeConstructorTest) {
+  std::vector<std::pair<int, int>> sorted{{1, 1}, {2, 2}, {2, 3}, {5, 5}};
+  std::map<int, int> stdMap(sorted.begin(), sorted.end());
+  s21::map<int, int> myMap(sorted.begin(), sorted.end());
+  AssertContainerEquality(stdMap, myMap);
+
+  std::vector<std::pair<int, int>> unsorted{{4, 1}, {2, 2}, {4, 3}, {1, 5}};
+  std::map<int, int> stdUnsortedMap(unsorted.begin(), unsorted.end());
+  s21::map<int, int> myUnsortedMap(unsorted.begin(), unsorted.end());
+  AssertContainerEquality(stdUnsortedMap, myUnsortedMap);
+}
+
+TEST_F(MapTest, AssignSortedTest) {
+  std::vector<std::pair<int, int>> sorted{};
+  for (int key{0}; key < 500; ++key) {
+    sorted.emplace_back(key, key * key);
+  }
+  myMapTenElements.assign_sorted(sorted.begin(), sorted.end());
+  std::map<int, int> stdMap(sorted.begin(), sorted.end());
+  AssertContainerEquality(stdMap, myMapTenElements);
+  ASSERT_EQ(myMapTenElements.at(499), 499 * 499);
+  myMapTenElements[1000] = 1;
+  stdMap[1000] = 1;
+  AssertContainerEquality(stdMap, myMapTenElements);
+}
+
+TEST_F(MapTest, CopyAssignmentStringsTest) {
+  s21::map<std::string, std::string> myMap{{"a", "1"}, {"b", "2"}};
+  s21::map<std::string, std::string> other{
+      {"x", "10"}, {"y", "20"}, {"z", "30"}};
+  myMap = other;
+  ASSERT_EQ(myMap.size(), 3U);
+  ASSERT_EQ(myMap.at("y"), "20");
+  ASSERT_FALSE(myMap.contains("a"));
+  other["x"] = "changed";
+  ASSERT_EQ(myMap.at("x"), "10");
+}
+
+TEST_F(MapTest, SetAlgebraKeepsOwnValuesTest) {
+  s21::map<int, int> myMap{{1, 10}, {2, 20}, {3, 30}};
+  myMap.set_union(s21::map<int, int>{{3, -1}, {4, -1}});
+  AssertContainerEquality(
+      myMap, std::map<int, int>{{1, 10}, {2, 20}, {3, 30}, {4, -1}});
+  myMap.set_intersection(s21::map<int, int>{{2, 0}, {4, 0}, {5, 0}});
+  AssertContainerEquality(myMap, std::map<int, int>{{2, 20}, {4, -1}});
+  myMap.symmetric_difference(s21::map<int, int>{{4, 0}, {6, 60}});
+  AssertContainerEquality(myMap, std::map<int, int>{{2, 20}, {6, 60}});
+  myMap.set_difference(s21::map<int, int>{{6, 0}});
+  AssertContainerEquality(myMap, std::map<int, int>{{2, 20}});
+  myMap[7] = 70;
+  ASSERT_EQ(myMap.size(), 2U);
+}
+
+TEST_F(MapTest, InsertHintTest) {
+  std::map<int, int> stdMap{};
+  s21::map<int, int> myMap{};
+  for (int key{0}; key < 200; ++key) {
+    stdMap.insert(stdMap.end(), {key, key * 3});
+    auto iter = myMap.insert(myMap.end(), {key, key * 3});
+    ASSERT_EQ(iter->second, key * 3);
+  }
+  auto iter = myMap.emplace_hint(myMap.find(50), 50, -1);
+  ASSERT_EQ(iter->second, 150);
+  iter = myMap.emplace_hint(myMap.begin(), -5, -5);
+  stdMap.emplace_hint(stdMap.begin(), -5, -5);
+  ASSERT_EQ(iter, myMap.begin());
+  AssertContainerEquality(stdMap, myMap);
+  myMap[1000] = 7;
+  ASSERT_EQ(myMap.back().second, 7);
+}
+
+TEST_F(MapTest, ExtractInsertNodeTest) {
+  s21::map<int, std::string> myMap{{1, "one"}, {2, "two"}, {3, "three"}};
+  const auto *address = &*myMap.find(2);
+  auto handle = myMap.extract(2);
+  ASSERT_EQ(handle.key(), 2);
+  ASSERT_EQ(handle.mapped(), "two");
+  handle.mapped() = "deux";
+  ASSERT_FALSE(myMap.contains(2));
+  ASSERT_TRUE(myMap.extract(2).empty());
+
+  s21::map<int, std::string> other{{3, "trois"}};
+  auto result = other.insert(std::move(handle));
+  ASSERT_TRUE(result.inserted);
+  ASSERT_EQ(&*result.position, address);
+  ASSERT_EQ(other.at(2), "deux");
+
+  auto duplicate = other.insert(myMap.extract(myMap.find(3)));
+  ASSERT_FALSE(duplicate.inserted);
+  ASSERT_EQ(duplicate.position->second, "trois");
+  ASSERT_EQ(duplicate.node.mapped(), "three");
+  myMap.insert(myMap.end(), std::move(duplicate.node));
+  ASSERT_EQ(myMap.at(3), "three");
+  ASSERT_EQ(myMap.size(), 2U);
+  ASSERT_EQ(other.size(), 2U);
+}
+
 TEST_F(MapTest, SizeTest) {
   ASSERT_EQ(stdMapTenElements.size(), myMapTenElements.size());
   stdMapTenElements.insert({1, 2});
@@ -456,4 +671,265 @@ TEST_F(MapTest, EmptyTest) {
 
   AssertContainerEquality(stdMapTenElements, myMapTenElements);
 }
-}  // namespace s21
\ No newline at end of file
+
+TEST_F(MapTest, EmplaceAndTryEmplaceTest) {
+  s21::map<int, std::string> myMap{};
+  auto [iter, inserted] = myMap.emplace(1, "one");
+  ASSERT_TRUE(inserted);
+  ASSERT_EQ(iter->second, "one");
+  ASSERT_FALSE(myMap.emplace(1, "uno").second);
+  ASSERT_TRUE(myMap.try_emplace(2, 3, 'b').second);
+  ASSERT_EQ(myMap.at(2), "bbb");
+  ASSERT_FALSE(myMap.try_emplace(2, "two").second);
+  ASSERT_EQ(myMap.at(2), "bbb");
+  std::string value{"three"};
+  ASSERT_TRUE(myMap.insert_or_assign(3, std::move(value)).second);
+  ASSERT_FALSE(myMap.insert_or_assign(3, "drei").second);
+  ASSERT_EQ(myMap.at(3), "drei");
+  myMap[4] = "four";
+  ASSERT_TRUE(myMap.insert(std::make_pair(5, std::string{"five"})).second);
+  auto results = myMap.insert_many(std::make_pair(6, "six"),
+                                   std::make_pair(1, "eins"));
+  ASSERT_TRUE(results[0].second);
+  ASSERT_FALSE(results[1].second);
+  AssertContainerEquality(
+      myMap, std::map<int, std::string>{{1, "one"},
+                                        {2, "bbb"},
+                                        {3, "drei"},
+                                        {4, "four"},
+                                        {5, "five"},
+                                        {6, "six"}});
+}
+
+TEST_F(MapTest, MoveOnlyMappedTest) {
+  s21::map<std::string, std::unique_ptr<int>> myMap{};
+  myMap.try_emplace("a", new int{1});
+  myMap.emplace("b", std::make_unique<int>(2));
+  auto pointer = std::make_unique<int>(3);
+  ASSERT_FALSE(myMap.try_emplace("b", std::move(pointer)).second);
+  ASSERT_NE(pointer, nullptr);
+  myMap["c"] = std::move(pointer);
+  myMap.insert_or_assign("a", std::make_unique<int>(10));
+  ASSERT_EQ(*myMap.at("a"), 10);
+  ASSERT_EQ(*myMap.at("b"), 2);
+  ASSERT_EQ(*myMap.at("c"), 3);
+  auto handle = myMap.extract("b");
+  ASSERT_EQ(*handle.mapped(), 2);
+  ASSERT_EQ(myMap.size(), 2U);
+}
+
+TEST_F(MapTest, NoDefaultConstructorTest) {
+  struct Value {
+    explicit Value(int number) : number_{number} {}
+    int number_;
+  };
+  s21::map<int, Value> myMap{};
+  myMap.try_emplace(2, 20);
+  myMap.emplace(std::piecewise_construct, std::forward_as_tuple(1),
+                std::forward_as_tuple(10));
+  ASSERT_EQ(myMap.at(1).number_, 10);
+  ASSERT_EQ(myMap.at(2).number_, 20);
+  myMap.erase(1);
+  ASSERT_EQ(myMap.size(), 1U);
+}
+
+TEST_F(MapTest, CustomCompareTest) {
+  s21::map<int, char, std::greater<int>> myMap{{1, 'a'}, {3, 'c'}, {2, 'b'}};
+  AssertContainerEquality(
+      myMap, std::map<int, char, std::greater<int>>{{1, 'a'}, {3, 'c'},
+                                                    {2, 'b'}});
+  ASSERT_EQ(myMap.lower_bound(5)->first, 3);
+  ASSERT_FALSE(myMap.key_comp()(1, 2));
+}
+
+TEST_F(MapTest, TransparentLookupTest) {
+  s21::map<std::string, int, std::less<>> myMap{{"one", 1}, {"two", 2}};
+  std::string_view key{"two"};
+  ASSERT_EQ(myMap.find(key)->second, 2);
+  ASSERT_TRUE(myMap.contains("one"));
+  ASSERT_EQ(myMap.count(std::string_view{"three"}), 0U);
+  ASSERT_EQ(myMap.lower_bound("p")->first, "two");
+  ASSERT_EQ(myMap.upper_bound("one")->first, "two");
+  auto [first, last] = myMap.equal_range(key);
+  ASSERT_EQ(std::distance(first, last), 1);
+  myMap.erase("one");
+  ASSERT_EQ(myMap.size(), 1U);
+  ASSERT_EQ(myMap.begin()->first, "two");
+}
+
+TEST_F(MapTest, ForEachRangeAndScanTest) {
+  s21::map<int, int> myMap{{1, 10}, {2, 20}, {3, 30}, {4, 40}};
+  myMap.for_each_range(2, 4, [](std::pair<const int, int> &item) {
+    item.second += 1;
+  });
+  ASSERT_EQ(myMap.at(1), 10);
+  ASSERT_EQ(myMap.at(2), 21);
+  ASSERT_EQ(myMap.at(3), 31);
+  ASSERT_EQ(myMap.at(4), 40);
+  int keys{0};
+  for (auto &[key, value] : myMap.scan(3, 10)) {
+    value = 0;
+    keys += key;
+  }
+  ASSERT_EQ(keys, 7);
+  ASSERT_EQ(myMap.at(3), 0);
+  ASSERT_EQ(myMap.at(4), 0);
+}
+TEST_F(MapTest, EraseRangeAndRangeViewTest) {
+  s21::map<int, int> myMap{};
+  std::map<int, int> stdMap{};
+  for (int key{0}; key < 200; ++key) {
+    myMap.insert(key, key);
+    stdMap.emplace(key, key);
+  }
+  auto next = myMap.erase(myMap.find(10), myMap.find(20));
+  stdMap.erase(stdMap.find(10), stdMap.find(20));
+  ASSERT_EQ(next->first, 20);
+  ASSERT_EQ(myMap.erase_range(50, 150), 100U);
+  stdMap.erase(stdMap.lower_bound(50), stdMap.lower_bound(150));
+  ASSERT_EQ(myMap.erase_range(60, 70), 0U);
+  AssertContainerEquality(myMap, stdMap);
+  int sum{0};
+  for (auto &[key, value] : myMap.range(5, 160)) {
+    value = -1;
+    sum += key;
+  }
+  ASSERT_EQ(sum, 5 + 6 + 7 + 8 + 9 + (20 + 49) * 30 / 2 + 150 + 151 + 152 +
+                     153 + 154 + 155 + 156 + 157 + 158 + 159);
+  ASSERT_EQ(myMap.at(20), -1);
+  ASSERT_EQ(myMap.at(160), 160);
+  auto empty = myMap.range(30, 30);
+  ASSERT_EQ(empty.begin(), empty.end());
+}
+
+TEST_F(MapTest, AggregateQueryTest) {
+  std::mt19937 generator{7};
+  std::uniform_int_distribution<int> keys{0, 499};
+  std::uniform_int_distribution<int> values{-1000, 1000};
+  s21::map<int, int, std::less<int>, HeapNodeAllocator, SumAggregate<int>>
+      sums{};
+  s21::map<int, int, std::less<int>, HeapNodeAllocator, MinAggregate<int>>
+      minimums{};
+  s21::map<int, int, std::less<int>, HeapNodeAllocator, MaxAggregate<int>>
+      maximums{};
+  s21::map<int, int, std::less<int>, HeapNodeAllocator, CountAggregate<int>>
+      counts{};
+  std::map<int, int> stdMap{};
+  for (int i{0}; i < 4000; ++i) {
+    int key = keys(generator);
+    int value = values(generator);
+    if (i % 5 == 4) {
+      sums.erase(key);
+      minimums.erase(key);
+      maximums.erase(key);
+      counts.erase(key);
+      stdMap.erase(key);
+    } else if (i % 5 == 3) {
+      sums[key] = value;
+      sums.refresh(sums.find(key));
+      minimums[key] = value;
+      minimums.refresh(minimums.find(key));
+      maximums[key] = value;
+      maximums.refresh(maximums.find(key));
+      counts[key] = value;
+      stdMap[key] = value;
+    } else {
+      sums.insert_or_assign(key, value);
+      minimums.insert_or_assign(key, value);
+      maximums.insert_or_assign(key, value);
+      counts.insert_or_assign(key, value);
+      stdMap.insert_or_assign(key, value);
+    }
+  }
+  sums.erase_range(100, 150);
+  minimums.erase_range(100, 150);
+  maximums.erase_range(100, 150);
+  counts.erase_range(100, 150);
+  stdMap.erase(stdMap.lower_bound(100), stdMap.lower_bound(150));
+  for (int i{0}; i < 200; ++i) {
+    int low = keys(generator);
+    int high = low + keys(generator) / 4;
+    int sum{0};
+    int minimum = std::numeric_limits<int>::max();
+    int maximum = std::numeric_limits<int>::lowest();
+    std::size_t count{0};
+    for (auto it = stdMap.lower_bound(low);
+         it != stdMap.end() && it->first < high; ++it) {
+      sum += it->second;
+      minimum = std::min(minimum, it->second);
+      maximum = std::max(maximum, it->second);
+      ++count;
+    }
+    ASSERT_EQ(sums.aggregate(low, high), sum);
+    ASSERT_EQ(minimums.aggregate(low, high), minimum);
+    ASSERT_EQ(maximums.aggregate(low, high), maximum);
+    ASSERT_EQ(counts.aggregate(low, high), count);
+    ASSERT_EQ(counts.aggregate(low, high), counts.count_range(low, high));
+  }
+  ASSERT_EQ(counts.aggregate(), stdMap.size());
+  ASSERT_EQ(sums.aggregate(300, 200), 0);
+}
+
+TEST_F(MapTest, InsertBatchKeepsPresentValuesTest) {
+  s21::map<int, std::string> myMap{{1, "one"}, {4, "four"}};
+  std::vector<std::pair<int, std::string>> batch{
+      {7, "seven"}, {4, "FOUR"}, {2, "two"}, {7, "SEVEN"}, {0, "zero"}};
+  std::vector<int> reported{};
+  ASSERT_EQ(myMap.insert_batch(batch.begin(), batch.end(),
+                               std::back_inserter(reported)),
+            3U);
+  ASSERT_EQ(reported, (std::vector<int>{0, 2, 7}));
+  std::map<int, std::string> stdMap{{0, "zero"}, {1, "one"}, {2, "two"},
+                                    {4, "four"}, {7, "seven"}};
+  AssertContainerEquality(myMap, stdMap);
+  ASSERT_EQ(myMap.insert_batch(batch.begin(), batch.end()), 0U);
+}
+
+TEST_F(MapTest, StatsTest) {
+  s21::map<int, int, std::less<int>, HeapNodeAllocator, NoAggregate,
+           TreeStats>
+      myMap{};
+  for (int key{0}; key < 64; ++key) {
+    myMap[key * 37 % 64] = key;
+  }
+  myMap.erase(5);
+  TreeCounters counters = myMap.stats();
+  ASSERT_EQ(counters.allocations, 64U);
+  ASSERT_EQ(counters.deallocations, 1U);
+  ASSERT_GT(counters.rotations, 0U);
+  myMap.reset_stats();
+  ASSERT_EQ(myMap.stats().comparisons, 0U);
+  for (int key{0}; key < 10; ++key) {
+    ASSERT_EQ(myMap.contains(key), key != 5);
+  }
+  ASSERT_EQ(myMap.stats().searches, 10U);
+}
+
+TEST_F(MapTest, EraseIteratorSkipsSearchTest) {
+  s21::map<int, int, std::less<int>, HeapNodeAllocator, NoAggregate,
+           TreeStats>
+      myMap{};
+  std::map<int, int> stdMap{};
+  for (int key{0}; key < 256; ++key) {
+    myMap[key * 37 % 256] = key;
+    stdMap[key * 37 % 256] = key;
+  }
+  for (int key{0}; key < 256; key += 3) {
+    auto iter = myMap.find(key);
+    myMap.reset_stats();
+    myMap.erase(iter);
+    stdMap.erase(key);
+    ASSERT_EQ(myMap.stats().comparisons, 0U);
+    ASSERT_EQ(myMap.stats().searches, 0U);
+  }
+  ASSERT_TRUE(std::equal(myMap.begin(), myMap.end(), stdMap.begin(),
+                         stdMap.end()));
+  s21::map<int, int, std::less<int>, BTreeNodes<>> btreeMap{};
+  for (int key{0}; key < 1000; ++key) {
+    btreeMap[key] = key;
+  }
+  btreeMap.erase(btreeMap.find(500));
+  ASSERT_EQ(btreeMap.size(), 999U);
+  ASSERT_FALSE(btreeMap.contains(500));
+}
+}  // namespace s21
@@ -1,9 +1,15 @@
 #include <gtest/gtest.h>
 
+#include <functional>
+#include <iterator>
 #include <set>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <vector>
 
 #include "../src/associative/multiset/multiset.h"
+#include "../src/associative/set/set.h"
 #include "test_utils.h"
 
 namespace s21 {
@@ -234,11 +240,224 @@ TEST_F(MultisetTest, EqualRange3) {
 
   auto my_pair = myMultisetTenElements.equal_range(find_data);
 
-  std::cout << "\n";
+  ASSERT_EQ(std_pair.first, stdMultisetTenElements.end());
+  ASSERT_EQ(std_pair.second, stdMultisetTenElements.end());
+  ASSERT_EQ(my_pair.first, myMultisetTenElements.end());
+  ASSERT_EQ(my_pair.second, myMultisetTenElements.end());
 
-  ASSERT_EQ(*std_pair.first, *my_pair.first);
-  ASSERT_EQ(*std_pair.second, *my_pair.second);
+  AssertContainerEquality(stdMultisetTenElements, myMultisetTenElements);
+}
+TEST_F(MultisetTest, SelectPercentileTest) {
+  std::multiset<int> stdMultiset{};
+  s21::multiset<int> myMultiset{};
+  for (int i{0}; i < 500; ++i) {
+    int value{(i * 37) % 101};
+    stdMultiset.insert(value);
+    myMultiset.insert(value);
+  }
+  std::size_t index{0};
+  for (int value : stdMultiset) {
+    ASSERT_EQ(*myMultiset.select(index), value);
+    ++index;
+  }
+  ASSERT_EQ(myMultiset.select(stdMultiset.size()), myMultiset.end());
+
+  std::size_t p90{stdMultiset.size() * 9 / 10};
+  ASSERT_EQ(*myMultiset.select(p90), *std::next(stdMultiset.begin(), 450));
+}
+
+TEST_F(MultisetTest, RankAndCountRangeTest) {
+  std::multiset<int> stdMultiset{1, 1, 2, 3, 3, 3, 5, 8, 8, 13};
+  s21::multiset<int> myMultiset{1, 1, 2, 3, 3, 3, 5, 8, 8, 13};
+  for (int key{0}; key < 15; ++key) {
+    auto expected = std::distance(stdMultiset.begin(),
+                                  stdMultiset.lower_bound(key));
+    ASSERT_EQ(myMultiset.rank(key), static_cast<std::size_t>(expected));
+  }
+  ASSERT_EQ(myMultiset.count_range(3, 8), 4U);
+  ASSERT_EQ(myMultiset.count_range(0, 100), 10U);
+  ASSERT_EQ(myMultiset.count_range(8, 3), 0U);
+  ASSERT_EQ(myMultiset.count_range(4, 5), 0U);
+}
+
+TEST_F(MultisetTest, AdvanceTest) {
+  auto iter = myMultisetTenElements.advance(myMultisetTenElements.begin(), 4);
+  ASSERT_EQ(*iter, 5);
+  iter = myMultisetTenElements.advance(iter, -2);
+  ASSERT_EQ(*iter, 3);
+  iter = myMultisetTenElements.advance(iter, 100);
+  ASSERT_EQ(iter, myMultisetTenElements.end());
+  iter = myMultisetTenElements.advance(iter, -1);
+  ASSERT_EQ(*iter, 10);
+}
+
+TEST_F(MultisetTest, SizeAfterEraseTest) {
+  myMultisetTenElements.insert(5);
+  myMultisetTenElements.insert(5);
+  ASSERT_EQ(myMultisetTenElements.size(), 12U);
+  myMultisetTenElements.erase(5);
+  myMultisetTenElements.erase(100);
+  ASSERT_EQ(myMultisetTenElements.size(), 11U);
+  ASSERT_EQ(myMultisetTenElements.count_range(5, 6), 2U);
+}
+TEST_F(MultisetTest, FrontBackTest) {
+  myMultisetTenElements.insert(10);
+  myMultisetTenElements.insert(1);
+  ASSERT_EQ(myMultisetTenElements.front(), 1);
+  ASSERT_EQ(myMultisetTenElements.back(), 10);
+  myMultisetTenElements.erase(10);
+  ASSERT_EQ(myMultisetTenElements.back(), 10);
+  myMultisetTenElements.erase(10);
+  ASSERT_EQ(myMultisetTenElements.back(), 9);
+}
+TEST_F(MultisetTest, RangeConstructorTest) {
+  std::vector<int> sorted{1, 1, 1, 2, 3, 3, 4};
+  std::multiset<int> stdMultiset(sorted.begin(), sorted.end());
+  s21::multiset<int> myMultiset(sorted.begin(), sorted.end());
+  AssertContainerEquality(stdMultiset, myMultiset);
 
+  myMultiset.assign_sorted(sorted.begin() + 1, sorted.end());
+  stdMultiset = std::multiset<int>(sorted.begin() + 1, sorted.end());
+  AssertContainerEquality(stdMultiset, myMultiset);
+  ASSERT_EQ(myMultiset.count_range(1, 2), 2U);
+}
+TEST_F(MultisetTest, CopyAssignmentReplacesTest) {
+  std::multiset<int> stdMultiset{7, 7, 8};
+  s21::multiset<int> myMultiset{7, 7, 8};
+  stdMultiset = stdMultisetTenElements;
+  myMultiset = myMultisetTenElements;
+  AssertContainerEquality(stdMultiset, myMultiset);
+  myMultiset.insert(3);
+  stdMultiset.insert(3);
+  AssertContainerEquality(stdMultiset, myMultiset);
   AssertContainerEquality(stdMultisetTenElements, myMultisetTenElements);
 }
+TEST_F(MultisetTest, SetAlgebraTest) {
+  s21::multiset<int> myMultiset{1, 1, 1, 2, 3, 3};
+  myMultiset.set_union(s21::multiset<int>{1, 3, 3, 3, 4});
+  AssertContainerEquality(myMultiset,
+                          std::multiset<int>{1, 1, 1, 2, 3, 3, 3, 4});
+  myMultiset.set_intersection(s21::multiset<int>{1, 1, 3, 4, 4});
+  AssertContainerEquality(myMultiset, std::multiset<int>{1, 1, 3, 4});
+  myMultiset.set_difference(s21::multiset<int>{1, 4});
+  AssertContainerEquality(myMultiset, std::multiset<int>{1, 3});
+  myMultiset.symmetric_difference(s21::multiset<int>{3, 3, 5});
+  AssertContainerEquality(myMultiset, std::multiset<int>{1, 3, 5});
+}
+TEST_F(MultisetTest, BoundsAndCountTest) {
+  std::multiset<int> stdMultiset{};
+  s21::multiset<int> myMultiset{};
+  for (int i{0}; i < 600; ++i) {
+    int value{(i * 53) % 97};
+    stdMultiset.insert(value);
+    myMultiset.insert(value);
+  }
+  for (int key{-2}; key < 100; ++key) {
+    auto expected_lower =
+        std::distance(stdMultiset.begin(), stdMultiset.lower_bound(key));
+    auto expected_upper =
+        std::distance(stdMultiset.begin(), stdMultiset.upper_bound(key));
+    auto [lower, upper] = myMultiset.equal_range(key);
+    ASSERT_EQ(std::distance(myMultiset.begin(), lower), expected_lower);
+    ASSERT_EQ(std::distance(myMultiset.begin(), upper), expected_upper);
+    ASSERT_EQ(myMultiset.lower_bound(key), lower);
+    ASSERT_EQ(myMultiset.upper_bound(key), upper);
+    ASSERT_EQ(myMultiset.count(key), stdMultiset.count(key));
+  }
+  ASSERT_EQ(myMultiset.lower_bound(97), myMultiset.end());
+  ASSERT_EQ(myMultiset.upper_bound(96), myMultiset.end());
+}
+TEST_F(MultisetTest, InsertHintTest) {
+  std::multiset<int> stdMultiset{};
+  s21::multiset<int> myMultiset{};
+  for (int value{300}; value > 0; --value) {
+    stdMultiset.insert(stdMultiset.begin(), value / 3);
+    myMultiset.insert(myMultiset.begin(), value / 3);
+  }
+  for (int value{0}; value < 50; ++value) {
+    stdMultiset.emplace_hint(stdMultiset.end(), value * 2);
+    myMultiset.emplace_hint(myMultiset.end(), value * 2);
+  }
+  AssertContainerEquality(myMultiset, stdMultiset);
+}
+TEST_F(MultisetTest, ExtractInsertNodeTest) {
+  s21::multiset<int> myMultiset{1, 2, 2, 2, 3};
+  const int *first = &*myMultiset.lower_bound(2);
+  auto handle = myMultiset.extract(2);
+  ASSERT_EQ(&handle.value(), first);
+  ASSERT_EQ(myMultiset.count(2), 2U);
+  ASSERT_TRUE(myMultiset.extract(7).empty());
+  ASSERT_EQ(myMultiset.insert(s21::multiset<int>::node_type{}),
+            myMultiset.end());
+  auto iter = myMultiset.insert(std::move(handle));
+  ASSERT_EQ(&*iter, first);
+  ASSERT_EQ(std::next(iter), myMultiset.find(3));
+  myMultiset.insert(myMultiset.begin(), myMultiset.extract(3));
+  AssertContainerEquality(myMultiset, std::multiset<int>{1, 2, 2, 2, 3});
+}
+TEST_F(MultisetTest, MergeWithSetTest) {
+  s21::multiset<int> myMultiset{1, 2, 2};
+  s21::set<int> mySet{2, 3};
+  myMultiset.merge(mySet);
+  ASSERT_TRUE(mySet.empty());
+  AssertContainerEquality(myMultiset, std::multiset<int>{1, 2, 2, 2, 3});
+  mySet.insert(5);
+  mySet.merge(myMultiset);
+  AssertContainerEquality(mySet, std::set<int>{1, 2, 3, 5});
+  AssertContainerEquality(myMultiset, std::multiset<int>{2, 2});
+}
+TEST_F(MultisetTest, EmplaceAndMoveInsertTest) {
+  s21::multiset<std::string> myMultiset{};
+  ASSERT_EQ(*myMultiset.emplace(2, 'z'), "zz");
+  myMultiset.emplace("zz");
+  std::string value{"a"};
+  myMultiset.insert(std::move(value));
+  myMultiset.insert(myMultiset.end(), std::string{"zz"});
+  myMultiset.insert_many("b", std::string{"a"});
+  AssertContainerEquality(
+      myMultiset, std::multiset<std::string>{"a", "a", "b", "zz", "zz", "zz"});
+}
+
+TEST_F(MultisetTest, CustomCompareTest) {
+  s21::multiset<int, std::greater<int>> myMultiset{1, 3, 3, 2};
+  AssertContainerEquality(myMultiset,
+                          std::multiset<int, std::greater<int>>{3, 3, 2, 1});
+  ASSERT_EQ(myMultiset.count(3), 2U);
+  auto [first, last] = myMultiset.equal_range(3);
+  ASSERT_EQ(std::distance(first, last), 2);
+}
+
+TEST_F(MultisetTest, TransparentLookupTest) {
+  s21::multiset<std::string, std::less<>> myMultiset{"a", "b", "b", "c"};
+  std::string_view key{"b"};
+  ASSERT_EQ(myMultiset.count(key), 2U);
+  ASSERT_TRUE(myMultiset.contains("c"));
+  auto [first, last] = myMultiset.equal_range(key);
+  ASSERT_EQ(std::distance(first, last), 2);
+  myMultiset.erase(key);
+  ASSERT_EQ(myMultiset.count("b"), 1U);
+}
+TEST_F(MultisetTest, EraseRangeAndRangeViewTest) {
+  s21::multiset<int> myMultiset{1, 2, 2, 3, 3, 3, 4, 5, 5};
+  std::multiset<int> stdMultiset{1, 2, 2, 3, 3, 3, 4, 5, 5};
+  ASSERT_EQ(myMultiset.erase_range(2, 4), 5U);
+  stdMultiset.erase(2);
+  stdMultiset.erase(3);
+  AssertContainerEquality(myMultiset, stdMultiset);
+  auto window = myMultiset.range(4, 6);
+  ASSERT_EQ(std::distance(window.begin(), window.end()), 3);
+  auto first = std::next(myMultiset.begin(), 2);
+  myMultiset.erase(first, std::next(first));
+  AssertContainerEquality(myMultiset, std::multiset<int>{1, 4, 5});
+}
+
+TEST_F(MultisetTest, InsertBatchTest) {
+  s21::multiset<int> mySet{5, 1, 5};
+  std::multiset<int> stdSet{5, 1, 5};
+  std::vector<int> batch{9, 5, 3, 3, 1, 12, 0};
+  ASSERT_EQ(mySet.insert_batch(batch.begin(), batch.end()), batch.size());
+  stdSet.insert(batch.begin(), batch.end());
+  AssertContainerEquality(stdSet, mySet);
+  ASSERT_EQ(mySet.count(5), 3U);
+}
 }  // namespace s21
@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include "../src/associative/map/map.h"
+#include "../src/associative/multiset/multiset.h"
+#include "../src/associative/set/set.h"
+#include "test_utils.h"
+
+namespace s21 {
+class NodeAllocatorTest : public ::testing::Test {
+ protected:
+  using SlabSet = s21::set<int, std::less<int>, SlabNodeAllocator>;
+  using SlabMultiset = s21::multiset<int, std::less<int>, SlabNodeAllocator>;
+  using SlabMap = s21::map<int, std::string, std::less<int>, SlabNodeAllocator>;
+  using ArenaSet = s21::set<int, std::less<int>, ArenaNodeAllocator>;
+  using ArenaMultiset = s21::multiset<int, std::less<int>, ArenaNodeAllocator>;
+  using ArenaMap =
+      s21::map<int, std::string, std::less<int>, ArenaNodeAllocator>;
+};
+
+TEST_F(NodeAllocatorTest, SlabSetChurnTest) {
+  std::set<int> stdSet{};
+  SlabSet mySet{};
+  for (int i{0}; i < 5000; ++i) {
+    int value{(i * 7919) % 1021};
+    if (i % 2 == 0) {
+      stdSet.insert(value);
+      mySet.insert(value);
+    } else {
+      stdSet.erase(value);
+      mySet.erase(value);
+    }
+  }
+  AssertContainerEquality(stdSet, mySet);
+}
+
+TEST_F(NodeAllocatorTest, SlabMapStringValuesTest) {
+  std::map<int, std::string> stdMap{};
+  SlabMap myMap{};
+  for (int i{0}; i < 1000; ++i) {
+    std::string value(static_cast<std::size_t>(i % 50), 'x');
+    stdMap.insert({i, value});
+    myMap.insert(i, value);
+  }
+  for (int i{0}; i < 1000; i += 3) {
+    stdMap.erase(i);
+    myMap.erase(i);
+  }
+  AssertContainerEquality(stdMap, myMap);
+}
+
+TEST_F(NodeAllocatorTest, ReserveNodesTest) {
+  SlabMultiset myMultiset{};
+  myMultiset.reserve_nodes(1000);
+  for (int i{0}; i < 1000; ++i) {
+    myMultiset.insert(i % 10);
+  }
+  ASSERT_EQ(myMultiset.size(), 1000U);
+  ASSERT_EQ(myMultiset.count_range(3, 4), 100U);
+
+  s21::set<int> heapSet{};
+  heapSet.reserve_nodes(10);
+  heapSet.insert(1);
+  ASSERT_EQ(heapSet.size(), 1U);
+}
+
+TEST_F(NodeAllocatorTest, CopyAndMoveTest) {
+  SlabSet mySet{1, 2, 3, 4, 5};
+  SlabSet copy{mySet};
+  SlabSet moved{std::move(mySet)};
+  AssertContainerEquality(copy, moved);
+  copy = moved;
+  moved = SlabSet{7, 8};
+  AssertContainerEquality(copy, std::set<int>{1, 2, 3, 4, 5});
+  AssertContainerEquality(moved, std::set<int>{7, 8});
+}
+
+TEST_F(NodeAllocatorTest, CrossThreadReleaseTest) {
+  SlabSet mySet{};
+  std::thread producer{[&mySet] {
+    for (int i{0}; i < 2000; ++i) {
+      mySet.insert(i);
+    }
+  }};
+  producer.join();
+  ASSERT_EQ(mySet.size(), 2000U);
+
+  std::thread consumer{[&mySet] { mySet.clear(); }};
+  consumer.join();
+  ASSERT_TRUE(mySet.empty());
+
+  for (int i{0}; i < 2000; ++i) {
+    mySet.insert(i);
+  }
+  ASSERT_EQ(mySet.size(), 2000U);
+}
+
+TEST_F(NodeAllocatorTest, ParallelSetAlgebraTest) {
+  SlabSet mySet{};
+  SlabSet other{};
+  std::set<int> stdSet{};
+  for (int i{0}; i < 60000; ++i) {
+    mySet.insert(i * 3);
+    other.insert(i * 2);
+    stdSet.insert(i * 3);
+  }
+  mySet.set_difference(other, 4);
+  for (int i{0}; i < 60000; ++i) {
+    stdSet.erase(i * 2);
+  }
+  AssertContainerEquality(mySet, stdSet);
+  mySet.set_union(std::move(other), 4);
+  ASSERT_EQ(mySet.size(), stdSet.size() + 60000);
+}
+
+TEST_F(NodeAllocatorTest, ArenaSetChurnTest) {
+  std::set<int> stdSet{};
+  ArenaSet mySet{};
+  for (int i{0}; i < 20000; ++i) {
+    int value{(i * 7919) % 4099};
+    if (i % 3 != 2) {
+      stdSet.insert(value);
+      mySet.insert(value);
+    } else {
+      stdSet.erase(value);
+      mySet.erase(value);
+    }
+  }
+  AssertContainerEquality(stdSet, mySet);
+  ASSERT_EQ(*mySet.select(10), *std::next(stdSet.begin(), 10));
+}
+
+TEST_F(NodeAllocatorTest, ArenaMapTest) {
+  std::map<int, std::string> stdMap{};
+  ArenaMap myMap{};
+  for (int i{0}; i < 1000; ++i) {
+    std::string value(static_cast<std::size_t>(i % 50), 'x');
+    stdMap.insert({i, value});
+    myMap.insert(i, value);
+  }
+  ArenaMap copy{myMap};
+  for (int i{0}; i < 1000; i += 3) {
+    stdMap.erase(i);
+    myMap.erase(i);
+  }
+  AssertContainerEquality(stdMap, myMap);
+  ASSERT_EQ(copy.size(), 1000U);
+
+  auto handle = copy.extract(7);
+  handle.mapped() = "seven";
+  myMap.erase(7);
+  myMap.insert(std::move(handle));
+  ASSERT_EQ(myMap.at(7), "seven");
+}
+
+TEST_F(NodeAllocatorTest, ArenaMultisetMergeTest) {
+  ArenaMultiset myMultiset{};
+  ArenaSet mySet{};
+  std::multiset<int> stdMultiset{};
+  for (int i{0}; i < 3000; ++i) {
+    myMultiset.insert(i % 100);
+    stdMultiset.insert(i % 100);
+    mySet.insert(i);
+  }
+  myMultiset.merge(mySet);
+  for (int i{0}; i < 3000; ++i) {
+    stdMultiset.insert(i);
+  }
+  AssertContainerEquality(stdMultiset, myMultiset);
+  ASSERT_TRUE(mySet.empty());
+}
+
+TEST_F(NodeAllocatorTest, ArenaParallelSetAlgebraTest) {
+  ArenaSet mySet{};
+  ArenaSet other{};
+  std::set<int> stdSet{};
+  for (int i{0}; i < 60000; ++i) {
+    mySet.insert(i * 3);
+    other.insert(i * 2);
+    stdSet.insert(i * 3);
+  }
+  mySet.set_difference(other, 4);
+  for (int i{0}; i < 60000; ++i) {
+    stdSet.erase(i * 2);
+  }
+  AssertContainerEquality(mySet, stdSet);
+  mySet.set_union(std::move(other), 4);
+  ASSERT_EQ(mySet.size(), stdSet.size() + 60000);
+}
+
+TEST_F(NodeAllocatorTest, ArenaNodeIsCompactTest) {
+  using ArenaNode = Node<int, IndexLayout>;
+  ASSERT_EQ(sizeof(ArenaNode), 20U);
+  ASSERT_EQ(sizeof(Node<int, UncountedLinks<IndexLayout>>), 16U);
+  ASSERT_EQ(sizeof(Node<int, ThreadedLinks<IndexLayout>>), 28U);
+  /* Free slots link by index, so slots keep the size of the node */
+  ASSERT_TRUE((std::is_same_v<ArenaNodeAllocator::Pool<ArenaNode>::Chunks,
+                              ArenaChunks<20, kCacheLineSize>>));
+}
+
+TEST_F(NodeAllocatorTest, PointerNodeSizesTest) {
+  ASSERT_EQ(sizeof(Node<int>), 5 * sizeof(void *));
+  ASSERT_EQ(sizeof(Node<int, UncountedLinks<PointerLayout>>),
+            4 * sizeof(void *));
+  ASSERT_EQ(sizeof(Node<int, ThreadedLinks<PointerLayout>>),
+            7 * sizeof(void *));
+}
+
+TEST_F(NodeAllocatorTest, UncountedSetTest) {
+  using UncountedSet =
+      s21::set<int, std::less<int>, UncountedNodes<HeapNodeAllocator>>;
+  UncountedSet mySet{};
+  std::set<int> stdSet{};
+  for (int i{0}; i < 3000; ++i) {
+    int value{(i * 7919) % 1021};
+    if (i % 3 == 2) {
+      mySet.erase(value);
+      stdSet.erase(value);
+    } else {
+      mySet.insert(value);
+      stdSet.insert(value);
+    }
+  }
+  AssertContainerEquality(mySet, stdSet);
+  ASSERT_EQ(mySet.count(*stdSet.begin()), 1U);
+  ASSERT_EQ(mySet.erase_range(100, 600),
+            static_cast<std::size_t>(std::distance(stdSet.lower_bound(100),
+                                                   stdSet.lower_bound(600))));
+  stdSet.erase(stdSet.lower_bound(100), stdSet.lower_bound(600));
+  AssertContainerEquality(mySet, stdSet);
+
+  UncountedSet evens{};
+  std::set<int> stdEvens{};
+  for (int i{0}; i < 1000; i += 2) {
+    evens.insert(i);
+    stdEvens.insert(i);
+  }
+  UncountedSet copy{mySet};
+  copy.set_intersection(evens);
+  std::set<int> expected{};
+  std::set_intersection(stdSet.begin(), stdSet.end(), stdEvens.begin(),
+                        stdEvens.end(),
+                        std::inserter(expected, expected.end()));
+  AssertContainerEquality(copy, expected);
+  mySet.merge(evens);
+  expected.clear();
+  std::set_intersection(stdSet.begin(), stdSet.end(), stdEvens.begin(),
+                        stdEvens.end(),
+                        std::inserter(expected, expected.end()));
+  AssertContainerEquality(evens, expected);
+  stdSet.insert(stdEvens.begin(), stdEvens.end());
+  AssertContainerEquality(mySet, stdSet);
+}
+
+TEST_F(NodeAllocatorTest, UncountedArenaMultisetTest) {
+  using UncountedMultiset =
+      s21::multiset<int, std::less<int>, UncountedNodes<ArenaNodeAllocator>>;
+  UncountedMultiset mySet{};
+  UncountedMultiset other{};
+  std::multiset<int> stdSet{};
+  std::multiset<int> stdOther{};
+  for (int i{0}; i < 2000; ++i) {
+    mySet.insert(i % 300);
+    stdSet.insert(i % 300);
+    other.insert(i % 170);
+    stdOther.insert(i % 170);
+  }
+  ASSERT_EQ(mySet.count(5), stdSet.count(5));
+  UncountedMultiset copy{mySet};
+  copy.set_union(other);
+  std::multiset<int> expected{};
+  std::set_union(stdSet.begin(), stdSet.end(), stdOther.begin(), stdOther.end(),
+                 std::inserter(expected, expected.end()));
+  AssertContainerEquality(copy, expected);
+  copy = mySet;
+  copy.set_difference(other);
+  expected.clear();
+  std::set_difference(stdSet.begin(), stdSet.end(), stdOther.begin(),
+                      stdOther.end(), std::inserter(expected, expected.end()));
+  AssertContainerEquality(copy, expected);
+  mySet.merge(other);
+  stdSet.insert(stdOther.begin(), stdOther.end());
+  AssertContainerEquality(mySet, stdSet);
+  ASSERT_TRUE(other.empty());
+}
+}  // namespace s21
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/associative/persistent_map/persistent_map.h"
+#include "../src/associative/persistent_set/persistent_set.h"
+
+namespace s21 {
+class PersistentTest : public ::testing::Test {
+ protected:
+  using IntTree = PersistentTree<int, IdentityKey<int>, std::less<int>>;
+
+  template <typename Persistent, typename Expected>
+  static void AssertSameElements(const Persistent &persistent,
+                                 const Expected &expected) {
+    ASSERT_EQ(persistent.size(), expected.size());
+    ASSERT_TRUE(std::equal(persistent.begin(), persistent.end(),
+                           expected.begin(), expected.end()));
+  }
+
+  std::mt19937 generator_{2024};
+};
+
+TEST_F(PersistentTest, TreeStaysValidTest) {
+  std::uniform_int_distribution<int> distribution{0, 499};
+  std::set<int> stdSet{};
+  IntTree tree{};
+  for (int i{0}; i < 4000; ++i) {
+    int key = distribution(generator_);
+    if (i % 3 == 2) {
+      tree = tree.Erase(key);
+      stdSet.erase(key);
+    } else {
+      tree = tree.Insert(key, false);
+      stdSet.insert(key);
+    }
+    ASSERT_TRUE(tree.IsValid());
+  }
+  ASSERT_EQ(tree.GetSize(), stdSet.size());
+  ASSERT_TRUE(
+      std::equal(tree.begin(), tree.end(), stdSet.begin(), stdSet.end()));
+  for (int key : stdSet) {
+    tree = tree.Erase(key);
+    ASSERT_TRUE(tree.IsValid());
+  }
+  ASSERT_TRUE(tree.IsEmpty());
+}
+
+TEST_F(PersistentTest, OldVersionsStayIntactTest) {
+  std::uniform_int_distribution<int> distribution{0, 199};
+  std::vector<s21::persistent_set<int>> versions{{}};
+  std::vector<std::set<int>> expected{{}};
+  for (int i{0}; i < 600; ++i) {
+    int key = distribution(generator_);
+    std::set<int> next{expected.back()};
+    if (i % 4 == 3) {
+      versions.push_back(versions.back().erase(key));
+      next.erase(key);
+    } else {
+      versions.push_back(versions.back().insert(key));
+      next.insert(key);
+    }
+    expected.push_back(std::move(next));
+  }
+  for (std::size_t i{0}; i < versions.size(); ++i) {
+    AssertSameElements(versions[i], expected[i]);
+  }
+}
+
+TEST_F(PersistentTest, MapVersionsTest) {
+  const s21::persistent_map<int, std::string> base{
+      {1, "one"}, {2, "two"}, {1, "uno"}};
+  ASSERT_EQ(base.size(), 2u);
+  ASSERT_EQ(base.at(1), "one");
+  auto assigned = base.insert_or_assign(1, "eins");
+  auto grown = assigned.insert(3, "three");
+  auto shrunk = grown.erase(2);
+  ASSERT_EQ(base.at(1), "one");
+  ASSERT_EQ(assigned.at(1), "eins");
+  ASSERT_EQ(grown.size(), 3u);
+  ASSERT_FALSE(shrunk.contains(2));
+  ASSERT_TRUE(grown.contains(2));
+  ASSERT_EQ(shrunk.erase(42).size(), 2u);
+  ASSERT_EQ(shrunk.find(3)->second, "three");
+  ASSERT_EQ(shrunk.find(2), shrunk.end());
+  ASSERT_EQ(grown.lower_bound(2)->first, 2);
+  ASSERT_THROW((void)shrunk.at(2), std::out_of_range);
+  ASSERT_TRUE(shrunk.clear().empty());
+}
+
+TEST_F(PersistentTest, SnapshotsReadAcrossThreadsTest) {
+  constexpr int kVersions = 200;
+  s21::persistent_map<int, int> current{};
+  std::vector<s21::persistent_map<int, int>> snapshots{};
+  for (int key{0}; key < kVersions; ++key) {
+    current = current.insert(key, key * key);
+    snapshots.push_back(current);
+  }
+  std::vector<std::thread> readers{};
+  std::vector<int> failures(4, 0);
+  for (int reader{0}; reader < 4; ++reader) {
+    readers.emplace_back([&snapshots, &failures, reader] {
+      for (int version{0}; version < kVersions; ++version) {
+        const auto &snapshot = snapshots[static_cast<std::size_t>(version)];
+        int expected{0};
+        for (const auto &item : snapshot) {
+          failures[static_cast<std::size_t>(reader)] +=
+              item.second != expected * expected ? 1 : 0;
+          ++expected;
+        }
+        failures[static_cast<std::size_t>(reader)] +=
+            expected != version + 1 ? 1 : 0;
+      }
+    });
+  }
+  for (int key{0}; key < kVersions; ++key) {
+    current = current.erase(key);
+  }
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  ASSERT_TRUE(current.empty());
+  ASSERT_EQ(failures, std::vector<int>(4, 0));
+}
+}  // namespace s21
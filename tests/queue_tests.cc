@@ -1,4 +1,5 @@
 #include <iterator>
+#include <memory>
 #include <queue>
 
 #include "../src/adaptors/queue/queue.h"
@@ -136,4 +137,16 @@ TEST_F(QueueTest, InsertManyBackTest) {
   queue.insert_many_back(1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
   AssertQueueEquality(stdQueueTenElements, myQueueTenElements);
 }
+
+TEST_F(QueueTest, EmplaceMoveOnlyTest) {
+  s21::queue<std::unique_ptr<int>> queue{};
+  queue.push(std::make_unique<int>(1));
+  ASSERT_EQ(*queue.emplace(new int{2}), 2);
+  queue.insert_many_back(std::make_unique<int>(3), std::make_unique<int>(4));
+  ASSERT_EQ(queue.size(), 4U);
+  for (int expected{1}; expected <= 4; ++expected) {
+    ASSERT_EQ(*queue.front(), expected);
+    queue.pop();
+  }
+}
 }  // namespace s21
@@ -0,0 +1,781 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../src/associative/red_black_tree/RedBlackTree.h"
+
+namespace s21 {
+class RedBlackTreeTest : public ::testing::Test {
+ protected:
+  std::mt19937 generator_{2024};
+
+  std::vector<int> MakeSortedValues(std::size_t count, int max_value,
+                                    bool unique) {
+    std::uniform_int_distribution<int> distribution{0, max_value};
+    std::vector<int> values{};
+    for (std::size_t i{0}; i < count; ++i) {
+      values.push_back(distribution(generator_));
+    }
+    std::sort(values.begin(), values.end());
+    if (unique) {
+      values.erase(std::unique(values.begin(), values.end()), values.end());
+    }
+    return values;
+  }
+};
+
+namespace {
+RedBlackTree<int> MakeTree(const std::vector<int> &values) {
+  RedBlackTree<int> tree{};
+  for (int value : values) {
+    tree.Insert(value);
+  }
+  return tree;
+}
+
+std::vector<int> ApplyStdAlgorithm(const std::vector<int> &first,
+                                   const std::vector<int> &second,
+                                   SetOperation operation) {
+  std::vector<int> result{};
+  auto out = std::back_inserter(result);
+  switch (operation) {
+    case SetOperation::kUnion:
+      std::set_union(first.begin(), first.end(), second.begin(), second.end(),
+                     out);
+      break;
+    case SetOperation::kIntersection:
+      std::set_intersection(first.begin(), first.end(), second.begin(),
+                            second.end(), out);
+      break;
+    case SetOperation::kDifference:
+      std::set_difference(first.begin(), first.end(), second.begin(),
+                          second.end(), out);
+      break;
+    case SetOperation::kSymmetricDifference:
+      std::set_symmetric_difference(first.begin(), first.end(),
+                                    second.begin(), second.end(), out);
+      break;
+  }
+  return result;
+}
+}  // namespace
+
+TEST_F(RedBlackTreeTest, EmptyTreeTest) {
+  RedBlackTree<int> tree{};
+  ASSERT_TRUE(tree.IsValid());
+  ASSERT_TRUE(tree.IsEmpty());
+  ASSERT_EQ(tree.GetSize(), 0U);
+}
+
+TEST_F(RedBlackTreeTest, RandomInsertRemoveInvariantsTest) {
+  std::multiset<int> stdMultiset{};
+  RedBlackTree<int> tree{};
+  std::uniform_int_distribution<int> distribution{0, 300};
+  for (int i{0}; i < 3000; ++i) {
+    int value{distribution(generator_)};
+    if (i % 3 == 0) {
+      auto iter = stdMultiset.find(value);
+      if (iter != stdMultiset.end()) stdMultiset.erase(iter);
+      tree.Remove(value);
+    } else {
+      stdMultiset.insert(value);
+      tree.Insert(value);
+    }
+    ASSERT_TRUE(tree.IsValid());
+    ASSERT_EQ(tree.GetSize(), stdMultiset.size());
+    if (!stdMultiset.empty()) {
+      ASSERT_EQ(*tree.begin(), *stdMultiset.begin());
+      ASSERT_EQ(*std::prev(tree.end()), *std::prev(stdMultiset.end()));
+    }
+  }
+  ASSERT_TRUE(std::equal(stdMultiset.begin(), stdMultiset.end(), tree.begin(),
+                         tree.end()));
+}
+
+TEST_F(RedBlackTreeTest, ExtremeNodesTest) {
+  RedBlackTree<int> tree{};
+  tree.Insert(5);
+  ASSERT_EQ(tree.GetLeftmost(), tree.GetRightmost());
+  ASSERT_EQ(*std::prev(tree.end()), 5);
+  tree.Insert(3);
+  ASSERT_EQ(*tree.begin(), 3);
+  ASSERT_EQ(*std::prev(tree.end()), 5);
+  tree.Insert(7);
+  ASSERT_EQ(tree.GetRightmost()->data_, 7);
+  tree.Remove(7);
+  tree.Remove(3);
+  ASSERT_TRUE(tree.IsValid());
+  ASSERT_EQ(tree.GetLeftmost()->data_, 5);
+  tree.Remove(5);
+  ASSERT_TRUE(tree.IsValid());
+  ASSERT_EQ(tree.begin(), tree.end());
+}
+
+TEST_F(RedBlackTreeTest, SelectAndRankTest) {
+  RedBlackTree<int> tree{};
+  for (int value{0}; value < 100; ++value) {
+    tree.Insert(value * 2);
+  }
+  for (std::size_t k{0}; k < 100; ++k) {
+    Node<int> *node = tree.Select(k);
+    ASSERT_EQ(node->data_, static_cast<int>(k) * 2);
+    ASSERT_EQ(tree.GetNodeRank(node), k);
+    ASSERT_EQ(tree.GetRank(static_cast<int>(k) * 2), k);
+    ASSERT_EQ(tree.GetUpperRank(static_cast<int>(k) * 2), k + 1);
+  }
+  ASSERT_EQ(tree.Select(100), tree.GetNil());
+}
+TEST_F(RedBlackTreeTest, AssignSortedAllSizesTest) {
+  for (int size{0}; size < 300; ++size) {
+    std::vector<int> values{};
+    for (int value{0}; value < size; ++value) {
+      values.push_back(value);
+    }
+    RedBlackTree<int> tree{};
+    tree.AssignSorted(values.begin(), values.end(), true);
+    ASSERT_TRUE(tree.IsValid());
+    ASSERT_EQ(tree.GetSize(), values.size());
+    ASSERT_TRUE(
+        std::equal(values.begin(), values.end(), tree.begin(), tree.end()));
+  }
+}
+
+TEST_F(RedBlackTreeTest, AssignSortedThenModifyTest) {
+  std::vector<int> values{1, 1, 2, 3, 3, 3, 4, 7, 9, 9};
+  RedBlackTree<int> tree{};
+  tree.AssignSorted(values.begin(), values.end(), true);
+  ASSERT_EQ(tree.GetSize(), 6U);
+  ASSERT_TRUE(tree.IsValid());
+  for (int value{0}; value < 50; ++value) {
+    tree.Insert(value);
+    ASSERT_TRUE(tree.IsValid());
+  }
+  for (int value{0}; value < 50; value += 2) {
+    tree.Remove(value);
+    ASSERT_TRUE(tree.IsValid());
+  }
+  ASSERT_EQ(tree.GetSize(), 31U);
+}
+
+TEST_F(RedBlackTreeTest, AssignUnsortedFallbackTest) {
+  std::vector<int> values{5, 3, 8, 3, 1};
+  RedBlackTree<int> tree{};
+  tree.Assign(values.begin(), values.end(), false);
+  ASSERT_TRUE(tree.IsValid());
+  std::multiset<int> expected(values.begin(), values.end());
+  ASSERT_TRUE(
+      std::equal(expected.begin(), expected.end(), tree.begin(), tree.end()));
+  tree.Assign(values.begin(), values.end(), true);
+  ASSERT_EQ(tree.GetSize(), 4U);
+}
+TEST_F(RedBlackTreeTest, CopyKeepsShapeTest) {
+  RedBlackTree<int> tree{};
+  for (int value{0}; value < 200; ++value) {
+    tree.Insert((value * 31) % 200);
+  }
+  RedBlackTree<int> copy{tree};
+  ASSERT_TRUE(copy.IsValid());
+  ASSERT_EQ(copy, tree);
+  ASSERT_EQ(copy.GetRoot()->data_, tree.GetRoot()->data_);
+  ASSERT_NE(copy.GetRoot(), tree.GetRoot());
+  copy.Insert(1000);
+  ASSERT_EQ(*std::prev(copy.end()), 1000);
+  ASSERT_EQ(*std::prev(tree.end()), 199);
+}
+
+TEST_F(RedBlackTreeTest, CopyAssignmentReusesNodesTest) {
+  RedBlackTree<int> small{1, 2, 3};
+  RedBlackTree<int> large{};
+  for (int value{0}; value < 100; ++value) {
+    large.Insert(value);
+  }
+  RedBlackTree<int> target{large};
+  target = small;
+  ASSERT_TRUE(target.IsValid());
+  ASSERT_EQ(target, small);
+  target = large;
+  ASSERT_TRUE(target.IsValid());
+  ASSERT_EQ(target, large);
+  target = target;
+  ASSERT_EQ(target, large);
+  RedBlackTree<int> empty{};
+  target = empty;
+  ASSERT_TRUE(target.IsEmpty());
+  ASSERT_TRUE(target.IsValid());
+}
+
+namespace {
+struct ThrowingCopy {
+  static inline int copies_left{0};
+  int value{};
+
+  ThrowingCopy() = default;
+  explicit ThrowingCopy(int new_value) : value{new_value} {}
+  ThrowingCopy(const ThrowingCopy &other) : value{other.value} {
+    if (--copies_left < 0) throw std::runtime_error{"copy failed"};
+  }
+  ThrowingCopy &operator=(const ThrowingCopy &) = default;
+
+  bool operator<(const ThrowingCopy &other) const {
+    return value < other.value;
+  }
+};
+}  // namespace
+
+TEST_F(RedBlackTreeTest, CopyAssignmentThrowTest) {
+  ThrowingCopy::copies_left = 1000;
+  RedBlackTree<ThrowingCopy> source{};
+  RedBlackTree<ThrowingCopy> target{};
+  for (int value{0}; value < 50; ++value) {
+    source.Insert(ThrowingCopy{value});
+    target.Insert(ThrowingCopy{value * 2});
+  }
+  ThrowingCopy::copies_left = 20;
+  ASSERT_THROW(target = source, std::runtime_error);
+  ASSERT_TRUE(target.IsEmpty());
+  ASSERT_TRUE(target.IsValid());
+  ThrowingCopy::copies_left = 1000;
+  target = source;
+  ASSERT_EQ(target.GetSize(), 50U);
+}
+
+TEST_F(RedBlackTreeTest, CombineMatchesStdAlgorithmsTest) {
+  const std::vector<std::pair<std::size_t, std::size_t>> sizes{
+      {0, 0},    {0, 40},     {40, 0},   {1, 1000},
+      {1000, 3}, {300, 300}, {2000, 50}, {5000, 60}};
+  const std::vector<SetOperation> operations{
+      SetOperation::kUnion, SetOperation::kIntersection,
+      SetOperation::kDifference, SetOperation::kSymmetricDifference};
+  for (bool unique : {true, false}) {
+    int max_value{unique ? 5000 : 200};
+    for (auto [first_size, second_size] : sizes) {
+      for (SetOperation operation : operations) {
+        std::vector<int> first{MakeSortedValues(first_size, max_value, unique)};
+        std::vector<int> second{
+            MakeSortedValues(second_size, max_value, unique)};
+        RedBlackTree<int> tree{MakeTree(first)};
+        RedBlackTree<int> other{MakeTree(second)};
+        tree.Combine(std::move(other), operation, unique);
+        std::vector<int> expected{ApplyStdAlgorithm(first, second, operation)};
+        ASSERT_TRUE(tree.IsValid());
+        ASSERT_TRUE(other.IsValid());
+        ASSERT_TRUE(other.IsEmpty());
+        ASSERT_EQ(tree.GetSize(), expected.size());
+        ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(),
+                               expected.end()));
+      }
+    }
+  }
+}
+
+TEST_F(RedBlackTreeTest, CombineReusesNodesTest) {
+  RedBlackTree<int> tree{MakeTree(MakeSortedValues(500, 1000, true))};
+  RedBlackTree<int> other{MakeTree(MakeSortedValues(500, 1000, true))};
+  std::set<const Node<int> *> nodes{};
+  for (auto iter = tree.begin(); iter != tree.end(); ++iter) {
+    nodes.insert(iter.base());
+  }
+  for (auto iter = other.begin(); iter != other.end(); ++iter) {
+    nodes.insert(iter.base());
+  }
+  tree.Combine(std::move(other), SetOperation::kUnion, true);
+  ASSERT_TRUE(tree.IsValid());
+  for (auto iter = tree.begin(); iter != tree.end(); ++iter) {
+    ASSERT_EQ(nodes.count(iter.base()), 1U);
+  }
+}
+
+TEST_F(RedBlackTreeTest, CombineWithItselfTest) {
+  RedBlackTree<int> tree{MakeTree({1, 2, 3})};
+  tree.Combine(std::move(tree), SetOperation::kUnion, true);
+  ASSERT_EQ(tree.GetSize(), 3U);
+  tree.Combine(std::move(tree), SetOperation::kDifference, true);
+  ASSERT_TRUE(tree.IsEmpty());
+  ASSERT_TRUE(tree.IsValid());
+}
+
+TEST_F(RedBlackTreeTest, MergeMovesNodesTest) {
+  for (auto [unique, second_size] : {std::pair{true, std::size_t{300}},
+                                     std::pair{false, std::size_t{300}},
+                                     std::pair{true, std::size_t{20}},
+                                     std::pair{false, std::size_t{20}}}) {
+    std::vector<int> first{MakeSortedValues(700, 1000, unique)};
+    std::vector<int> second{MakeSortedValues(second_size, 1000, unique)};
+    RedBlackTree<int> tree{MakeTree(first)};
+    RedBlackTree<int> other{MakeTree(second)};
+    tree.Merge(other, unique);
+
+    std::vector<int> expected_tree{};
+    std::vector<int> expected_other{};
+    if (unique) {
+      std::set_union(first.begin(), first.end(), second.begin(), second.end(),
+                     std::back_inserter(expected_tree));
+      std::set_intersection(second.begin(), second.end(), first.begin(),
+                            first.end(), std::back_inserter(expected_other));
+    } else {
+      std::merge(first.begin(), first.end(), second.begin(), second.end(),
+                 std::back_inserter(expected_tree));
+    }
+    ASSERT_TRUE(tree.IsValid());
+    ASSERT_TRUE(other.IsValid());
+    ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected_tree.begin(),
+                           expected_tree.end()));
+    ASSERT_TRUE(std::equal(other.begin(), other.end(), expected_other.begin(),
+                           expected_other.end()));
+  }
+}
+
+TEST_F(RedBlackTreeTest, MergeRepeatsIntoUniqueTest) {
+  for (std::size_t second_size : {300U, 20U}) {
+    std::vector<int> first{MakeSortedValues(700, 1000, true)};
+    std::vector<int> second{MakeSortedValues(second_size, 100, false)};
+    RedBlackTree<int> tree{MakeTree(first)};
+    RedBlackTree<int> other{MakeTree(second)};
+    tree.Merge(other, true, 1, false);
+
+    std::vector<int> second_keys{second};
+    second_keys.erase(std::unique(second_keys.begin(), second_keys.end()),
+                      second_keys.end());
+    std::vector<int> expected_tree{};
+    std::set_union(first.begin(), first.end(), second_keys.begin(),
+                   second_keys.end(), std::back_inserter(expected_tree));
+    std::vector<int> taken{};
+    std::set_difference(second_keys.begin(), second_keys.end(), first.begin(),
+                        first.end(), std::back_inserter(taken));
+    std::vector<int> expected_other{};
+    std::set_difference(second.begin(), second.end(), taken.begin(),
+                        taken.end(), std::back_inserter(expected_other));
+    ASSERT_TRUE(tree.IsValid());
+    ASSERT_TRUE(other.IsValid());
+    ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected_tree.begin(),
+                           expected_tree.end()));
+    ASSERT_TRUE(std::equal(other.begin(), other.end(), expected_other.begin(),
+                           expected_other.end()));
+  }
+}
+
+TEST_F(RedBlackTreeTest, ExtractRelinksNodesTest) {
+  std::vector<int> values{MakeSortedValues(500, 200, false)};
+  RedBlackTree<int> tree{MakeTree(values)};
+  RedBlackTree<int> other{};
+  std::vector<int> moved{};
+  for (int key{0}; key < 200; key += 3) {
+    Node<int> *node = tree.LowerBound(key);
+    if (node == tree.GetNil() || node->data_ != key) {
+      continue;
+    }
+    auto handle = tree.Extract(node);
+    ASSERT_EQ(&handle.value(), &node->data_);
+    ASSERT_TRUE(tree.IsValid());
+    ASSERT_EQ(other.InsertNode(other.GetNil(), handle, false).first, node);
+    ASSERT_TRUE(handle.empty());
+    moved.push_back(key);
+  }
+  std::vector<int> expected_tree{};
+  std::set_difference(values.begin(), values.end(), moved.begin(),
+                      moved.end(), std::back_inserter(expected_tree));
+  ASSERT_TRUE(other.IsValid());
+  ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected_tree.begin(),
+                         expected_tree.end()));
+  ASSERT_TRUE(
+      std::equal(other.begin(), other.end(), moved.begin(), moved.end()));
+}
+
+TEST_F(RedBlackTreeTest, ParallelCombineMatchesSequentialTest) {
+  for (bool unique : {true, false}) {
+    int max_value{unique ? 200000 : 20000};
+    std::vector<int> first{MakeSortedValues(60000, max_value, unique)};
+    std::vector<int> second{MakeSortedValues(40000, max_value, unique)};
+    for (SetOperation operation :
+         {SetOperation::kUnion, SetOperation::kIntersection,
+          SetOperation::kDifference, SetOperation::kSymmetricDifference}) {
+      for (std::size_t thread_count : {2U, 3U, 8U}) {
+        RedBlackTree<int> tree{MakeTree(first)};
+        tree.Combine(MakeTree(second), operation, unique, thread_count);
+        std::vector<int> expected{ApplyStdAlgorithm(first, second, operation)};
+        ASSERT_TRUE(tree.IsValid());
+        ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(),
+                               expected.end()));
+      }
+    }
+  }
+}
+
+TEST_F(RedBlackTreeTest, ParallelMergeTest) {
+  for (bool unique : {true, false}) {
+    std::vector<int> first{MakeSortedValues(50000, 80000, unique)};
+    std::vector<int> second{MakeSortedValues(50000, 80000, unique)};
+    RedBlackTree<int> tree{MakeTree(first)};
+    RedBlackTree<int> other{MakeTree(second)};
+    tree.Merge(other, unique, 4);
+
+    std::vector<int> expected_tree{};
+    std::vector<int> expected_other{};
+    if (unique) {
+      std::set_union(first.begin(), first.end(), second.begin(), second.end(),
+                     std::back_inserter(expected_tree));
+      std::set_intersection(second.begin(), second.end(), first.begin(),
+                            first.end(), std::back_inserter(expected_other));
+    } else {
+      std::merge(first.begin(), first.end(), second.begin(), second.end(),
+                 std::back_inserter(expected_tree));
+    }
+    ASSERT_TRUE(tree.IsValid());
+    ASSERT_TRUE(other.IsValid());
+    ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected_tree.begin(),
+                           expected_tree.end()));
+    ASSERT_TRUE(std::equal(other.begin(), other.end(), expected_other.begin(),
+                           expected_other.end()));
+  }
+}
+
+namespace {
+/* Fails every comparison made off the thread that armed it */
+struct WorkerThrowingLess {
+  static inline std::atomic<bool> armed{false};
+  static inline std::thread::id owner{};
+
+  bool operator()(int left, int right) const {
+    if (armed && std::this_thread::get_id() != owner) {
+      throw std::runtime_error{"comparison failed"};
+    }
+    return left < right;
+  }
+};
+}  // namespace
+
+TEST_F(RedBlackTreeTest, ParallelWorkerErrorIsRethrownTest) {
+  using Tree = RedBlackTree<int, IdentityKey<int>, WorkerThrowingLess>;
+  std::vector<int> first{MakeSortedValues(60000, 200000, true)};
+  std::vector<int> second{MakeSortedValues(40000, 200000, true)};
+  WorkerThrowingLess::owner = std::this_thread::get_id();
+  for (bool merge : {false, true}) {
+    Tree tree{};
+    Tree other{};
+    tree.AssignSorted(first.begin(), first.end(), true);
+    other.AssignSorted(second.begin(), second.end(), true);
+    WorkerThrowingLess::armed = true;
+    if (merge) {
+      ASSERT_THROW(tree.Merge(other, true, 4), std::runtime_error);
+    } else {
+      ASSERT_THROW(
+          tree.Combine(std::move(other), SetOperation::kUnion, true, 4),
+          std::runtime_error);
+    }
+    WorkerThrowingLess::armed = false;
+    ASSERT_TRUE(tree.IsEmpty());
+    ASSERT_TRUE(other.IsEmpty());
+    ASSERT_TRUE(tree.IsValid());
+    tree.Insert(1);
+    ASSERT_EQ(tree.GetSize(), 1U);
+  }
+}
+
+TEST_F(RedBlackTreeTest, MonotonicInsertFastPathTest) {
+  RedBlackTree<int> tree{};
+  for (int value{0}; value < 1000; ++value) {
+    tree.Insert(value);
+    tree.Insert(-value);
+  }
+  tree.Insert(999);
+  ASSERT_TRUE(tree.IsValid());
+  ASSERT_EQ(tree.GetSize(), 2001U);
+  ASSERT_EQ(tree.GetLeftmost()->data_, -999);
+  ASSERT_EQ(tree.GetRightmost()->data_, 999);
+  ASSERT_EQ(tree.CountKey(999), 2U);
+  ASSERT_EQ(tree.CountKey(0), 2U);
+}
+
+TEST_F(RedBlackTreeTest, HintedInsertMatchesStdTest) {
+  for (bool unique : {true, false}) {
+    std::multiset<int> stdMultiset{};
+    RedBlackTree<int> tree{};
+    std::uniform_int_distribution<int> distribution{0, 400};
+    for (int i{0}; i < 3000; ++i) {
+      int value{distribution(generator_)};
+      /* Alternates between exact hints, end() and arbitrary nodes */
+      Node<int> *hint = tree.GetNil();
+      if (i % 3 == 0) {
+        hint = tree.LowerBound(value);
+      } else if (i % 3 == 1 && !tree.IsEmpty()) {
+        hint = tree.Select(static_cast<std::size_t>(i) % tree.GetSize());
+      }
+      auto [node, inserted] = tree.InsertHint(hint, value, unique);
+      ASSERT_EQ(node->data_, value);
+      bool expected_insert{!unique || stdMultiset.count(value) == 0};
+      ASSERT_EQ(inserted, expected_insert);
+      if (expected_insert) {
+        stdMultiset.insert(value);
+      }
+      ASSERT_TRUE(tree.IsValid());
+    }
+    ASSERT_TRUE(std::equal(tree.begin(), tree.end(), stdMultiset.begin(),
+                           stdMultiset.end()));
+  }
+}
+
+TEST_F(RedBlackTreeTest, HintedInsertPlacesBeforeHintTest) {
+  using Pair = std::pair<int, int>;
+  RedBlackTree<Pair, PairFirstKey<Pair>> tree{};
+  Node<Pair> *first = tree.InsertHint(tree.GetNil(), {1, 0}, false).first;
+  tree.InsertHint(tree.GetNil(), {1, 1}, false);
+  tree.InsertHint(first, {1, 2}, false);
+  tree.EmplaceHint(first, false, 1, 3);
+  std::vector<Pair> expected{{1, 2}, {1, 3}, {1, 0}, {1, 1}};
+  ASSERT_TRUE(tree.IsValid());
+  ASSERT_TRUE(
+      std::equal(tree.begin(), tree.end(), expected.begin(), expected.end()));
+  auto [existing, inserted] = tree.EmplaceHint(first, true, 1, 9);
+  ASSERT_FALSE(inserted);
+  ASSERT_EQ(existing->data_.first, 1);
+  ASSERT_EQ(tree.GetSize(), 4U);
+}
+
+namespace {
+/* Walks a churned tree both ways and copies it */
+template <typename Tree>
+void CheckIteration(std::mt19937 &generator) {
+  std::set<int> expected{};
+  Tree tree{};
+  for (int i{0}; i < 2000; ++i) {
+    int value{static_cast<int>(generator() % 500)};
+    if (expected.count(value) != 0 && i % 3 == 0) {
+      expected.erase(value);
+      tree.RemoveByKey(value);
+    } else if (expected.insert(value).second) {
+      tree.Insert(value);
+    }
+  }
+  ASSERT_TRUE(tree.IsValid());
+  ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(),
+                         expected.end()));
+  auto iter = tree.end();
+  for (auto expected_iter = expected.rbegin(); expected_iter != expected.rend();
+       ++expected_iter) {
+    ASSERT_EQ(*--iter, *expected_iter);
+  }
+  ASSERT_EQ(iter, tree.begin());
+  ASSERT_EQ(--iter, tree.end());
+  Tree copy{tree};
+  ASSERT_TRUE(copy.IsValid());
+  ASSERT_EQ(*std::prev(copy.end()), *expected.rbegin());
+}
+
+template <typename NodeAllocator>
+using IntTreeOn =
+    RedBlackTree<int, IdentityKey<int>, std::less<>, NodeAllocator>;
+}  // namespace
+
+TEST_F(RedBlackTreeTest, IteratorClimbsTreeTest) {
+  std::mt19937 generator{7};
+  CheckIteration<RedBlackTree<int>>(generator);
+  CheckIteration<IntTreeOn<ArenaNodeAllocator>>(generator);
+}
+
+TEST_F(RedBlackTreeTest, IteratorFollowsThreadsTest) {
+  std::mt19937 generator{7};
+  CheckIteration<IntTreeOn<ThreadedNodes<HeapNodeAllocator>>>(generator);
+  CheckIteration<IntTreeOn<ThreadedNodes<ArenaNodeAllocator>>>(generator);
+  CheckIteration<IntTreeOn<ThreadedNodes<UncountedNodes<HeapNodeAllocator>>>>(
+      generator);
+  ASSERT_GT(sizeof(Node<int, ThreadedLinks<PointerLayout>>),
+            sizeof(Node<int>));
+}
+
+TEST_F(RedBlackTreeTest, ForEachRangeTest) {
+  RedBlackTree<int> tree{MakeTree(MakeSortedValues(300, 100, true))};
+  std::vector<int> visited{};
+  auto visit = [&visited](int value) { visited.push_back(value); };
+  tree.ForEachRange(20, 60, visit);
+  std::vector<int> expected{};
+  for (int value : tree) {
+    if (value >= 20 && value < 60) {
+      expected.push_back(value);
+    }
+  }
+  ASSERT_EQ(visited, expected);
+  visited.clear();
+  tree.ForEachRange(60, 20, visit);
+  ASSERT_TRUE(visited.empty());
+}
+
+TEST_F(RedBlackTreeTest, ThreadedForEachRangeTest) {
+  IntTreeOn<ThreadedNodes<HeapNodeAllocator>> tree{};
+  for (int value : MakeSortedValues(300, 100, false)) {
+    tree.Insert(value);
+  }
+  std::vector<int> visited{};
+  tree.ForEachRange(20, 60,
+                    [&visited](int value) { visited.push_back(value); });
+  std::vector<int> expected{};
+  std::copy_if(tree.begin(), tree.end(), std::back_inserter(expected),
+               [](int value) { return value >= 20 && value < 60; });
+  ASSERT_EQ(visited, expected);
+}
+TEST_F(RedBlackTreeTest, EraseRangeStaysValidTest) {
+  std::vector<int> values = MakeSortedValues(3000, 500, false);
+  std::uniform_int_distribution<std::size_t> distribution{0, values.size()};
+  RedBlackTree<int> tree = MakeTree(values);
+  std::multiset<int> expected(values.begin(), values.end());
+  for (std::size_t length : {0U, 1U, 3U, 40U, 700U, 2000U}) {
+    if (length > tree.GetSize()) {
+      length = tree.GetSize();
+    }
+    std::size_t offset =
+        distribution(generator_) % (tree.GetSize() - length + 1);
+    auto *first = tree.Select(offset);
+    auto *last = tree.Select(offset + length);
+    auto expected_first =
+        std::next(expected.begin(), static_cast<std::ptrdiff_t>(offset));
+    expected.erase(expected_first,
+                   std::next(expected_first,
+                             static_cast<std::ptrdiff_t>(length)));
+    ASSERT_EQ(tree.EraseRange(first, last), last);
+    ASSERT_TRUE(tree.IsValid());
+    ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(),
+                           expected.end()));
+  }
+  tree.EraseRange(tree.GetLeftmost(), tree.GetNil());
+  ASSERT_TRUE(tree.IsEmpty());
+  ASSERT_TRUE(tree.IsValid());
+}
+
+TEST_F(RedBlackTreeTest, SumAggregateStaysValidTest) {
+  using SumTree = RedBlackTree<int, IdentityKey<int>, std::less<>,
+                               HeapNodeAllocator, SumAggregate<int>>;
+  std::uniform_int_distribution<int> distribution{0, 999};
+  SumTree tree{};
+  std::multiset<int> expected{};
+  auto assert_windows = [&]() {
+    ASSERT_TRUE(tree.IsValid());
+    for (int i{0}; i < 50; ++i) {
+      int low = distribution(generator_);
+      int high = distribution(generator_);
+      int sum{0};
+      for (auto it = expected.lower_bound(low);
+           it != expected.end() && *it < high; ++it) {
+        sum += *it;
+      }
+      ASSERT_EQ(tree.Fold(low, high), sum);
+    }
+  };
+  for (int i{0}; i < 3000; ++i) {
+    int value = distribution(generator_);
+    if (i % 4 == 3) {
+      tree.RemoveByKey(value);
+      auto position = expected.find(value);
+      if (position != expected.end()) {
+        expected.erase(position);
+      }
+    } else {
+      tree.Insert(value);
+      expected.insert(value);
+    }
+  }
+  assert_windows();
+  tree.EraseRange(tree.Select(100), tree.Select(1500));
+  expected.erase(std::next(expected.begin(), 100),
+                 std::next(expected.begin(), 1500));
+  assert_windows();
+  SumTree other{};
+  for (int i{0}; i < 2000; ++i) {
+    other.Insert(distribution(generator_));
+  }
+  std::multiset<int> united{};
+  std::set_union(expected.begin(), expected.end(), other.begin(), other.end(),
+                 std::inserter(united, united.end()));
+  tree.Combine(std::move(other), SetOperation::kUnion, false, 4);
+  expected = united;
+  assert_windows();
+  SumTree copy{tree};
+  ASSERT_TRUE(copy.IsValid());
+  ASSERT_EQ(copy.Fold(), tree.Fold());
+}
+
+TEST_F(RedBlackTreeTest, InsertAfterFingerTest) {
+  for (bool unique : {false, true}) {
+    std::vector<int> values = MakeSortedValues(2000, 700, false);
+    RedBlackTree<int> tree = MakeTree(MakeSortedValues(1000, 700, unique));
+    std::multiset<int> expected(tree.begin(), tree.end());
+    auto *finger = tree.GetNil();
+    for (int value : values) {
+      auto [node, inserted] = tree.InsertAfter(finger, value, unique);
+      ASSERT_EQ(node->data_, value);
+      ASSERT_EQ(inserted, !unique || expected.count(value) == 0);
+      if (inserted) {
+        expected.insert(value);
+      }
+      finger = node;
+    }
+    ASSERT_TRUE(tree.IsValid());
+    ASSERT_TRUE(std::equal(tree.begin(), tree.end(), expected.begin(),
+                           expected.end()));
+  }
+}
+
+TEST_F(RedBlackTreeTest, TreeStatsCountWorkTest) {
+  ASSERT_EQ(sizeof(RedBlackTree<int>), 2 * sizeof(void *));
+  RedBlackTree<int, IdentityKey<int>, std::less<>, HeapNodeAllocator,
+               NoAggregate, TreeStats>
+      tree{};
+  for (int value{0}; value < 1000; ++value) {
+    tree.Insert(value);
+  }
+  TreeCounters counters = tree.GetCounters();
+  ASSERT_EQ(counters.allocations, 1000U);
+  ASSERT_EQ(counters.deallocations, 0U);
+  ASSERT_GT(counters.rotations, 0U);
+  ASSERT_GT(counters.insert_fixups, 0U);
+  ASSERT_GT(counters.comparisons, 0U);
+  tree.ResetCounters();
+  for (int value{0}; value < 1000; ++value) {
+    ASSERT_NE(tree.SearchByKey(value), tree.GetNil());
+  }
+  counters = tree.GetCounters();
+  ASSERT_EQ(counters.searches, 1000U);
+  ASSERT_EQ(counters.rotations, 0U);
+  ASSERT_LE(counters.max_search_path, 20U);
+  ASSERT_GE(counters.max_search_path, 10U);
+  ASSERT_LE(counters.search_path_nodes, 1000U * counters.max_search_path);
+  ASSERT_LE(counters.comparisons, 2 * counters.search_path_nodes);
+  auto copy = tree;
+  ASSERT_EQ(copy.GetCounters().searches, 0U);
+  for (int value{0}; value < 1000; ++value) {
+    tree.RemoveByKey(value);
+  }
+  counters = tree.GetCounters();
+  ASSERT_EQ(counters.deallocations, 1000U);
+  ASSERT_GT(counters.erase_fixups, 0U);
+  ASSERT_TRUE(tree.IsValid());
+}
+
+TEST_F(RedBlackTreeTest, TreeStatsExactAcrossThreadsTest) {
+  using Tree = RedBlackTree<int, IdentityKey<int>, std::less<>,
+                            HeapNodeAllocator, NoAggregate, TreeStats>;
+  std::vector<int> first{MakeSortedValues(80000, 200000, true)};
+  std::vector<int> second{MakeSortedValues(80000, 200000, true)};
+  TreeCounters counters[2]{};
+  for (std::size_t thread_count : {1U, 8U}) {
+    Tree tree{};
+    Tree other{};
+    tree.AssignSorted(first.begin(), first.end(), true);
+    other.AssignSorted(second.begin(), second.end(), true);
+    tree.ResetCounters();
+    tree.Combine(std::move(other), SetOperation::kIntersection, true,
+                 thread_count);
+    counters[thread_count == 1 ? 0 : 1] = tree.GetCounters();
+    ASSERT_EQ(counters[thread_count == 1 ? 0 : 1].deallocations,
+              first.size() + second.size() - tree.GetSize());
+  }
+  ASSERT_EQ(counters[1].comparisons, counters[0].comparisons);
+  ASSERT_EQ(counters[1].rotations, counters[0].rotations);
+  ASSERT_EQ(counters[1].insert_fixups, counters[0].insert_fixups);
+}
+}  // namespace s21
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../src/associative/run_length_multiset/run_length_multiset.h"
+#include "test_utils.h"
+
+namespace s21 {
+class RunLengthMultisetTest : public ::testing::Test {
+ protected:
+  std::mt19937 generator_{2024};
+};
+
+TEST_F(RunLengthMultisetTest, ListConstructorTest) {
+  std::multiset<int> stdSet{5, 1, 4, 2, 3, 4, 3, 2, 1, 1};
+  s21::run_length_multiset<int> mySet{5, 1, 4, 2, 3, 4, 3, 2, 1, 1};
+  AssertContainerEquality(stdSet, mySet);
+  ASSERT_EQ(mySet.distinct_size(), 5u);
+  ASSERT_EQ(mySet.front(), 1);
+  ASSERT_EQ(mySet.back(), 5);
+}
+
+TEST_F(RunLengthMultisetTest, InsertAndEraseMatchStdTest) {
+  std::uniform_int_distribution<int> distribution{0, 49};
+  std::multiset<int> stdSet{};
+  s21::run_length_multiset<int> mySet{};
+  for (int i{0}; i < 5000; ++i) {
+    int key = distribution(generator_);
+    if (i % 3 == 2) {
+      auto position = stdSet.find(key);
+      if (position != stdSet.end()) {
+        stdSet.erase(position);
+      }
+      mySet.erase(key, 1);
+    } else {
+      ASSERT_EQ(*mySet.insert(key), key);
+      stdSet.insert(key);
+    }
+  }
+  AssertContainerEquality(stdSet, mySet);
+  for (int key{0}; key < 50; ++key) {
+    ASSERT_EQ(mySet.count(key), stdSet.count(key));
+    auto [lower, upper] = mySet.equal_range(key);
+    ASSERT_EQ(static_cast<std::size_t>(std::distance(lower, upper)),
+              stdSet.count(key));
+  }
+  ASSERT_EQ(mySet.erase(7), stdSet.erase(7));
+  ASSERT_FALSE(mySet.contains(7));
+  AssertContainerEquality(stdSet, mySet);
+}
+
+TEST_F(RunLengthMultisetTest, CountedInsertAndEraseTest) {
+  s21::run_length_multiset<std::string> mySet{};
+  mySet.insert("click", 1000000000);
+  mySet.insert("view", 3);
+  auto last = mySet.insert("click");
+  ASSERT_EQ(last.copy_index(), 1000000000u);
+  ASSERT_EQ(mySet.size(), 1000000004u);
+  ASSERT_EQ(mySet.distinct_size(), 2u);
+  ASSERT_EQ(mySet.count("click"), 1000000001u);
+  ASSERT_EQ(mySet.erase("click", 1000000000), 1000000000u);
+  ASSERT_EQ(mySet.count("click"), 1u);
+  ASSERT_EQ(mySet.erase("view", 10), 3u);
+  ASSERT_EQ(mySet.size(), 1u);
+  std::vector<std::string> visited{};
+  mySet.for_each_run([&visited](const std::string &key, std::size_t count) {
+    visited.push_back(key + std::to_string(count));
+  });
+  ASSERT_EQ(visited, std::vector<std::string>{"click1"});
+}
+
+TEST_F(RunLengthMultisetTest, IteratorsVisitEveryCopyTest) {
+  s21::run_length_multiset<int> mySet{3, 1, 3, 2, 3};
+  std::vector<int> forward(mySet.begin(), mySet.end());
+  ASSERT_EQ(forward, (std::vector<int>{1, 2, 3, 3, 3}));
+  std::vector<int> backward{};
+  for (auto it = mySet.end(); it != mySet.begin();) {
+    backward.push_back(*--it);
+  }
+  ASSERT_EQ(backward, (std::vector<int>{3, 3, 3, 2, 1}));
+  mySet.erase(mySet.find(3));
+  ASSERT_EQ(mySet.count(3), 2u);
+  ASSERT_EQ(*mySet.lower_bound(2), 2);
+  ASSERT_EQ(*mySet.upper_bound(2), 3);
+  ASSERT_EQ(mySet.upper_bound(3), mySet.end());
+  s21::run_length_multiset<int> other{1, 4};
+  mySet.merge(other);
+  ASSERT_TRUE(other.empty());
+  ASSERT_EQ(mySet.size(), 6u);
+  ASSERT_EQ(mySet.count(1), 2u);
+  mySet.erase(mySet.find(2));
+  ASSERT_FALSE(mySet.contains(2));
+  ASSERT_EQ(mySet.size(), 5u);
+  ASSERT_EQ(mySet.distinct_size(), 3u);
+}
+}  // namespace s21
@@ -1,8 +1,15 @@
 #include <gtest/gtest.h>
 
+#include <functional>
+#include <iterator>
+#include <random>
 #include <set>
+#include <string>
+#include <string_view>
 #include <type_traits>
+#include <vector>
 
+#include "../src/associative/multiset/multiset.h"
 #include "../src/associative/set/set.h"
 #include "test_utils.h"
 
@@ -177,6 +184,188 @@ TEST_F(SetTest, MergeTest) {
   AssertContainerEquality(mySet, stdSet);
 }
 
+TEST_F(SetTest, FindTest) {
+  for (int value{0}; value <= 11; ++value) {
+    auto std_iter = stdSetTenElements.find(value);
+    auto my_iter = mySetTenElements.find(value);
+    if (std_iter == stdSetTenElements.end()) {
+      ASSERT_EQ(my_iter, mySetTenElements.end());
+    } else {
+      ASSERT_EQ(*std_iter, *my_iter);
+    }
+  }
+}
+
+TEST_F(SetTest, ContainsTest) {
+  ASSERT_TRUE(mySetTenElements.contains(1));
+  ASSERT_TRUE(mySetTenElements.contains(10));
+  ASSERT_FALSE(mySetTenElements.contains(0));
+  ASSERT_FALSE(mySetTenElements.contains(11));
+  s21::set<int> mySet{};
+  ASSERT_FALSE(mySet.contains(0));
+}
+
+TEST_F(SetTest, EraseNonExistTest) {
+  stdSetTenElements.erase(100);
+  mySetTenElements.erase(100);
+  AssertContainerEquality(stdSetTenElements, mySetTenElements);
+}
+
+TEST_F(SetTest, OrderStatisticsTest) {
+  ASSERT_EQ(*mySetTenElements.select(0), 1);
+  ASSERT_EQ(*mySetTenElements.select(9), 10);
+  ASSERT_EQ(mySetTenElements.select(10), mySetTenElements.end());
+  ASSERT_EQ(mySetTenElements.rank(0), 0U);
+  ASSERT_EQ(mySetTenElements.rank(5), 4U);
+  ASSERT_EQ(mySetTenElements.rank(11), 10U);
+  ASSERT_EQ(mySetTenElements.count_range(2, 5), 3U);
+  mySetTenElements.erase(3);
+  ASSERT_EQ(mySetTenElements.count_range(2, 5), 2U);
+  ASSERT_EQ(*mySetTenElements.select(2), 4);
+}
+
+TEST_F(SetTest, FrontBackTest) {
+  ASSERT_EQ(mySetTenElements.front(), 1);
+  ASSERT_EQ(mySetTenElements.back(), 10);
+  mySetTenElements.insert(0);
+  mySetTenElements.insert(42);
+  ASSERT_EQ(mySetTenElements.front(), 0);
+  ASSERT_EQ(mySetTenElements.back(), 42);
+  mySetTenElements.erase(0);
+  mySetTenElements.erase(42);
+  mySetTenElements.erase(10);
+  ASSERT_EQ(mySetTenElements.front(), 1);
+  ASSERT_EQ(mySetTenElements.back(), 9);
+  ASSERT_EQ(*std::prev(mySetTenElements.end()), 9);
+}
+
+TEST_F(SetTest, ElementAccessSmallSetTest) {
+  s21::set<int> mySet{4};
+  ASSERT_EQ(*std::prev(mySet.end()), 4);
+  mySet.insert(2);
+  ASSERT_EQ(*mySet.begin(), 2);
+  ASSERT_EQ(*std::prev(mySet.end()), 4);
+}
+
+TEST_F(SetTest, RangeConstructorTest) {
+  std::vector<int> sorted{1, 2, 2, 3, 5, 8, 8, 13};
+  std::set<int> stdSet(sorted.begin(), sorted.end());
+  s21::set<int> mySet(sorted.begin(), sorted.end());
+  AssertContainerEquality(stdSet, mySet);
+
+  std::vector<int> unsorted{9, 2, 7, 2, 4};
+  std::set<int> stdUnsortedSet(unsorted.begin(), unsorted.end());
+  s21::set<int> myUnsortedSet(unsorted.begin(), unsorted.end());
+  AssertContainerEquality(stdUnsortedSet, myUnsortedSet);
+}
+
+TEST_F(SetTest, AssignSortedTest) {
+  std::vector<int> sorted{};
+  for (int value{0}; value < 1000; ++value) {
+    sorted.push_back(value * 2);
+  }
+  mySetTenElements.assign_sorted(sorted.begin(), sorted.end());
+  std::set<int> stdSet(sorted.begin(), sorted.end());
+  AssertContainerEquality(stdSet, mySetTenElements);
+
+  mySetTenElements.insert(3);
+  mySetTenElements.erase(0);
+  stdSet.insert(3);
+  stdSet.erase(0);
+  AssertContainerEquality(stdSet, mySetTenElements);
+  ASSERT_EQ(*mySetTenElements.select(500), 1000);
+}
+
+TEST_F(SetTest, SetAlgebraTest) {
+  s21::set<int> mySet{1, 2, 3, 4, 5};
+  mySet.set_union(s21::set<int>{4, 5, 6, 7});
+  AssertContainerEquality(mySet, std::set<int>{1, 2, 3, 4, 5, 6, 7});
+  mySet.set_intersection(s21::set<int>{0, 2, 4, 6, 8});
+  AssertContainerEquality(mySet, std::set<int>{2, 4, 6});
+  mySet.set_difference(s21::set<int>{4});
+  AssertContainerEquality(mySet, std::set<int>{2, 6});
+  s21::set<int> other{1, 2, 3};
+  mySet.symmetric_difference(other);
+  AssertContainerEquality(mySet, std::set<int>{1, 3, 6});
+  AssertContainerEquality(other, std::set<int>{1, 2, 3});
+}
+
+TEST_F(SetTest, MergeLeavesDuplicatesTest) {
+  std::set<int> stdSet{5, 15, 25};
+  s21::set<int> mySet{5, 15, 25};
+  std::set<int> stdOther{5, 10, 15, 20};
+  s21::set<int> myOther{5, 10, 15, 20};
+  stdSet.merge(stdOther);
+  mySet.merge(myOther);
+  AssertContainerEquality(mySet, stdSet);
+  AssertContainerEquality(myOther, stdOther);
+  myOther.insert(30);
+  ASSERT_TRUE(myOther.contains(30));
+  ASSERT_FALSE(mySet.contains(30));
+}
+
+TEST_F(SetTest, BoundsTest) {
+  s21::set<int> mySet{10, 20, 30};
+  ASSERT_EQ(*mySet.lower_bound(20), 20);
+  ASSERT_EQ(*mySet.upper_bound(20), 30);
+  ASSERT_EQ(*mySet.lower_bound(-5), 10);
+  ASSERT_EQ(mySet.lower_bound(31), mySet.end());
+  ASSERT_EQ(mySet.upper_bound(30), mySet.end());
+  auto [lower, upper] = mySet.equal_range(25);
+  ASSERT_EQ(lower, upper);
+  ASSERT_EQ(*lower, 30);
+  ASSERT_EQ(mySet.count(20), 1U);
+  ASSERT_EQ(mySet.count(25), 0U);
+}
+
+TEST_F(SetTest, InsertHintTest) {
+  std::set<int> stdSet{};
+  s21::set<int> mySet{};
+  for (int value{0}; value < 300; ++value) {
+    stdSet.insert(stdSet.end(), value * 2);
+    auto iter = mySet.insert(mySet.end(), value * 2);
+    ASSERT_EQ(*iter, value * 2);
+  }
+  auto hint = mySet.find(100);
+  ASSERT_EQ(*mySet.insert(hint, 99), 99);
+  ASSERT_EQ(*mySet.insert(hint, 100), 100);
+  ASSERT_EQ(*mySet.insert(hint, 7), 7);
+  ASSERT_EQ(*mySet.emplace_hint(mySet.begin(), -1), -1);
+  stdSet.insert({99, 7, -1});
+  AssertContainerEquality(mySet, stdSet);
+  auto [iter, inserted] = mySet.insert(99);
+  ASSERT_FALSE(inserted);
+  ASSERT_EQ(*iter, 99);
+}
+
+TEST_F(SetTest, ExtractInsertNodeTest) {
+  s21::set<int> mySet{1, 2, 3, 4, 5};
+  const int *address = &*mySet.find(3);
+  auto handle = mySet.extract(3);
+  ASSERT_FALSE(handle.empty());
+  ASSERT_EQ(handle.value(), 3);
+  ASSERT_TRUE(mySet.extract(42).empty());
+  ASSERT_TRUE(mySet.extract(mySet.end()).empty());
+  AssertContainerEquality(mySet, std::set<int>{1, 2, 4, 5});
+
+  s21::set<int> other{1, 9};
+  auto result = other.insert(std::move(handle));
+  ASSERT_TRUE(result.inserted);
+  ASSERT_TRUE(result.node.empty());
+  ASSERT_EQ(&*result.position, address);
+  AssertContainerEquality(other, std::set<int>{1, 3, 9});
+
+  auto duplicate = other.insert(mySet.extract(mySet.begin()));
+  ASSERT_FALSE(duplicate.inserted);
+  ASSERT_EQ(*duplicate.position, 1);
+  ASSERT_EQ(duplicate.node.value(), 1);
+  duplicate.node.value() = 0;
+  auto hinted = other.insert(other.begin(), std::move(duplicate.node));
+  ASSERT_EQ(*hinted, 0);
+  AssertContainerEquality(other, std::set<int>{0, 1, 3, 9});
+  AssertContainerEquality(mySet, std::set<int>{2, 4, 5});
+}
+
 TEST_F(SetTest, SwapTest) {
   s21::set<int> mySet1{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
   s21::set<int> mySet1_copy = mySet1;
@@ -186,4 +375,180 @@ TEST_F(SetTest, SwapTest) {
   AssertContainerEquality(mySet1, mySet2_copy);
   AssertContainerEquality(mySet2, mySet1_copy);
 }
+
+TEST_F(SetTest, EmplaceAndMoveInsertTest) {
+  s21::set<std::string> mySet{"b"};
+  auto [iter, inserted] = mySet.emplace(3, 'a');
+  ASSERT_TRUE(inserted);
+  ASSERT_EQ(*iter, "aaa");
+  ASSERT_FALSE(mySet.emplace("b").second);
+  std::string value{"c"};
+  ASSERT_TRUE(mySet.insert(std::move(value)).second);
+  std::string duplicate{"c"};
+  ASSERT_FALSE(mySet.insert(std::move(duplicate)).second);
+  ASSERT_EQ(duplicate, "c");
+  auto results = mySet.insert_many(std::string{"d"}, "a", "b");
+  ASSERT_TRUE(results[0].second);
+  ASSERT_TRUE(results[1].second);
+  ASSERT_FALSE(results[2].second);
+  AssertContainerEquality(mySet,
+                          std::set<std::string>{"a", "aaa", "b", "c", "d"});
+}
+
+TEST_F(SetTest, CustomCompareTest) {
+  s21::set<int, std::greater<int>> mySet{3, 1, 2};
+  mySet.insert(5);
+  AssertContainerEquality(mySet, std::set<int, std::greater<int>>{5, 3, 2, 1});
+  ASSERT_EQ(*mySet.lower_bound(4), 3);
+  ASSERT_TRUE(mySet.key_comp()(2, 1));
+}
+
+TEST_F(SetTest, StatefulCompareTest) {
+  struct ModuloLess {
+    int modulo;
+    bool operator()(int left, int right) const {
+      return left % modulo < right % modulo;
+    }
+  };
+  s21::set<int, ModuloLess> mySet{ModuloLess{10}};
+  mySet.insert(13);
+  mySet.insert(21);
+  ASSERT_FALSE(mySet.insert(3).second);
+  ASSERT_EQ(*mySet.begin(), 21);
+  s21::set<int, ModuloLess> copy{mySet};
+  ASSERT_EQ(copy.key_comp().modulo, 10);
+  ASSERT_TRUE(copy.contains(33));
+}
+
+TEST_F(SetTest, TransparentLookupTest) {
+  s21::set<std::string, std::less<>> mySet{"apple", "banana", "cherry"};
+  std::string_view key{"banana"};
+  ASSERT_EQ(*mySet.find(key), "banana");
+  ASSERT_TRUE(mySet.contains("cherry"));
+  ASSERT_EQ(mySet.count(std::string_view{"date"}), 0U);
+  ASSERT_EQ(*mySet.lower_bound("b"), "banana");
+  ASSERT_EQ(*mySet.upper_bound(key), "cherry");
+  mySet.erase(key);
+  AssertContainerEquality(mySet, std::set<std::string>{"apple", "cherry"});
+}
+
+TEST_F(SetTest, EmptyCompareTakesNoSpaceTest) {
+  ASSERT_EQ(sizeof(s21::set<int, std::greater<int>>), sizeof(s21::set<int>));
+  ASSERT_EQ(sizeof(s21::set<int, std::less<>>), sizeof(s21::set<int>));
+}
+
+TEST_F(SetTest, ForEachRangeAndScanTest) {
+  s21::set<int> mySet{};
+  for (int i{0}; i < 100; ++i) {
+    mySet.insert(i * 2);
+  }
+  int sum{0};
+  mySet.for_each_range(10, 21, [&sum](int value) { sum += value; });
+  ASSERT_EQ(sum, 10 + 12 + 14 + 16 + 18 + 20);
+  std::vector<int> scanned{};
+  for (int value : mySet.scan(191, 1000)) {
+    scanned.push_back(value);
+  }
+  ASSERT_EQ(scanned, (std::vector<int>{192, 194, 196, 198}));
+  ASSERT_EQ(mySet.scan(50, 50).begin(), mySet.scan(50, 50).end());
+}
+
+TEST_F(SetTest, ThreadedScanTest) {
+  s21::set<int, std::less<int>, ThreadedNodes<HeapNodeAllocator>> mySet{};
+  for (int i{0}; i < 100; ++i) {
+    mySet.insert((i * 37) % 100);
+  }
+  int sum{0};
+  mySet.for_each_range(10, 21, [&sum](int value) { sum += value; });
+  ASSERT_EQ(sum, 165);
+  std::vector<int> scanned{};
+  for (int value : mySet.scan(95, 1000)) {
+    scanned.push_back(value);
+  }
+  ASSERT_EQ(scanned, (std::vector<int>{95, 96, 97, 98, 99}));
+  mySet.erase(99);
+  ASSERT_EQ(*std::prev(mySet.end()), 98);
+}
+TEST_F(SetTest, EraseRangeAndRangeViewTest) {
+  s21::set<int> mySet{};
+  for (int i{0}; i < 100; ++i) {
+    mySet.insert(i);
+  }
+  ASSERT_EQ(*mySet.erase(mySet.begin(), mySet.find(90)), 90);
+  ASSERT_EQ(mySet.erase_range(95, 1000), 5U);
+  AssertContainerEquality(mySet, std::set<int>{90, 91, 92, 93, 94});
+  auto window = mySet.range(91, 93);
+  ASSERT_EQ((std::vector<int>(window.begin(), window.end())),
+            (std::vector<int>{91, 92}));
+  ASSERT_EQ(*std::prev(window.end()), 92);
+  ASSERT_EQ(mySet.erase(mySet.begin(), mySet.end()), mySet.end());
+  ASSERT_TRUE(mySet.empty());
+}
+
+TEST_F(SetTest, InsertBatchReportsNewKeysTest) {
+  std::mt19937 generator{11};
+  std::uniform_int_distribution<int> distribution{0, 9999};
+  s21::set<int> mySet{};
+  s21::set<int, std::less<int>, BTreeNodes<>> myBTreeSet{};
+  std::set<int> stdSet{};
+  for (std::size_t batch_size : {1U, 30U, 5000U, 20000U}) {
+    std::vector<int> batch{};
+    for (std::size_t i{0}; i < batch_size; ++i) {
+      batch.push_back(distribution(generator));
+    }
+    std::set<int> expected_new{};
+    for (int key : batch) {
+      if (stdSet.insert(key).second) {
+        expected_new.insert(key);
+      }
+    }
+    std::vector<int> reported{};
+    ASSERT_EQ(mySet.insert_batch(batch.begin(), batch.end(),
+                                 std::back_inserter(reported)),
+              expected_new.size());
+    ASSERT_EQ(reported, std::vector<int>(expected_new.begin(),
+                                         expected_new.end()));
+    ASSERT_EQ(myBTreeSet.insert_batch(batch.begin(), batch.end()),
+              expected_new.size());
+    AssertContainerEquality(stdSet, mySet);
+    AssertContainerEquality(stdSet, myBTreeSet);
+  }
+}
+
+TEST_F(SetTest, StatsTest) {
+  s21::set<int, std::less<int>, HeapNodeAllocator, TreeStats> mySet{};
+  s21::multiset<int, std::less<int>, HeapNodeAllocator, TreeStats> other{
+      3, 3, 9};
+  for (int key{100}; key > 0; --key) {
+    mySet.insert(key * 7 % 101);
+  }
+  ASSERT_EQ(mySet.stats().allocations, 100U);
+  mySet.reset_stats();
+  ASSERT_TRUE(mySet.contains(14));
+  mySet.merge(other);
+  TreeCounters counters = mySet.stats();
+  ASSERT_GE(counters.searches, 1U);
+  ASSERT_EQ(counters.allocations, 0U);
+  ASSERT_EQ(other.size(), 3U);
+  ASSERT_EQ(other.stats().allocations, 3U);
+}
+
+TEST_F(SetTest, StatsCountNodeHandlesTest) {
+  s21::set<int, std::less<int>, HeapNodeAllocator, TreeStats> mySet{};
+  for (int value{0}; value < 10; ++value) {
+    mySet.insert(value);
+  }
+  { auto dropped{mySet.extract(3)}; }
+  TreeCounters counters = mySet.stats();
+  ASSERT_EQ(counters.allocations, 10U);
+  ASSERT_EQ(counters.deallocations, 1U);
+  ASSERT_EQ(counters.allocations - counters.deallocations, mySet.size());
+  auto handle{mySet.extract(5)};
+  ASSERT_EQ(mySet.stats().deallocations, 2U);
+  ASSERT_TRUE(mySet.insert(std::move(handle)).inserted);
+  counters = mySet.stats();
+  ASSERT_EQ(counters.allocations, 11U);
+  ASSERT_EQ(counters.deallocations, 2U);
+  ASSERT_EQ(counters.allocations - counters.deallocations, mySet.size());
+}
 }  // namespace s21
@@ -1,4 +1,5 @@
 #include <iterator>
+#include <memory>
 #include <stack>
 
 #include "../src/adaptors/stack/stack.h"
@@ -120,4 +121,16 @@ TEST_F(StackTest, InsertManyFrontTest) {
   stack.insert_many_front(1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
   AssertStackEquality(stdStackTenElements, stack);
 }
+
+TEST_F(StackTest, EmplaceMoveOnlyTest) {
+  s21::stack<std::unique_ptr<int>> stack{};
+  stack.push(std::make_unique<int>(1));
+  ASSERT_EQ(*stack.emplace(new int{2}), 2);
+  stack.insert_many_front(std::make_unique<int>(3), std::make_unique<int>(4));
+  ASSERT_EQ(stack.size(), 4U);
+  for (int expected{4}; expected > 0; --expected) {
+    ASSERT_EQ(*stack.top(), expected);
+    stack.pop();
+  }
+}
 }  // namespace s21
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include <map>
+#include <memory>
+#include <string>
 #include <type_traits>
 #include <vector>
 
@@ -410,4 +412,61 @@ TEST_F(VectorTest, InsertManyBackTest3) {
   s21::vector<int> resultVector{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
   AssertContainerEquality(resultVector, myVectorTenElements);
 }
+
+TEST_F(VectorTest, PushBackIntoEmptyTest) {
+  std::vector<int> stdVector{};
+  s21::vector<int> myVector{};
+  for (int i{0}; i < 100; ++i) {
+    stdVector.push_back(i);
+    myVector.push_back(i);
+  }
+  AssertContainerEquality(stdVector, myVector);
+  myVector.clear();
+  myVector.push_back(7);
+  ASSERT_EQ(myVector[0], 7);
+}
+
+TEST_F(VectorTest, EmplaceTest) {
+  std::vector<std::string> stdVector{"ab", "cd"};
+  s21::vector<std::string> myVector{"ab", "cd"};
+  stdVector.emplace_back(3, 'x');
+  ASSERT_EQ(myVector.emplace_back(3, 'x'), "xxx");
+  stdVector.emplace(stdVector.begin() + 1, "ef", 1);
+  ASSERT_EQ(*myVector.emplace(myVector.cbegin() + 1, "ef", 1), "e");
+  std::string moved{"moved"};
+  stdVector.push_back("moved");
+  myVector.push_back(std::move(moved));
+  AssertContainerEquality(stdVector, myVector);
+}
+
+TEST_F(VectorTest, EmplaceAliasingElementTest) {
+  s21::vector<std::string> myVector{"a", "b"};
+  myVector.emplace(myVector.cbegin(), myVector[1]);
+  AssertContainerEquality(myVector, std::vector<std::string>{"b", "a", "b"});
+  myVector.insert_many(myVector.cbegin() + 1, myVector[0], myVector[1]);
+  AssertContainerEquality(
+      myVector, std::vector<std::string>{"b", "b", "a", "a", "b"});
+  myVector.reserve(10);
+  myVector.emplace(myVector.cbegin() + 2, myVector[3]);
+  AssertContainerEquality(
+      myVector, std::vector<std::string>{"b", "b", "a", "a", "a", "b"});
+}
+
+TEST_F(VectorTest, MoveOnlyTest) {
+  s21::vector<std::unique_ptr<int>> myVector{};
+  myVector.push_back(std::make_unique<int>(2));
+  myVector.emplace_back(new int{4});
+  myVector.emplace(myVector.cbegin(), std::make_unique<int>(1));
+  myVector.insert_many(myVector.cbegin() + 2, std::make_unique<int>(3));
+  myVector.insert_many_back(std::make_unique<int>(5),
+                            std::make_unique<int>(6));
+  myVector.erase(myVector.begin() + 5);
+  ASSERT_EQ(myVector.size(), 5U);
+  for (std::size_t i{0}; i < myVector.size(); ++i) {
+    ASSERT_EQ(*myVector[i], static_cast<int>(i) + 1);
+  }
+  s21::vector<std::unique_ptr<int>> moved{std::move(myVector)};
+  moved.pop_back();
+  ASSERT_EQ(*moved.back(), 4);
+}
 }  // namespace s21